@@ -25,6 +25,12 @@ typedef struct
 {
     daxa_QueueFamily queue_family;
     daxa_SmallString name;
+    // Command lists completed by a reusable recorder may be submitted many times, even while earlier submissions are still pending.
+    // Deferred destructions fail with DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER, later submissions would use the destroyed resources.
+    daxa_Bool8 reusable;
+    // Skips remembering the ids used by recorded commands, which makes recording cheaper.
+    // The ids are then not validated on submit. Has the same effect as DAXA_DEVICE_INFO_FLAG_DISABLE_COMMAND_ID_TRACKING for this recorder.
+    daxa_Bool8 disable_id_tracking;
 } daxa_CommandRecorderInfo;
 
 static daxa_CommandRecorderInfo const DAXA_DEFAULT_COMMAND_RECORDER_INFO = DAXA_ZERO_INIT;
@@ -343,6 +343,20 @@ static daxa_DeviceInfo const DAXA_DEFAULT_DEVICE_INFO = {
     .name = DAXA_ZERO_INIT,
 };
 
+typedef enum
+{
+    DAXA_DEVICE_INFO_FLAG_NONE = 0,
+    // Zombies are reclaimed by a device owned background thread instead of inside daxa_dvc_collect_garbage.
+    // The thread waits on the queue timelines and destroys zombies in small batches, only briefly taking the lifetime lock per batch.
+    // daxa_dvc_collect_garbage becomes a non blocking wakeup of the background thread.
+    DAXA_DEVICE_INFO_FLAG_BACKGROUND_GARBAGE_COLLECTION = 0x1 << 0,
+    // Command recorders no longer remember the ids used in commands and daxa_dvc_submit skips validating them.
+    // Ids are still validated when recording the commands. Meant for release builds that reference very many ids per frame.
+    DAXA_DEVICE_INFO_FLAG_DISABLE_COMMAND_ID_TRACKING = 0x1 << 1,
+} daxa_DeviceInfoFlagBits;
+
+typedef daxa_DeviceInfoFlagBits daxa_DeviceInfoFlags;
+
 typedef struct
 {
     daxa_u32 physical_device_index;                     // Index into list of devices returned from daxa_instance_list_devices_properties.
@@ -352,6 +366,7 @@ typedef struct
     uint32_t max_allowed_samplers;
     uint32_t max_allowed_acceleration_structures;
     daxa_SmallString name;
+    daxa_DeviceInfoFlags flags;
 } daxa_DeviceInfo2;
 
 static daxa_DeviceInfo2 const DAXA_DEFAULT_DEVICE_INFO_2 = {
@@ -362,6 +377,7 @@ static daxa_DeviceInfo2 const DAXA_DEFAULT_DEVICE_INFO_2 = {
     .max_allowed_samplers = 400,
     .max_allowed_acceleration_structures = 10000,
     .name = DAXA_ZERO_INIT,
+    .flags = DAXA_DEVICE_INFO_FLAG_NONE,
 };
 
 typedef struct
@@ -396,6 +412,12 @@ typedef struct
     uint64_t wait_timeline_semaphore_count;
     daxa_TimelinePair const * signal_timeline_semaphores;
     uint64_t signal_timeline_semaphore_count;
+    // Optional per semaphore wait stages. Either empty or exactly one entry per wait semaphore.
+    // When empty, waits block wait_stages, or all commands when wait_stages is zero.
+    VkPipelineStageFlags2 const * wait_binary_semaphore_stages;
+    uint64_t wait_binary_semaphore_stage_count;
+    VkPipelineStageFlags2 const * wait_timeline_semaphore_stages;
+    uint64_t wait_timeline_semaphore_stage_count;
 } daxa_CommandSubmitInfo;
 
 static daxa_CommandSubmitInfo const DAXA_DEFAULT_COMMAND_SUBMIT_INFO = DAXA_ZERO_INIT;
@@ -453,6 +475,65 @@ typedef struct
     uint64_t build_scratch_size;
 } daxa_AccelerationStructureBuildSizesInfo;
 
+#define DAXA_MAX_MEMORY_HEAPS 16u
+
+typedef struct
+{
+    // Bytes the process can allocate from the heap without paging. Driver estimate when VK_EXT_memory_budget is enabled, 80% of the heap size otherwise.
+    uint64_t budget;
+    // Bytes the process allocated from the heap. Includes allocations made outside of daxa when VK_EXT_memory_budget is enabled.
+    uint64_t usage;
+    // Bytes of VkDeviceMemory blocks allocated by daxa.
+    uint64_t block_bytes;
+    // Bytes of the allocations placed in those blocks.
+    uint64_t allocation_bytes;
+    uint32_t block_count;
+    uint32_t allocation_count;
+    VkMemoryHeapFlags flags;
+} daxa_MemoryHeapReport;
+
+typedef struct
+{
+    uint64_t count;
+    uint64_t byte_size;
+} daxa_MemoryTotals;
+
+typedef enum
+{
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_BUFFER,
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_IMAGE,
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_TLAS,
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_BLAS,
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_MEMORY_BLOCK,
+    DAXA_MEMORY_REPORT_RESOURCE_TYPE_MAX_ENUM = 0x7fffffff,
+} daxa_MemoryReportResourceType;
+
+typedef struct
+{
+    daxa_MemoryReportResourceType type;
+    uint64_t byte_size;
+    daxa_SmallString name;
+} daxa_MemoryReportAllocation;
+
+typedef struct
+{
+    daxa_Bool8 memory_budget_enabled;
+    uint32_t heap_count;
+    daxa_MemoryHeapReport heaps[DAXA_MAX_MEMORY_HEAPS];
+    // Resources created from memory blocks are also contained in the memory block totals.
+    // Buffers owned by acceleration structures are only counted in the tlas and blas totals.
+    // Acceleration structures created in a user buffer are only counted in the buffer totals.
+    daxa_MemoryTotals buffers;
+    daxa_MemoryTotals images;
+    daxa_MemoryTotals tlas;
+    daxa_MemoryTotals blas;
+    daxa_MemoryTotals memory_blocks;
+    // Memory blocks created with DAXA_MEMORY_FLAG_CAN_ALIAS, such as the transient memory of task graphs.
+    // They are also contained in the memory block totals.
+    daxa_MemoryTotals aliased_memory_blocks;
+    uint32_t largest_allocation_count;
+} daxa_MemoryReport;
+
 DAXA_EXPORT VkMemoryRequirements
 daxa_dvc_buffer_memory_requirements(daxa_Device device, daxa_BufferInfo const * info);
 DAXA_EXPORT VkMemoryRequirements
@@ -474,6 +555,11 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_image_from_block(daxa_Device device, daxa_MemoryBlockImageInfo const * info, daxa_ImageId * out_id);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_image_view(daxa_Device device, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id);
+// Returns a device owned view shared by all calls with the same image, type, format and slice. The name is ignored.
+// Returns the default view when the parameters match it. Cached views are destroyed together with their image and must not be destroyed manually.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_cached_image_view(daxa_Device device, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id);
+// Samplers with equal infos (ignoring the name) share one refcounted id, each create must be matched by a destroy.
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_sampler(daxa_Device device, daxa_SamplerInfo const * info, daxa_SamplerId * out_id);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
@@ -485,6 +571,15 @@ daxa_dvc_create_tlas_from_buffer(daxa_Device device, daxa_BufferTlasInfo const *
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_blas_from_buffer(daxa_Device device, daxa_BufferBlasInfo const * info, daxa_BlasId * out_id);
 
+// Creates count resources at once.
+// On failure, none of the resources are created and all out_ids are set to null ids.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_buffers(daxa_Device device, daxa_BufferInfo const * infos, uint64_t count, daxa_BufferId * out_ids);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_images(daxa_Device device, daxa_ImageInfo const * infos, uint64_t count, daxa_ImageId * out_ids);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_image_views(daxa_Device device, daxa_ImageViewInfo const * infos, uint64_t count, daxa_ImageViewId * out_ids);
+
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_destroy_buffer(daxa_Device device, daxa_BufferId buffer);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
@@ -497,6 +592,13 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_destroy_tlas(daxa_Device device, daxa_TlasId tlas);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_destroy_blas(daxa_Device device, daxa_BlasId blas);
+// Destroys count resources at once. Invalid ids are skipped and reported, the valid ids are still destroyed.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_buffers(daxa_Device device, daxa_BufferId const * buffers, uint64_t count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_images(daxa_Device device, daxa_ImageId const * images, uint64_t count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_image_views(daxa_Device device, daxa_ImageViewId const * ids, uint64_t count);
 
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_info_buffer(daxa_Device device, daxa_BufferId buffer, daxa_BufferInfo * out_info);
@@ -579,11 +681,37 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_wait_idle(daxa_Device device);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_submit(daxa_Device device, daxa_CommandSubmitInfo const * info);
+// All infos must target the same queue. The batch is submitted with a single driver call and counts as one submit for resource lifetimes.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_submit_batch(daxa_Device device, daxa_CommandSubmitInfo const * infos, uint64_t info_count);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_present(daxa_Device device, daxa_PresentInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_collect_garbage(daxa_Device device);
 
+// Index of the latest submit, every submit increments it.
+DAXA_EXPORT uint64_t
+daxa_dvc_latest_submit_index(daxa_Device device);
+// All submits with a lower submit index than out_index finished executing on the gpu.
+// UINT64_MAX when no submit is pending.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_oldest_pending_submit_index(daxa_Device device, uint64_t * out_index);
+
+// Writes the pipeline cache of the device, prefixed with a header identifying the device and driver.
+// When out_data is null, only the required size is written to out_size.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_get_pipeline_cache_data(daxa_Device device, uint64_t * out_size, void * out_data);
+// Merges data returned by daxa_dvc_get_pipeline_cache_data into the pipeline cache of the device.
+// Data written by another device, driver or daxa version is rejected with DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_load_pipeline_cache_data(daxa_Device device, void const * data, uint64_t size);
+
+// Writes heap budgets and usage, per resource type totals and the largest live resources, sorted by size.
+// Destroyed buffers, images and acceleration structures still count until they are garbage collected.
+// At most largest_allocation_capacity allocations are written to out_largest_allocations, which may be null when the capacity is 0.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_memory_report(daxa_Device device, daxa_MemoryReport * out_report, daxa_MemoryReportAllocation * out_largest_allocations, uint32_t largest_allocation_capacity);
+
 DAXA_EXPORT daxa_DeviceInfo2 const *
 daxa_dvc_info(daxa_Device device);
 DAXA_EXPORT daxa_DeviceProperties const *
@@ -3,6 +3,16 @@
 
 #include <daxa/c/types.h>
 
+typedef struct
+{
+    uint32_t constant_id;
+    // Byte size of the constant, 4 for bool, int, uint and float constants, 8 for 64 bit constants.
+    // Must be 1, 2, 4 or 8, pipeline creation fails with DAXA_RESULT_ERROR_INVALID_SPECIALIZATION_CONSTANT_SIZE otherwise.
+    uint32_t size;
+    // The value is truncated to size bytes.
+    uint64_t value;
+} daxa_SpecializationConstant;
+
 typedef struct
 {
     uint32_t const * byte_code;
@@ -10,6 +20,7 @@ typedef struct
     VkPipelineShaderStageCreateFlags create_flags;
     daxa_Optional(uint32_t) required_subgroup_size;
     daxa_SmallString entry_point;
+    daxa_SpanToConst(daxa_SpecializationConstant) specialization_constants;
 } daxa_ShaderInfo;
 
 // RAY TRACING PIPELINE
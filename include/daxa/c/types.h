@@ -123,6 +123,11 @@ typedef enum
     DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED = (1 << 30) + 69,
     DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT = (1 << 30) + 70,
     DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND = (1 << 30) + 71,
+    DAXA_RESULT_ERROR_SUBMIT_WAIT_STAGE_COUNT_MISMATCH = (1 << 30) + 72,
+    DAXA_RESULT_ERROR_SUBMIT_BATCH_QUEUE_MISMATCH = (1 << 30) + 73,
+    DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA = (1 << 30) + 74,
+    DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER = (1 << 30) + 75,
+    DAXA_RESULT_ERROR_INVALID_SPECIALIZATION_CONSTANT_SIZE = (1 << 30) + 76,
     DAXA_RESULT_MAX_ENUM = 0x7FFFFFFF,
 } daxa_Result;
 
@@ -213,6 +218,7 @@ typedef struct
 {
     VkMemoryRequirements requirements;
     daxa_MemoryFlags flags;
+    daxa_SmallString name;
 } daxa_MemoryBlockInfo;
 
 DAXA_EXPORT daxa_MemoryBlockInfo const *
@@ -22,6 +22,10 @@ namespace daxa
     {
         QueueFamily queue_family = {};
         SmallString name = {};
+        // Completed command lists may be submitted many times. Deferred destructions are rejected, as resources can only be destroyed once.
+        bool reusable = {};
+        // Skips remembering and validating the used ids for this recorder, like DeviceInfoFlagBits::DISABLE_COMMAND_ID_TRACKING does for the whole device.
+        bool disable_id_tracking = {};
     };
 
     struct ImageBlitInfo
@@ -338,6 +338,20 @@ namespace daxa
         SmallString name = {};
     };
 
+    struct DeviceInfoFlagsProperties
+    {
+        using Data = u32;
+    };
+    using DeviceInfoFlags = Flags<DeviceInfoFlagsProperties>;
+    struct DeviceInfoFlagBits
+    {
+        static inline constexpr DeviceInfoFlags NONE = {0};
+        // Zombies are reclaimed in small batches by a background thread, collect_garbage only wakes it up.
+        static inline constexpr DeviceInfoFlags BACKGROUND_GARBAGE_COLLECTION = {0x1 << 0};
+        // Skips remembering and submit time validation of the ids used by recorded commands.
+        static inline constexpr DeviceInfoFlags DISABLE_COMMAND_ID_TRACKING = {0x1 << 1};
+    };
+
     struct DeviceInfo2
     {
         u32 physical_device_index = ~0u;
@@ -348,6 +362,7 @@ namespace daxa
         u32 max_allowed_samplers = 400;
         u32 max_allowed_acceleration_structures = 10'000;
         SmallString name = {};
+        DeviceInfoFlags flags = {};
     };
 
     struct Queue
@@ -377,6 +392,10 @@ namespace daxa
         std::span<BinarySemaphore const> signal_binary_semaphores = {};
         std::span<std::pair<TimelineSemaphore, u64> const> wait_timeline_semaphores = {};
         std::span<std::pair<TimelineSemaphore, u64> const> signal_timeline_semaphores = {};
+        // Optional per semaphore wait stages. Either empty or exactly one entry per wait semaphore.
+        // When empty, waits block wait_stages, or all commands when wait_stages is NONE.
+        std::span<PipelineStageFlags const> wait_binary_semaphore_stages = {};
+        std::span<PipelineStageFlags const> wait_timeline_semaphore_stages = {};
     };
 
     struct PresentInfo
@@ -407,6 +426,63 @@ namespace daxa
         u64 build_scratch_size;
     };
 
+    struct MemoryHeapReport
+    {
+        /// @brief  Bytes the process can allocate from the heap without paging.
+        ///         Driver estimate when VK_EXT_memory_budget is enabled, 80% of the heap size otherwise.
+        u64 budget = {};
+        /// @brief  Bytes the process allocated from the heap.
+        ///         Includes allocations made outside of daxa when VK_EXT_memory_budget is enabled.
+        u64 usage = {};
+        u64 block_bytes = {};
+        u64 allocation_bytes = {};
+        u32 block_count = {};
+        u32 allocation_count = {};
+        VkMemoryHeapFlags flags = {};
+    };
+
+    struct MemoryTotals
+    {
+        u64 count = {};
+        u64 byte_size = {};
+    };
+
+    enum struct MemoryReportResourceType
+    {
+        BUFFER,
+        IMAGE,
+        TLAS,
+        BLAS,
+        MEMORY_BLOCK,
+        MAX_ENUM = 0x7fffffff,
+    };
+
+    struct MemoryReportAllocation
+    {
+        MemoryReportResourceType type = {};
+        u64 byte_size = {};
+        SmallString name = {};
+    };
+
+    struct MemoryReport
+    {
+        bool memory_budget_enabled = {};
+        std::vector<MemoryHeapReport> heaps = {};
+        /// NOTE:
+        /// * resources created from memory blocks are also contained in the memory block totals
+        /// * buffers owned by acceleration structures are only counted in the tlas and blas totals
+        /// * acceleration structures created in a user buffer are only counted in the buffer totals
+        MemoryTotals buffers = {};
+        MemoryTotals images = {};
+        MemoryTotals tlas = {};
+        MemoryTotals blas = {};
+        MemoryTotals memory_blocks = {};
+        /// @brief  Memory blocks created with MemoryFlagBits::CAN_ALIAS, such as the transient memory of task graphs.
+        MemoryTotals aliased_memory_blocks = {};
+        /// @brief  Largest live resources, sorted by size.
+        std::vector<MemoryReportAllocation> largest_allocations = {};
+    };
+
     struct BufferTlasInfo
     {
         TlasInfo tlas_info = {};
@@ -452,6 +528,13 @@ namespace daxa
         [[nodiscard]] auto create_buffer_from_memory_block(MemoryBlockBufferInfo const & info) -> BufferId;
         [[nodiscard]] auto create_image_from_memory_block(MemoryBlockImageInfo const & info) -> ImageId;
         [[nodiscard]] auto create_image_view(ImageViewInfo const & info) -> ImageViewId;
+        /// @brief  Returns a device owned view shared by all calls with the same image, type, format and slice.
+        ///         The name is ignored. Returns the default view when the parameters match it.
+        /// NOTE:
+        /// * cached views are destroyed together with their image, they must not be destroyed manually
+        [[nodiscard]] auto cached_image_view(ImageViewInfo const & info) -> ImageViewId;
+        /// @brief  Samplers are deduplicated, an info equal to a live samplers info (ignoring the name) returns the same id.
+        ///         The id stays valid until it was destroyed as often as it was returned by create_sampler.
         [[nodiscard]] auto create_sampler(SamplerInfo const & info) -> SamplerId;
         [[nodiscard]] auto create_tlas(TlasInfo const & info) -> TlasId;
         [[nodiscard]] auto create_blas(BlasInfo const & info) -> BlasId;
@@ -468,6 +551,12 @@ namespace daxa
         [[nodiscard]] auto create(BufferTlasInfo const & info) { return create_tlas_from_buffer(info); }
         [[nodiscard]] auto create(BufferBlasInfo const & info) { return create_blas_from_buffer(info); }
 
+        /// @brief  Batched creation, cheaper than creating each resource individually.
+        ///         Either all resources are created or none of them.
+        [[nodiscard]] auto create_buffers(std::span<BufferInfo const> infos) -> std::vector<BufferId>;
+        [[nodiscard]] auto create_images(std::span<ImageInfo const> infos) -> std::vector<ImageId>;
+        [[nodiscard]] auto create_image_views(std::span<ImageViewInfo const> infos) -> std::vector<ImageViewId>;
+
         void destroy_buffer(BufferId id);
         void destroy_image(ImageId id);
         void destroy_image_view(ImageViewId id);
@@ -480,6 +569,11 @@ namespace daxa
         void destroy(SamplerId id) { destroy_sampler(id); }
         void destroy(TlasId id) { destroy_tlas(id); }
         void destroy(BlasId id) { destroy_blas(id); }
+        /// @brief  Batched destruction, takes the zombie lock once for the whole batch.
+        ///         Valid ids are destroyed even when the batch contains invalid ids.
+        void destroy_buffers(std::span<BufferId const> ids);
+        void destroy_images(std::span<ImageId const> ids);
+        void destroy_image_views(std::span<ImageViewId const> ids);
 
         // TODO: deprecate?
 
@@ -555,6 +649,9 @@ namespace daxa
         auto queue_count(QueueFamily queue_count) -> u32;
 
         void submit_commands(CommandSubmitInfo const & submit_info);
+        /// @brief  Submits all infos in order with a single driver call, one lifetime lock and one timeline increment.
+        ///         All infos must target the same queue.
+        void submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos);
         void present_frame(PresentInfo const & info);
 
         /// @brief  Actually destroys all resources that are ready to be destroyed.
@@ -566,8 +663,34 @@ namespace daxa
         /// * look at CommandRecorder for more info on this
         /// * SoftwareCommandRecorder is exempt from this limitation,
         ///   you can freely record those in parallel with collect_garbage
+        /// * with DeviceInfoFlagBits::BACKGROUND_GARBAGE_COLLECTION this only wakes the background collector and never blocks
         void collect_garbage();
 
+        /// @brief  Every submit increments the submit index.
+        ///         Resources used by commands submitted up to latest_submit_index() are no longer in use by the gpu,
+        ///         once the returned value is smaller than oldest_pending_submit_index().
+        [[nodiscard]] auto latest_submit_index() const -> u64;
+        /// @return All submits with a lower submit index finished executing, max u64 when no submit is pending.
+        [[nodiscard]] auto oldest_pending_submit_index() -> u64;
+
+        /// @brief  Serializes the devices pipeline cache. All pipelines created with the device populate it.
+        ///         The data is prefixed with a header identifying vendor, device, driver and pipeline cache uuid.
+        /// @return pipeline cache data, meant to be written to disk and passed to load_pipeline_cache_data in a later run.
+        [[nodiscard]] auto get_pipeline_cache_data() -> std::vector<std::byte>;
+        /// @brief  Merges previously serialized pipeline cache data into the devices pipeline cache.
+        /// NOTE:
+        /// * blocks pipeline creation while merging
+        /// @return false when the data was written by a different device, driver or daxa version and was ignored.
+        auto load_pipeline_cache_data(std::span<std::byte const> data) -> bool;
+
+        /// @brief  Reports heap budgets, memory usage per resource type and the largest live resources.
+        ///         Destroyed buffers, images and acceleration structures still count until they are garbage collected.
+        ///         Enables VK_EXT_memory_budget based budgets when the extension is available.
+        /// NOTE:
+        /// * iterates all live resources, meant to be called occasionally, not every frame
+        /// @param largest_allocation_count maximum number of reported largest allocations.
+        [[nodiscard]] auto memory_report(u32 largest_allocation_count = 16) -> MemoryReport;
+
         /// THREADSAFETY:
         /// * reference MUST NOT be read after the device is destroyed.
         /// @return reference to info of object.
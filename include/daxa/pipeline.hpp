@@ -18,6 +18,16 @@ namespace daxa
         static inline constexpr ShaderCreateFlags REQUIRE_FULL_SUBGROUPS  = {0x00000002};
     };
 
+    struct SpecializationConstant
+    {
+        u32 constant_id = {};
+        // Byte size of the constant, 4 for bool, int, uint and float constants, 8 for 64 bit constants.
+        // Must be 1, 2, 4 or 8.
+        u32 size = sizeof(u32);
+        // The value is truncated to size bytes, use std::bit_cast for floating point constants.
+        u64 value = {};
+    };
+
     struct ShaderInfo
     {
         u32 const * byte_code = {};
@@ -25,6 +35,7 @@ namespace daxa
         ShaderCreateFlags create_flags = {};
         Optional<u32> required_subgroup_size = {};
         SmallString entry_point = "main";
+        Span<SpecializationConstant const> specialization_constants = {};
     };
 
     // TODO: find a better way to link shader groups to shaders than by index
@@ -1783,6 +1783,7 @@ namespace daxa
     {
         MemoryRequirements requirements = {};
         MemoryFlags flags = {};
+        SmallString name = {};
     };
 
     struct DAXA_EXPORT_CXX MemoryBlock : ManagedPtr<MemoryBlock, daxa_MemoryBlock>
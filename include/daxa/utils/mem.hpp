@@ -7,7 +7,10 @@
 #include <daxa/core.hpp>
 #include <daxa/device.hpp>
 
+#include <atomic>
 #include <deque>
+#include <mutex>
+#include <vector>
 
 namespace daxa
 {
@@ -20,6 +23,10 @@ namespace daxa
     };
 
     /// @brief Ring buffer based transfer memory allocator for easy and efficient cpu gpu communication.
+    /// THREADSAFETY:
+    /// * allocate and allocate_fill may be called from multiple threads in parallel.
+    ///   Claiming memory is lock free, when the ring is full they take a lock and query the timeline semaphore to reclaim memory.
+    /// * moving the pool is not threadsafe.
     struct TransferMemoryPool
     {
         DAXA_EXPORT_CXX TransferMemoryPool(TransferMemoryPoolInfo a_info);
@@ -33,6 +40,7 @@ namespace daxa
             void * host_address = {};
             u32 buffer_offset = {};
             usize size = {};
+            // The allocation is reclaimed once the timeline semaphore reaches this value.
             u64 timeline_index = {};
         };
         // Returns nullopt if the allocation fails.
@@ -51,9 +59,11 @@ namespace daxa
             return std::nullopt;
         }
         // Returns current timeline index.
+        // Allocations advance the timeline, signaling this value after a submit releases all memory allocated before.
         DAXA_EXPORT_CXX auto timeline_value() const -> usize;
-        // Returns and then increments the current timeline index.
+        // Increments and then returns the current timeline index.
         // This is useful to ensure that the timeline value used for submits is always increasing.
+        // All memory allocated before the call is reclaimed once the timeline semaphore reaches the returned value.
         DAXA_EXPORT_CXX auto inc_timeline_value() -> usize;
         // Returns timeline semaphore that needs to be signaled with the latest timeline value,
         // on a queue that uses memory from this pool.
@@ -66,24 +76,108 @@ namespace daxa
 
       private:
         // Reclaim expired memory allocations.
+        // The only place that releases memory, serialized by the reclaim mutex.
         DAXA_EXPORT_CXX void reclaim_unused_memory();
-        struct TrackedAllocation
+        struct TimelineCheckpoint
         {
-            usize timeline_index = {};
-            u32 offset = {};
-            u32 size = {};
+            u64 timeline_value = {};
+            // Ring position of the end of all allocations whose timeline index is at most timeline_value.
+            u64 claimed_end = {};
         };
 
         TransferMemoryPoolInfo m_info = {};
         TimelineSemaphore gpu_timeline = {};
 
       private:
-        u64 current_timeline_value = {};
-        std::deque<TrackedAllocation> live_allocations = {};
+        std::atomic_uint64_t current_timeline_value = {};
+        // Ring positions only ever grow, the buffer offset of a position is position % capacity.
+        // Allocations bump claimed_end lock free, only reclamation advances claimed_start.
+        std::atomic_uint64_t claimed_start = {};
+        std::atomic_uint64_t claimed_end = {};
+        std::mutex reclaim_mtx = {};
+        std::deque<TimelineCheckpoint> checkpoints = {};
         BufferId m_buffer = {};
         daxa::DeviceAddress buffer_device_address = {};
         void * buffer_host_address = {};
-        u32 claimed_start = {};
-        u32 claimed_size = {};
+    };
+
+    struct BufferSubAllocatorInfo
+    {
+        Device device = {};
+        /// @brief  Allocation sizes are rounded up to power of two size classes between min and max allocation size.
+        u32 min_allocation_size = 256;
+        u32 max_allocation_size = 1u << 16u;
+        /// @brief  Byte size of each slab. A slab is a buffer bound to its own memory block, serving a single size class.
+        u32 slab_size = 1u << 22u;
+        std::string name = {};
+    };
+
+    /// @brief  Size class slab allocator for many small device local buffers.
+    ///         Sub-allocations share few large buffers, avoiding a vulkan allocation, buffer and resource table slot each.
+    ///         Allocating and freeing are O(1).
+    ///         Freed memory is only reused once all submits issued before the free finished executing on the gpu.
+    /// THREADSAFETY:
+    /// * not threadsafe, externally synchronize all calls.
+    struct BufferSubAllocator
+    {
+        DAXA_EXPORT_CXX BufferSubAllocator(BufferSubAllocatorInfo a_info);
+        DAXA_EXPORT_CXX BufferSubAllocator(BufferSubAllocator && other);
+        DAXA_EXPORT_CXX BufferSubAllocator & operator=(BufferSubAllocator && other);
+        DAXA_EXPORT_CXX ~BufferSubAllocator();
+
+        struct Allocation
+        {
+            BufferId buffer = {};
+            u32 offset = {};
+            // Size of the size class, may be larger than the requested size.
+            u32 size = {};
+            daxa::DeviceAddress device_address = {};
+            u32 slab_index = {};
+        };
+        /// @brief  Sub-allocates from a slab of the allocations size class, creating a new slab when all are full.
+        /// @return nullopt if the size exceeds max_allocation_size.
+        DAXA_EXPORT_CXX auto allocate(u32 size) -> std::optional<Allocation>;
+        /// @brief  Returns the allocation to its size class.
+        ///         It is reused once all submits up to Device::latest_submit_index() at the time of freeing finished.
+        DAXA_EXPORT_CXX void free(Allocation const & allocation);
+        /// THREADSAFETY:
+        /// * reference MUST NOT be read after the object is destroyed.
+        /// @return reference to info of object.
+        DAXA_EXPORT_CXX auto info() const -> BufferSubAllocatorInfo const &;
+
+      private:
+        struct Slab
+        {
+            MemoryBlock memory_block = {};
+            BufferId buffer = {};
+            daxa::DeviceAddress device_address = {};
+        };
+        struct FreeBlock
+        {
+            u32 slab_index = {};
+            u32 offset = {};
+        };
+        struct PendingFree
+        {
+            u64 submit_index = {};
+            FreeBlock block = {};
+        };
+        struct SizeClass
+        {
+            std::vector<FreeBlock> free_blocks = {};
+            // Ordered by submit index, as the submit index only ever increases.
+            std::deque<PendingFree> pending_frees = {};
+            // Slab that is carved from front to back before any free block is created for it.
+            u32 bump_slab_index = ~0u;
+            u32 bump_offset = {};
+        };
+
+        // Moves pending frees whose submits finished into the free blocks.
+        DAXA_EXPORT_CXX void reclaim_pending_frees(SizeClass & size_class);
+        DAXA_EXPORT_CXX void destroy_slabs();
+
+        BufferSubAllocatorInfo m_info = {};
+        std::vector<Slab> slabs = {};
+        std::vector<SizeClass> size_classes = {};
     };
 } // namespace daxa
@@ -8,6 +8,7 @@
 
 #include <filesystem>
 #include <functional>
+#include <chrono>
 
 namespace daxa
 {
@@ -62,6 +63,8 @@ namespace daxa
     {
         ShaderSource source = Monostate{};
         ShaderCompileOptions compile_options = {};
+        // Not part of the compiled spirv, shaders only differing in specialization constants share their spirv cache entry.
+        std::vector<SpecializationConstant> specialization_constants = {};
     };
 
     struct RayTracingPipelineCompileInfo
@@ -108,6 +111,36 @@ namespace daxa
         bool register_null_pipelines_when_first_compile_fails = false;
         std::function<void(std::string &, std::filesystem::path const & path)> custom_preprocessor = {};
         std::string name = {};
+        // Number of threads the batch add functions and reload_all compile pipelines on. 0 uses std::thread::hardware_concurrency.
+        // When compiling on multiple threads, custom_preprocessor is called from multiple threads concurrently.
+        u32 compile_thread_count = 0;
+        // Moves change detection and recompilation to a background thread that checks the observed shader files every async_reload_poll_interval.
+        // reload_all then never touches the filesystem or compiles, it only swaps in the pipelines the background thread finished since the last call.
+        bool async_reload = false;
+        std::chrono::milliseconds async_reload_poll_interval = std::chrono::milliseconds{250};
+        // When set, the devices pipeline cache is loaded from this file on creation and written back on save_pipeline_cache and destruction.
+        // Cache files of a different device or driver are ignored.
+        std::filesystem::path pipeline_cache_path = {};
+        // Size cap of each spirv_cache_folder's archive. Least recently used shaders are evicted when the archive is written.
+        u64 spirv_cache_max_byte_size = 256ull << 20;
+    };
+
+    struct SpirvCacheStatistics
+    {
+        u64 hits = {};
+        u64 misses = {};
+        u64 evictions = {};
+        u64 entry_count = {};
+        u64 byte_size = {};
+    };
+
+    // One pipeline of a set of variants created from the same compile info.
+    // The specialization constants are appended to the ones of every shader stage.
+    struct PipelineVariantInfo
+    {
+        std::vector<SpecializationConstant> specialization_constants = {};
+        // Replaces the name of the compile info when not empty.
+        std::string name = {};
     };
 
     struct VirtualFileInfo
@@ -137,12 +170,28 @@ namespace daxa
         auto add_ray_tracing_pipeline(RayTracingPipelineCompileInfo const & info) -> Result<std::shared_ptr<RayTracingPipeline>>;
         auto add_compute_pipeline(ComputePipelineCompileInfo const & info) -> Result<std::shared_ptr<ComputePipeline>>;
         auto add_raster_pipeline(RasterPipelineCompileInfo const & info) -> Result<std::shared_ptr<RasterPipeline>>;
+        /// @brief  Compiles all pipelines in parallel on PipelineManagerInfo::compile_thread_count threads.
+        /// @return one result per info, in the same order.
+        auto add_ray_tracing_pipelines(std::span<RayTracingPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RayTracingPipeline>>>;
+        auto add_compute_pipelines(std::span<ComputePipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>;
+        auto add_raster_pipelines(std::span<RasterPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>;
+        /// @brief  Compiles the shaders of info once and creates one pipeline per variant from the same spirv.
+        ///         Each variant is a regular managed pipeline afterwards, it is hot reloaded and removed individually.
+        /// @return one result per variant, in the same order.
+        auto add_compute_pipeline_variants(ComputePipelineCompileInfo const & info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>;
+        auto add_raster_pipeline_variants(RasterPipelineCompileInfo const & info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>;
         void remove_ray_tracing_pipeline(std::shared_ptr<RayTracingPipeline> const & pipeline);
         void remove_compute_pipeline(std::shared_ptr<ComputePipeline> const & pipeline);
         void remove_raster_pipeline(std::shared_ptr<RasterPipeline> const & pipeline);
         void add_virtual_file(VirtualFileInfo const & info);
+        /// @brief  Recompiles and swaps in all pipelines whose observed shader files changed.
+        ///         With PipelineManagerInfo::async_reload, only swaps in the pipelines the background thread finished recompiling.
         auto reload_all() -> PipelineReloadResult;
         auto all_pipelines_valid() const -> bool;
+        void save_pipeline_cache();
+        /// @brief  Writes the in memory spirv caches back to their spirv_cache_folder. Also happens on destruction.
+        void save_spirv_cache();
+        [[nodiscard]] auto spirv_cache_statistics() const -> SpirvCacheStatistics;
 
       protected:
         template <typename T, typename H_T>
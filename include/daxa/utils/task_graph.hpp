@@ -48,6 +48,43 @@ namespace daxa
         Variant<TaskBufferView, std::string> aliased_buffer = {};
     };
 
+    enum struct TaskTransientAliasingStrategy
+    {
+        /// Places the longest living resources first, each behind the allocations it overlaps with in time.
+        LIFETIME_FIRST_FIT,
+        /// Places the largest resources first, each into the smallest gap between the allocations alive at the same time.
+        /// Usually needs less memory for graphs with many differently sized transients, at the cost of a slower completion.
+        SIZE_BEST_FIT,
+    };
+
+    struct TaskTransientMemorySize
+    {
+        /// Largest sum of transient resource sizes alive during a single batch. No placement can use less memory.
+        usize peak_live_size = {};
+        /// Memory actually spanned by the placed transient resources.
+        usize allocated_size = {};
+    };
+
+    enum struct TaskGpuTimingType
+    {
+        BATCH,
+        BATCH_BARRIERS,
+        TASK,
+    };
+
+    struct TaskGpuTiming
+    {
+        TaskGpuTimingType type = {};
+        std::string name = {};
+        u32 submit_scope_index = {};
+        u32 batch_index = {};
+        /// Index of the task within its batch, zero for batches and their barriers.
+        u32 task_index = {};
+        /// Nanoseconds since the first timestamp of the execution.
+        u64 begin_ns = {};
+        u64 end_ns = {};
+    };
+
     struct TaskGraphInfo
     {
         Device device = {};
@@ -58,6 +95,8 @@ namespace daxa
         bool reorder_tasks = true;
         /// @brief  Allows task graph to alias transient resources memory (ofc only when that wont break the program)
         bool alias_transients = {};
+        /// @brief  Selects how transient resources are placed in memory when aliasing them.
+        TaskTransientAliasingStrategy transient_aliasing_strategy = TaskTransientAliasingStrategy::LIFETIME_FIRST_FIT;
         /// @brief  Some drivers have bad implementations for split barriers.
         ///         If that is the case for you, you can turn off all use of split barriers.
         ///         Daxa will use pipeline barriers instead if this is set.
@@ -66,6 +105,8 @@ namespace daxa
         ///         For a low number of permutations its is preferable to precompile all permutations.
         ///         For a large number of permutations it might be preferable to only create the permutations actually used on the fly just before they are needed.
         ///         The second option is enabled by using jit (just in time) compilation.
+        ///         With jit compilation, complete only stores the recorded tasks. Each permutation is compiled and gets its own transient memory on its first execution.
+        ///         Permutations that are likely to be executed soon can be compiled in the background with precompile_permutation.
         bool jit_compile_permutations = {};
         /// @brief  Task graph can branch the execution based on conditionals. All conditionals must be set before execution and stay constant while executing.
         ///         This is useful to create permutations of a task graph without having to create a separate task graph.
@@ -78,10 +119,28 @@ namespace daxa
         std::array<f32, 4> task_label_color = {0.663f, 0.533f, 0.871f, 1.0f};
         /// @brief  Records debug information about the execution if enabled. This string is retrievable with the function get_debug_string.
         bool record_debug_information = {};
+        /// @brief  Writes gpu timestamps around every batch, its barriers and every task submitted to the main queue.
+        ///         The timestamps are read back without waiting on the gpu in later executions, the newest results are retrievable with get_gpu_timings.
+        ///         Batches replayed from cached static task commands are not timed.
+        bool enable_gpu_timing = {};
+        /// @brief  Number of executions with timestamps in flight. Timestamps of an execution still unfinished after this many executions are dropped instead of stalling.
+        u32 gpu_timing_frame_count = 4;
         /// @brief  Sets the size of the linear allocator of device local, host visible memory used by the linear staging allocator.
         ///         This memory is used internally as well as by tasks via the TaskInterface::get_allocator().
         ///         Setting the size to 0, disables a few task list features but also eliminates the memory allocation.
         u32 staging_memory_pool_size = 262'144; // 2^16 bytes.
+        /// @brief  When larger than one, task graph records the tasks of each submit in chunks on this many threads.
+        ///         Each chunk is recorded into its own command list, the lists are submitted in order.
+        ///         Task callbacks as well as the pre and post task callbacks must be safe to call in parallel.
+        ///         Tasks may allocate from the staging memory allocator of the task interface in parallel.
+        ///         With record_debug_information, tasks are always recorded on the calling thread.
+        u32 recording_thread_count = 1;
+        /// @brief  Consecutive batches only containing static tasks are recorded once into reusable command lists, which are replayed on later executions.
+        ///         The cached command lists are recorded again when the runtime ids of any persistent resource used by the permutation change.
+        ///         Static tasks must not allocate from the staging memory allocator, as these allocations are only valid for one execution.
+        ///         Static tasks must not destroy resources deferred, their reusable recorders reject it.
+        ///         The pre and post task callbacks only run when a static task is recorded, not when its commands are replayed.
+        bool cache_static_tasks = {};
         // Useful for debugging tools that are invisible to the graph.
         daxa::ImageUsageFlags additional_transient_image_usage_flags = {};
         // Useful for reflection/ debugging.
@@ -144,6 +203,8 @@ namespace daxa
         std::vector<TaskAttachmentInfo> attachments = {};
         std::function<void(TaskInterface)> task = {};
         std::string name = "unnamed";
+        Queue queue = QUEUE_MAIN;
+        bool is_static = {};
     };
 
     struct InlineTask : ITask
@@ -153,6 +214,8 @@ namespace daxa
             _attachments = info.attachments;
             _callback = info.task;
             _name = info.name;
+            _queue = info.queue;
+            _is_static = info.is_static;
         }
         constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> override
         {
@@ -163,6 +226,8 @@ namespace daxa
             return _attachments;
         }
         constexpr virtual std::string_view name() const override { return _name; };
+        constexpr virtual auto queue() const -> Queue override { return _queue; }
+        constexpr virtual auto is_static() const -> bool override { return _is_static; }
         virtual void callback(TaskInterface ti) override
         {
             _callback(ti);
@@ -172,6 +237,8 @@ namespace daxa
         std::vector<TaskAttachmentInfo> _attachments = {};
         std::function<void(TaskInterface)> _callback = {};
         std::string _name = {};
+        Queue _queue = QUEUE_MAIN;
+        bool _is_static = {};
     };
 
     struct ImplTaskGraph;
@@ -261,6 +328,28 @@ namespace daxa
                 constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> { return _attachments; }
                 constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> { return _attachments; }
                 constexpr virtual auto name() const -> std::string_view { return NoRefTTask::name(); }
+                constexpr virtual auto queue() const -> Queue
+                {
+                    if constexpr (requires { { _task.queue } -> std::convertible_to<Queue>; })
+                    {
+                        return _task.queue;
+                    }
+                    else
+                    {
+                        return QUEUE_MAIN;
+                    }
+                }
+                constexpr virtual auto is_static() const -> bool
+                {
+                    if constexpr (requires { { _task.is_static } -> std::convertible_to<bool>; })
+                    {
+                        return _task.is_static;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
                 virtual void callback(TaskInterface ti) { _task.callback(ti); };
             };
             auto wrapped_task = std::make_unique<WrapperTask>(task);
@@ -279,9 +368,17 @@ namespace daxa
         DAXA_EXPORT_CXX void complete(TaskCompleteInfo const & info);
 
         DAXA_EXPORT_CXX void execute(ExecutionInfo const & info);
+        /// Starts compiling the permutation selected by the condition values on a background thread.
+        /// Only has an effect with jit_compile_permutations. Execute waits for a pending compilation of its permutation.
+        DAXA_EXPORT_CXX void precompile_permutation(std::span<bool const> permutation_condition_values);
 
         DAXA_EXPORT_CXX auto get_debug_string() -> std::string;
+        /// Returns the timings of the newest execution whose timestamps are available, empty when there is none yet.
+        DAXA_EXPORT_CXX auto get_gpu_timings() -> std::vector<TaskGpuTiming> const &;
+        /// Returns the timings of get_gpu_timings as json in the chrome trace event format, viewable in chrome://tracing or perfetto.
+        DAXA_EXPORT_CXX auto get_gpu_timings_chrome_trace() -> std::string;
         DAXA_EXPORT_CXX auto get_transient_memory_size() -> daxa::usize;
+        DAXA_EXPORT_CXX auto get_transient_memory_size(u32 permutation_index) -> TaskTransientMemorySize;
 
       protected:
         template <typename T, typename H_T>
@@ -673,6 +673,12 @@ namespace daxa
         constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> = 0;
         constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> = 0;
         constexpr virtual std::string_view name() const = 0;
+        /// The queue the task is recorded for and submitted to.
+        /// Consecutive tasks on other queues are split into their own submits, synchronized with timeline semaphores.
+        constexpr virtual auto queue() const -> Queue { return QUEUE_MAIN; }
+        /// Static tasks record the same commands on every execution.
+        /// With TaskGraphInfo::cache_static_tasks their commands are recorded once and replayed on later executions.
+        constexpr virtual auto is_static() const -> bool { return false; }
         virtual void callback(TaskInterface){};
     };
 
@@ -136,31 +136,16 @@ auto daxa_result_to_string(daxa_Result result) -> std::string_view
     case daxa_Result::DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED: return "DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED";
     case daxa_Result::DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT: return "DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT";
     case daxa_Result::DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND: return "DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND";
+    case daxa_Result::DAXA_RESULT_ERROR_SUBMIT_WAIT_STAGE_COUNT_MISMATCH: return "DAXA_RESULT_ERROR_SUBMIT_WAIT_STAGE_COUNT_MISMATCH";
+    case daxa_Result::DAXA_RESULT_ERROR_SUBMIT_BATCH_QUEUE_MISMATCH: return "DAXA_RESULT_ERROR_SUBMIT_BATCH_QUEUE_MISMATCH";
+    case daxa_Result::DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA: return "DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA";
+    case daxa_Result::DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER: return "DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER";
+    case daxa_Result::DAXA_RESULT_ERROR_INVALID_SPECIALIZATION_CONSTANT_SIZE: return "DAXA_RESULT_ERROR_INVALID_SPECIALIZATION_CONSTANT_SIZE";
     case daxa_Result::DAXA_RESULT_MAX_ENUM: return "DAXA_RESULT_MAX_ENUM";
     default: return "UNIMPLEMENTED";
     }
 };
 
-template <usize N = 1>
-void check_result(daxa_Result result, char const * message, std::array<daxa_Result, N> allowed_codes = {DAXA_RESULT_SUCCESS})
-{
-    bool result_allowed = false;
-    for (auto allowed_code : allowed_codes)
-    {
-        result_allowed = (result_allowed || allowed_code == result);
-    }
-    if (!result_allowed)
-    {
-        std::cout << fmt::format(
-                         "[[DAXA ASSERT FAILURE]]: error code: {}({}), {}.\n\n",
-                         daxa_result_to_string(result),
-                         std::bit_cast<i32>(result),
-                         message)
-                  << std::flush;
-        throw std::runtime_error({});
-    }
-}
-
 // --- End Helpers ---
 
 namespace daxa
@@ -378,6 +363,17 @@ namespace daxa
             "failed to create blas from buffer");
         return id;
     }
+    auto Device::cached_image_view(ImageViewInfo const & info) -> ImageViewId
+    {
+        ImageViewId id = {};
+        check_result(
+            daxa_dvc_cached_image_view(
+                r_cast<daxa_Device>(this->object),
+                r_cast<daxa_ImageViewInfo const *>(&info),
+                r_cast<daxa_ImageViewId *>(&id)),
+            "failed to get cached image view");
+        return id;
+    }
     DAXA_DECL_GPU_RES_FN(Buffer, buffer)
     DAXA_DECL_GPU_RES_FN(Image, image)
     DAXA_DECL_GPU_RES_FN(ImageView, image_view)
@@ -385,6 +381,32 @@ namespace daxa
     DAXA_DECL_GPU_RES_FN(Tlas, tlas)
     DAXA_DECL_GPU_RES_FN(Blas, blas)
 
+#define DAXA_DECL_GPU_RES_BATCH_FN(Name, name)                                                 \
+    auto Device::create_##name##s(std::span<Name##Info const> infos) -> std::vector<Name##Id> \
+    {                                                                                          \
+        std::vector<Name##Id> ids(infos.size());                                               \
+        check_result(                                                                          \
+            daxa_dvc_create_##name##s(                                                         \
+                r_cast<daxa_Device>(this->object),                                             \
+                r_cast<daxa_##Name##Info const *>(infos.data()),                               \
+                infos.size(),                                                                  \
+                r_cast<daxa_##Name##Id *>(ids.data())),                                        \
+            "failed to create " #name "s");                                                    \
+        return ids;                                                                            \
+    }                                                                                          \
+    void Device::destroy_##name##s(std::span<Name##Id const> ids)                              \
+    {                                                                                          \
+        auto result = daxa_dvc_destroy_##name##s(                                              \
+            r_cast<daxa_Device>(this->object),                                                 \
+            r_cast<daxa_##Name##Id const *>(ids.data()),                                       \
+            ids.size());                                                                       \
+        check_result(result, "invalid resource id");                                           \
+    }
+
+    DAXA_DECL_GPU_RES_BATCH_FN(Buffer, buffer)
+    DAXA_DECL_GPU_RES_BATCH_FN(Image, image)
+    DAXA_DECL_GPU_RES_BATCH_FN(ImageView, image_view)
+
     auto Device::buffer_device_address(BufferId id) const -> Optional<DeviceAddress>
     {
         DeviceAddress ret = 0;
@@ -536,9 +558,9 @@ namespace daxa
         return out_value;
     }
 
-    void Device::submit_commands(CommandSubmitInfo const & submit_info)
+    static auto to_c_submit_info(CommandSubmitInfo const & submit_info) -> daxa_CommandSubmitInfo
     {
-        daxa_CommandSubmitInfo const c_submit_info = {
+        return daxa_CommandSubmitInfo{
             .queue = std::bit_cast<daxa_Queue>(submit_info.queue),
             .wait_stages = static_cast<VkPipelineStageFlags>(submit_info.wait_stages.data),
             .command_lists = reinterpret_cast<daxa_ExecutableCommandList const *>(submit_info.command_lists.data()),
@@ -551,12 +573,36 @@ namespace daxa
             .wait_timeline_semaphore_count = submit_info.wait_timeline_semaphores.size(),
             .signal_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.signal_timeline_semaphores.data()),
             .signal_timeline_semaphore_count = submit_info.signal_timeline_semaphores.size(),
+            .wait_binary_semaphore_stages = reinterpret_cast<VkPipelineStageFlags2 const *>(submit_info.wait_binary_semaphore_stages.data()),
+            .wait_binary_semaphore_stage_count = submit_info.wait_binary_semaphore_stages.size(),
+            .wait_timeline_semaphore_stages = reinterpret_cast<VkPipelineStageFlags2 const *>(submit_info.wait_timeline_semaphore_stages.data()),
+            .wait_timeline_semaphore_stage_count = submit_info.wait_timeline_semaphore_stages.size(),
         };
+    }
+
+    void Device::submit_commands(CommandSubmitInfo const & submit_info)
+    {
+        daxa_CommandSubmitInfo const c_submit_info = to_c_submit_info(submit_info);
         check_result(
             daxa_dvc_submit(r_cast<daxa_Device>(this->object), &c_submit_info),
             "failed to submit commands");
     }
 
+    void Device::submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos)
+    {
+        // Reused per thread, Device has no state of its own and may be used by many threads in parallel.
+        static thread_local std::vector<daxa_CommandSubmitInfo> c_submit_infos = {};
+        c_submit_infos.clear();
+        for (auto const & submit_info : submit_infos)
+        {
+            c_submit_infos.push_back(to_c_submit_info(submit_info));
+        }
+        check_result(
+            daxa_dvc_submit_batch(r_cast<daxa_Device>(this->object), c_submit_infos.data(), c_submit_infos.size()),
+            "failed to submit command batch");
+        c_submit_infos.clear();
+    }
+
     void Device::present_frame(PresentInfo const & info)
     {
         daxa_PresentInfo const c_present_info = {
@@ -576,6 +622,76 @@ namespace daxa
             "failed to collect garbage");
     }
 
+    auto Device::memory_report(u32 largest_allocation_count) -> MemoryReport
+    {
+        daxa_MemoryReport c_report = {};
+        std::vector<MemoryReportAllocation> largest_allocations(largest_allocation_count);
+        check_result(
+            daxa_dvc_memory_report(
+                r_cast<daxa_Device>(this->object),
+                &c_report,
+                r_cast<daxa_MemoryReportAllocation *>(largest_allocations.data()),
+                largest_allocation_count),
+            "failed to create memory report");
+        largest_allocations.resize(c_report.largest_allocation_count);
+        MemoryReport ret = {
+            .memory_budget_enabled = c_report.memory_budget_enabled != 0,
+            .heaps = {},
+            .buffers = std::bit_cast<MemoryTotals>(c_report.buffers),
+            .images = std::bit_cast<MemoryTotals>(c_report.images),
+            .tlas = std::bit_cast<MemoryTotals>(c_report.tlas),
+            .blas = std::bit_cast<MemoryTotals>(c_report.blas),
+            .memory_blocks = std::bit_cast<MemoryTotals>(c_report.memory_blocks),
+            .aliased_memory_blocks = std::bit_cast<MemoryTotals>(c_report.aliased_memory_blocks),
+            .largest_allocations = std::move(largest_allocations),
+        };
+        for (u32 i = 0; i < c_report.heap_count; ++i)
+        {
+            ret.heaps.push_back(std::bit_cast<MemoryHeapReport>(c_report.heaps[i]));
+        }
+        return ret;
+    }
+
+    auto Device::latest_submit_index() const -> u64
+    {
+        return daxa_dvc_latest_submit_index(rc_cast<daxa_Device>(this->object));
+    }
+
+    auto Device::oldest_pending_submit_index() -> u64
+    {
+        u64 ret = {};
+        check_result(
+            daxa_dvc_oldest_pending_submit_index(r_cast<daxa_Device>(this->object), &ret),
+            "failed to query oldest pending submit index");
+        return ret;
+    }
+
+    auto Device::get_pipeline_cache_data() -> std::vector<std::byte>
+    {
+        std::vector<std::byte> ret = {};
+        u64 size = {};
+        daxa_Result result = DAXA_RESULT_INCOMPLETE;
+        // The cache can grow between the size query and the copy when pipelines are created in parallel.
+        while (result == DAXA_RESULT_INCOMPLETE)
+        {
+            check_result(
+                daxa_dvc_get_pipeline_cache_data(r_cast<daxa_Device>(this->object), &size, nullptr),
+                "failed to get pipeline cache data size");
+            ret.resize(size);
+            result = daxa_dvc_get_pipeline_cache_data(r_cast<daxa_Device>(this->object), &size, ret.data());
+            check_result(result, "failed to get pipeline cache data", std::array{DAXA_RESULT_SUCCESS, DAXA_RESULT_INCOMPLETE});
+        }
+        ret.resize(size);
+        return ret;
+    }
+
+    auto Device::load_pipeline_cache_data(std::span<std::byte const> data) -> bool
+    {
+        auto const result = daxa_dvc_load_pipeline_cache_data(r_cast<daxa_Device>(this->object), data.data(), data.size());
+        check_result(result, "failed to load pipeline cache data", std::array{DAXA_RESULT_SUCCESS, DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA});
+        return result == DAXA_RESULT_SUCCESS;
+    }
+
     auto Device::properties() const -> DeviceProperties const &
     {
         return *r_cast<DeviceProperties const *>(daxa_dvc_properties(rc_cast<daxa_Device>(object)));
@@ -167,29 +167,33 @@ auto only_check_blas(daxa_CommandRecorder self, T id) -> bool
 template <typename T>
 void remember_ids(daxa_CommandRecorder self, T id)
 {
+    if (!self->track_used_ids)
+    {
+        return;
+    }
     if constexpr (std::is_same_v<daxa_BufferId, T>)
     {
-        self->current_command_data.used_buffers.push_back(std::bit_cast<BufferId>(id));
+        self->current_command_data.used_buffers.remember(std::bit_cast<BufferId>(id), self->used_id_stamps.buffers);
     }
     if constexpr (std::is_same_v<daxa_ImageId, T>)
     {
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(id));
+        self->current_command_data.used_images.remember(std::bit_cast<ImageId>(id), self->used_id_stamps.images);
     }
     if constexpr (std::is_same_v<daxa_ImageViewId, T>)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(id));
+        self->current_command_data.used_image_views.remember(std::bit_cast<ImageViewId>(id), self->used_id_stamps.image_views);
     }
     if constexpr (std::is_same_v<daxa_SamplerId, T>)
     {
-        self->current_command_data.used_samplers.push_back(std::bit_cast<SamplerId>(id));
+        self->current_command_data.used_samplers.remember(std::bit_cast<SamplerId>(id), self->used_id_stamps.samplers);
     }
     if constexpr (std::is_same_v<daxa_TlasId, T>)
     {
-        self->current_command_data.used_tlass.push_back(std::bit_cast<TlasId>(id));
+        self->current_command_data.used_tlass.remember(std::bit_cast<TlasId>(id), self->used_id_stamps.tlass);
     }
     if constexpr (std::is_same_v<daxa_BlasId, T>)
     {
-        self->current_command_data.used_blass.push_back(std::bit_cast<BlasId>(id));
+        self->current_command_data.used_blass.remember(std::bit_cast<BlasId>(id), self->used_id_stamps.blass);
     }
 }
 
@@ -264,8 +268,8 @@ auto daxa_cmd_copy_buffer_to_buffer(daxa_CommandRecorder self, daxa_BufferCopyIn
     ImplBufferSlot const & src_slot = self->device->slot(info->src_buffer);
     ImplBufferSlot const & dst_slot = self->device->slot(info->dst_buffer);
     bool in_bounds = true;
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(src_slot.info.size));
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(dst_slot.info.size));
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(self->device->cold_slot(info->src_buffer).info.size));
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(self->device->cold_slot(info->dst_buffer).info.size));
     if (!in_bounds)
     {
         return DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS;
@@ -460,9 +464,10 @@ auto daxa_cmd_clear_image(daxa_CommandRecorder self, daxa_ImageClearInfo const *
     daxa_cmd_flush_barriers(self);
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->image)
     auto const & img_slot = self->device->slot(info->image);
+    auto const & img_cold_slot = self->device->cold_slot(info->image);
     bool const is_image_depth_stencil =
-        is_depth_format(std::bit_cast<Format>(img_slot.info.format)) ||
-        is_stencil_format(std::bit_cast<Format>(img_slot.info.format));
+        is_depth_format(std::bit_cast<Format>(img_cold_slot.info.format)) ||
+        is_stencil_format(std::bit_cast<Format>(img_cold_slot.info.format));
     bool const is_clear_depth_stencil = info->clear_value.index == 3;
     if (is_clear_depth_stencil)
     {
@@ -762,6 +767,10 @@ auto daxa_cmd_dispatch_indirect(daxa_CommandRecorder self, daxa_DispatchIndirect
 
 auto daxa_cmd_destroy_buffer_deferred(daxa_CommandRecorder self, daxa_BufferId id) -> daxa_Result
 {
+    if (self->info.reusable)
+    {
+        return DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER;
+    }
     DAXA_CHECK_AND_REMEMBER_IDS(self, id)
     self->current_command_data.deferred_destructions.emplace_back(std::bit_cast<GPUResourceId>(id), DEFERRED_DESTRUCTION_BUFFER_INDEX);
     return DAXA_RESULT_SUCCESS;
@@ -769,6 +778,10 @@ auto daxa_cmd_destroy_buffer_deferred(daxa_CommandRecorder self, daxa_BufferId i
 
 auto daxa_cmd_destroy_image_deferred(daxa_CommandRecorder self, daxa_ImageId id) -> daxa_Result
 {
+    if (self->info.reusable)
+    {
+        return DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER;
+    }
     DAXA_CHECK_AND_REMEMBER_IDS(self, id)
     self->current_command_data.deferred_destructions.emplace_back(std::bit_cast<GPUResourceId>(id), DEFERRED_DESTRUCTION_IMAGE_INDEX);
     return DAXA_RESULT_SUCCESS;
@@ -776,6 +789,10 @@ auto daxa_cmd_destroy_image_deferred(daxa_CommandRecorder self, daxa_ImageId id)
 
 auto daxa_cmd_destroy_image_view_deferred(daxa_CommandRecorder self, daxa_ImageViewId id) -> daxa_Result
 {
+    if (self->info.reusable)
+    {
+        return DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER;
+    }
     DAXA_CHECK_AND_REMEMBER_IDS(self, id)
     self->current_command_data.deferred_destructions.emplace_back(std::bit_cast<GPUResourceId>(id), DEFERRED_DESTRUCTION_IMAGE_VIEW_INDEX);
     return DAXA_RESULT_SUCCESS;
@@ -783,6 +800,10 @@ auto daxa_cmd_destroy_image_view_deferred(daxa_CommandRecorder self, daxa_ImageV
 
 auto daxa_cmd_destroy_sampler_deferred(daxa_CommandRecorder self, daxa_SamplerId id) -> daxa_Result
 {
+    if (self->info.reusable)
+    {
+        return DAXA_RESULT_ERROR_DEFERRED_DESTRUCTION_IN_REUSABLE_RECORDER;
+    }
     DAXA_CHECK_AND_REMEMBER_IDS(self, id)
     self->current_command_data.deferred_destructions.emplace_back(std::bit_cast<GPUResourceId>(id), DEFERRED_DESTRUCTION_SAMPLER_INDEX);
     return DAXA_RESULT_SUCCESS;
@@ -821,7 +842,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->color_attachments.data[i].image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->color_attachments.data[i].image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -834,7 +855,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->depth_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->depth_attachment.value.image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -847,7 +868,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->stencil_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->stencil_attachment.value.image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -855,18 +876,15 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
     };
     for (usize i = 0; i < info->color_attachments.size; ++i)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->color_attachments.data[i].image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->color_attachments.data[i].image_view).info.image));
+        remember_ids(self, info->color_attachments.data[i].image_view, self->device->cold_slot(info->color_attachments.data[i].image_view).info.image);
     }
     if (info->depth_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->depth_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->depth_attachment.value.image_view).info.image));
+        remember_ids(self, info->depth_attachment.value.image_view, self->device->cold_slot(info->depth_attachment.value.image_view).info.image);
     }
     if (info->stencil_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->stencil_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->stencil_attachment.value.image_view).info.image));
+        remember_ids(self, info->stencil_attachment.value.image_view, self->device->cold_slot(info->stencil_attachment.value.image_view).info.image);
     }
 
     VkRenderingInfo const vk_rendering_info{
@@ -1166,6 +1184,7 @@ auto daxa_dvc_create_command_recorder(daxa_Device device, daxa_CommandRecorderIn
     }();
     auto ret = daxa_ImplCommandRecorder{};
     ret.device = device;
+    ret.track_used_ids = (device->info.flags & DeviceInfoFlagBits::DISABLE_COMMAND_ID_TRACKING) == DeviceInfoFlagBits::NONE && !info->disable_id_tracking;
     ret.info = *info;
     ret.vk_cmd_pool = vk_cmd_pool;
     auto result = ret.generate_new_current_command_data();
@@ -1250,7 +1269,7 @@ auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Resul
     VkCommandBufferBeginInfo const vk_command_buffer_begin_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext = nullptr,
-        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .flags = this->info.reusable ? VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
         .pInheritanceInfo = {},
     };
     vk_result = vkBeginCommandBuffer(this->current_command_data.vk_cmd_buffer, &vk_command_buffer_begin_info);
@@ -1259,10 +1278,20 @@ auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Resul
         return std::bit_cast<daxa_Result>(vk_result);
     }
     this->allocated_command_buffers.push_back(this->current_command_data.vk_cmd_buffer);
-    this->current_command_data.used_buffers.reserve(12);
-    this->current_command_data.used_images.reserve(12);
-    this->current_command_data.used_image_views.reserve(12);
-    this->current_command_data.used_samplers.reserve(12);
+    if (this->track_used_ids)
+    {
+        u64 const generation = ++this->command_list_generation;
+        this->current_command_data.used_buffers.generation = generation;
+        this->current_command_data.used_images.generation = generation;
+        this->current_command_data.used_image_views.generation = generation;
+        this->current_command_data.used_samplers.generation = generation;
+        this->current_command_data.used_tlass.generation = generation;
+        this->current_command_data.used_blass.generation = generation;
+        this->current_command_data.used_buffers.ids.reserve(12);
+        this->current_command_data.used_images.ids.reserve(12);
+        this->current_command_data.used_image_views.ids.reserve(12);
+        this->current_command_data.used_samplers.ids.reserve(12);
+    }
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -1278,6 +1307,7 @@ void daxa_ImplCommandRecorder::zero_ref_callback(ImplHandle const * handle)
             .vk_cmd_pool = self->vk_cmd_pool,
             .allocated_command_buffers = std::move(self->allocated_command_buffers),
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         &daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
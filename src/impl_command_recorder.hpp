@@ -42,26 +42,103 @@ struct CommandRecorderZombie
     std::vector<VkCommandBuffer> allocated_command_buffers = {};
 };
 
+// Entry of the recorders open addressing set of ids remembered by the current command list.
+// Owned by the recorder, a new command list only gets a new generation, so stale stamps count as empty and never need clearing.
+struct UsedIdStamp
+{
+    u64 id = {};
+    u64 generation = {};
+};
+
+static inline constexpr usize USED_ID_STAMPS_MIN_CAPACITY = 64;
+
+// Ids referenced by a command list, validated on submit.
+// Most commands reference the same few ids over and over (bound buffers, attachments, samplers).
+// Each id is only added once per command list, checked with the recorders stamp set,
+// so the list (and with it the submit validation) scales with the number of distinct ids, not with the number of uses.
+// The stamp set is kept at most half full, its size follows the distinct ids of one command list, not the highest slot index.
+template <typename IdT>
+struct UsedIdList
+{
+    std::vector<IdT> ids = {};
+    // Generation of the owning command list, never 0, so zero initialized stamps never match.
+    u64 generation = {};
+
+    void remember(IdT id, std::vector<UsedIdStamp> & stamps)
+    {
+        if ((ids.size() + 1) * 2 > stamps.size())
+        {
+            grow_stamps(stamps);
+        }
+        u64 const value = std::bit_cast<u64>(id);
+        if (insert_stamp(value, stamps))
+        {
+            ids.push_back(id);
+        }
+    }
+
+    // Returns true if the id was not yet stamped for this generation.
+    auto insert_stamp(u64 value, std::vector<UsedIdStamp> & stamps) const -> bool
+    {
+        usize const mask = stamps.size() - 1;
+        // Fibonacci hashing of the slot index, consecutive indices spread over the whole set.
+        usize slot = static_cast<usize>((static_cast<u64>(std::bit_cast<GPUResourceId>(value).index) * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+        while (true)
+        {
+            UsedIdStamp & stamp = stamps[slot];
+            if (stamp.generation != this->generation)
+            {
+                stamp = {.id = value, .generation = this->generation};
+                return true;
+            }
+            if (stamp.id == value)
+            {
+                return false;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    // The stamps of the current generation are exactly the ids list, so they are reinserted from it.
+    void grow_stamps(std::vector<UsedIdStamp> & stamps) const
+    {
+        stamps.assign(std::max(USED_ID_STAMPS_MIN_CAPACITY, stamps.size() * 2), UsedIdStamp{});
+        for (IdT const & id : ids)
+        {
+            insert_stamp(std::bit_cast<u64>(id), stamps);
+        }
+    }
+};
+
+struct UsedIdStamps
+{
+    std::vector<UsedIdStamp> buffers = {};
+    std::vector<UsedIdStamp> images = {};
+    std::vector<UsedIdStamp> image_views = {};
+    std::vector<UsedIdStamp> samplers = {};
+    std::vector<UsedIdStamp> tlass = {};
+    std::vector<UsedIdStamp> blass = {};
+};
+
 struct ExecutableCommandListData
 {
     VkCommandBuffer vk_cmd_buffer = {};
     std::vector<std::pair<GPUResourceId, u8>> deferred_destructions = {};
-    // TODO:    These vectors seem to be fast enough. overhead is around 1-4% in cmd recording.
-    //          It might be cool to have some slab allocator for these.
-    // If there is demand, we could make an instance or cmd list flag to disable the submit checks.
+    // Not filled when the device was created with DAXA_DEVICE_INFO_FLAG_DISABLE_COMMAND_ID_TRACKING or the recorder with disable_id_tracking.
     // TODO:    Also collect ref counted handles.
-    std::vector<BufferId> used_buffers = {};
-    std::vector<ImageId> used_images = {};
-    std::vector<ImageViewId> used_image_views = {};
-    std::vector<SamplerId> used_samplers = {};
-    std::vector<TlasId> used_tlass = {};
-    std::vector<BlasId> used_blass = {};
+    UsedIdList<BufferId> used_buffers = {};
+    UsedIdList<ImageId> used_images = {};
+    UsedIdList<ImageViewId> used_image_views = {};
+    UsedIdList<SamplerId> used_samplers = {};
+    UsedIdList<TlasId> used_tlass = {};
+    UsedIdList<BlasId> used_blass = {};
 };
 
 struct daxa_ImplCommandRecorder final : ImplHandle
 {
     daxa_Device device = {};
     bool in_renderpass = {};
+    bool track_used_ids = {};
     daxa_CommandRecorderInfo info = {};
     VkCommandPool vk_cmd_pool = {};
     std::vector<VkCommandBuffer> allocated_command_buffers = {};
@@ -74,6 +151,8 @@ struct daxa_ImplCommandRecorder final : ImplHandle
     Variant<NoPipeline, daxa_ComputePipeline, daxa_RasterPipeline, daxa_RayTracingPipeline> current_pipeline = NoPipeline{};
 
     ExecutableCommandListData current_command_data = {};
+    u64 command_list_generation = {};
+    UsedIdStamps used_id_stamps = {};
 
     auto generate_new_current_command_data() -> daxa_Result;
     
@@ -558,8 +558,11 @@ auto daxa_dvc_create_memory(daxa_Device self, daxa_MemoryBlockInfo const * info,
     ret.strong_count = 1;
     self->inc_weak_refcnt();
     *out_memory_block = new daxa_ImplMemoryBlock{};
-    // TODO(general): memory block is missing a name.
     **out_memory_block = ret;
+    {
+        std::unique_lock const lock{self->live_memory_blocks_mtx};
+        self->live_memory_blocks.insert(*out_memory_block);
+    }
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -583,6 +586,10 @@ auto daxa_memory_block_dec_refcnt(daxa_MemoryBlock self) -> u64
 void daxa_ImplMemoryBlock::zero_ref_callback(ImplHandle const * handle)
 {
     auto * self = rc_cast<daxa_ImplMemoryBlock *>(handle);
+    {
+        std::unique_lock const live_lock{self->device->live_memory_blocks_mtx};
+        self->device->live_memory_blocks.erase(self);
+    }
     std::unique_lock const lock{self->device->zombies_mtx};
     u64 const submit_timeline_value = self->device->global_submit_timeline.load(std::memory_order::relaxed);
     self->device->memory_block_zombies.emplace_front(
@@ -590,6 +597,7 @@ void daxa_ImplMemoryBlock::zero_ref_callback(ImplHandle const * handle)
         MemoryBlockZombie{
             .allocation = self->allocation,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -11,6 +11,10 @@
 #include <map>
 #include <deque>
 #include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <array>
+#include <bit>
 #define FMT_HEADER_ONLY
 #define FMT_UNICODE 0
 #include <fmt/format.h>
@@ -54,6 +58,29 @@ using namespace daxa;
 
 // --- Begin Helpers ---
 
+auto daxa_result_to_string(daxa_Result result) -> std::string_view;
+
+// Used by the c++ wrappers around the c api, throws when the result is not one of the allowed codes.
+template <usize N = 1>
+void check_result(daxa_Result result, char const * message, std::array<daxa_Result, N> allowed_codes = {DAXA_RESULT_SUCCESS})
+{
+    bool result_allowed = false;
+    for (auto allowed_code : allowed_codes)
+    {
+        result_allowed = (result_allowed || allowed_code == result);
+    }
+    if (!result_allowed)
+    {
+        std::cout << fmt::format(
+                         "[[DAXA ASSERT FAILURE]]: error code: {}({}), {}.\n\n",
+                         daxa_result_to_string(result),
+                         std::bit_cast<i32>(result),
+                         message)
+                  << std::flush;
+        throw std::runtime_error({});
+    }
+}
+
 template <typename TO_T, typename FROM_T>
 auto rc_cast(FROM_T const * ptr)
 {
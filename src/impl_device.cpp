@@ -2,6 +2,7 @@
 
 #include <utility>
 #include <functional>
+#include <algorithm>
 #include "impl_features.hpp"
 
 #include "impl_device.hpp"
@@ -127,7 +128,8 @@ auto daxa_ImplDevice::ImplQueue::get_oldest_pending_submit(VkDevice vk_device, s
     return DAXA_RESULT_SUCCESS;
 }
 
-auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_BufferId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+// A reserved slot index is owned by the caller, it is not released when the creation fails.
+auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_BufferId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset, std::optional<u32> opt_reserved_index = {}) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     // --- Begin Parameter Validation ---
@@ -143,20 +145,25 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
 
     // --- End Parameter Validation ---
 
-    auto slot_opt = self->gpu_sro_table.buffer_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index.has_value()
+                        ? std::optional{self->gpu_sro_table.buffer_slots.reserved_slot(opt_reserved_index.value())}
+                        : self->gpu_sro_table.buffer_slots.try_create_slot();
     if (!slot_opt.has_value())
     {
         result = DAXA_RESULT_EXCEEDED_MAX_BUFFERS;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
 
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
-            self->gpu_sro_table.buffer_slots.unsafe_destroy_zombie_slot(id);
+            if (!opt_reserved_index.has_value())
+            {
+                self->gpu_sro_table.buffer_slots.unsafe_destroy_zombie_slot(id);
+            }
             if (ret.vk_buffer)
             {
                 vkDestroyBuffer(self->vk_device, ret.vk_buffer, nullptr);
@@ -164,13 +171,13 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
 
     VkBufferCreateInfo const vk_buffer_create_info{
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
-        .size = static_cast<VkDeviceSize>(ret.info.size),
+        .size = static_cast<VkDeviceSize>(ret_cold.info.size),
         .usage = create_buffer_use_flags(self),
         .sharingMode = VK_SHARING_MODE_CONCURRENT,                  // Buffers are always shared.
         .queueFamilyIndexCount = self->valid_vk_queue_family_count, // Buffers are always shared across all queues.
@@ -207,14 +214,14 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
             &vma_allocation_create_info,
             info->alignment,
             &ret.vk_buffer,
-            &ret.vma_allocation,
+            &ret_cold.vma_allocation,
             &vma_allocation_info));
         _DAXA_RETURN_IF_ERROR(result, result)
     }
     else
     {
         auto const & mem_block = *opt_memory_block;
-        ret.opt_memory_block = opt_memory_block;
+        ret_cold.opt_memory_block = opt_memory_block;
         opt_memory_block->inc_weak_refcnt();
 
         result = static_cast<daxa_Result>(vkCreateBuffer(self->vk_device, &vk_buffer_create_info, nullptr, &ret.vk_buffer));
@@ -255,22 +262,19 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &buffer_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_buffer(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set, ret.vk_buffer,
-            0,
-            static_cast<VkDeviceSize>(ret.info.size),
-            id.index);
-    }
+    self->gpu_sro_table.descriptor_writes.write_buffer(
+        ret.vk_buffer,
+        0,
+        static_cast<VkDeviceSize>(ret_cold.info.size),
+        static_cast<u32>(id.index));
 
+    self->gpu_sro_table.buffer_slots.publish_slot(id);
     *out_id = std::bit_cast<daxa_BufferId>(id);
     return result;
 }
 
-auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_ImageId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+// A reserved slot index is owned by the caller, it is not released when the creation fails.
+auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_ImageId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset, std::optional<u32> opt_reserved_index = {}) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     /// --- Begin Validation ---
@@ -282,33 +286,35 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
 
     /// --- End Validation ---
 
-    auto slot_opt = self->gpu_sro_table.image_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index.has_value()
+                        ? std::optional{self->gpu_sro_table.image_slots.reserved_slot(opt_reserved_index.value())}
+                        : self->gpu_sro_table.image_slots.try_create_slot();
     if (!slot_opt.has_value())
     {
         result = DAXA_RESULT_EXCEEDED_MAX_IMAGES;
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
             if (ret.vk_image)
             {
-                vmaDestroyImage(self->vma_allocator, ret.vk_image, ret.vma_allocation);
+                vmaDestroyImage(self->vma_allocator, ret.vk_image, ret_cold.vma_allocation);
             }
-            if (ret.view_slot.vk_image_view)
+            if (ret.vk_image_view)
             {
-                vkDestroyImageView(self->vk_device, ret.view_slot.vk_image_view, nullptr);
+                vkDestroyImageView(self->vk_device, ret.vk_image_view, nullptr);
             }
         }
     };
 
-    ret.info = *info;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret_cold.info = *info;
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(info->dimensions - 1),
-        .format = std::bit_cast<Format>(ret.info.format),
+        .format = std::bit_cast<Format>(ret_cold.info.format),
         .image = {id},
         .slice = ImageMipArraySlice{
             .base_mip_level = 0,
@@ -365,17 +371,17 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
             .priority = 0.5f,
         };
 
-        result = static_cast<daxa_Result>(vmaCreateImage(self->vma_allocator, &vk_image_create_info, &vma_allocation_create_info, &ret.vk_image, &ret.vma_allocation, nullptr));
+        result = static_cast<daxa_Result>(vmaCreateImage(self->vma_allocator, &vk_image_create_info, &vma_allocation_create_info, &ret.vk_image, &ret_cold.vma_allocation, nullptr));
         _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_IMAGE);
 
         vk_image_view_create_info.image = ret.vk_image;
-        result = static_cast<daxa_Result>(vkCreateImageView(self->vk_device, &vk_image_view_create_info, nullptr, &ret.view_slot.vk_image_view));
+        result = static_cast<daxa_Result>(vkCreateImageView(self->vk_device, &vk_image_view_create_info, nullptr, &ret.vk_image_view));
         _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_DEFAULT_IMAGE_VIEW);
     }
     else
     {
         daxa_ImplMemoryBlock const & mem_block = *opt_memory_block;
-        ret.opt_memory_block = opt_memory_block;
+        ret_cold.opt_memory_block = opt_memory_block;
         opt_memory_block->inc_weak_refcnt();
         // TODO(pahrens): Add validation for memory requirements.
         result = static_cast<daxa_Result>(vkCreateImage(self->vk_device, &vk_image_create_info, nullptr, &ret.vk_image));
@@ -390,7 +396,7 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
         _DAXA_RETURN_IF_ERROR(result, result);
 
         vk_image_view_create_info.image = ret.vk_image;
-        result = static_cast<daxa_Result>(vkCreateImageView(self->vk_device, &vk_image_view_create_info, nullptr, &ret.view_slot.vk_image_view));
+        result = static_cast<daxa_Result>(vkCreateImageView(self->vk_device, &vk_image_view_create_info, nullptr, &ret.vk_image_view));
         _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_DEFAULT_IMAGE_VIEW);
     }
 
@@ -410,22 +416,17 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
             .objectType = VK_OBJECT_TYPE_IMAGE_VIEW,
-            .objectHandle = std::bit_cast<uint64_t>(ret.view_slot.vk_image_view),
+            .objectHandle = std::bit_cast<uint64_t>(ret.vk_image_view),
             .pObjectName = c_str_arr.data(),
         };
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &swapchain_image_view_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
-            ret.view_slot.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(ret.info.usage),
-            id.index);
-    }
+    self->gpu_sro_table.descriptor_writes.write_image(
+        ret.vk_image_view,
+        std::bit_cast<ImageUsageFlags>(ret_cold.info.usage),
+        static_cast<u32>(id.index));
+    self->gpu_sro_table.image_slots.publish_slot(id);
     *out_id = std::bit_cast<daxa_ImageId>(id);
     return result;
 }
@@ -457,56 +458,56 @@ auto create_acceleration_structure_helper(
     }
     _DAXA_RETURN_IF_ERROR(result, result);
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
             table.unsafe_destroy_zombie_slot(id);
-            if (!ret.buffer_id.is_empty())
+            if (!ret_cold.buffer_id.is_empty())
             {
-                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_buffer(self, ret.buffer_id);
+                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_buffer(self, ret_cold.buffer_id);
             }
         }
     };
 
-    ret.info = info;
+    ret_cold.info = info;
 
     if (buffer)
     {
-        ret.buffer_id = std::bit_cast<daxa::BufferId>(*buffer);
-        ret.offset = *offset;
-        ret.owns_buffer = false;
+        ret_cold.buffer_id = std::bit_cast<daxa::BufferId>(*buffer);
+        ret_cold.offset = *offset;
+        ret_cold.owns_buffer = false;
     }
     else
     {
-        daxa::SmallString buffer_name{std::string_view{ret.info.name.data, ret.info.name.size}};
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        daxa::SmallString buffer_name{std::string_view{ret_cold.info.name.data, ret_cold.info.name.size}};
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back(' ');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('b');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('u');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('f');
         auto cinfo = daxa_BufferInfo{
-            .size = ret.info.size,
+            .size = ret_cold.info.size,
             .name = std::bit_cast<daxa_SmallString>(buffer_name),
         };
-        result = daxa_dvc_create_buffer(self, &cinfo, r_cast<daxa_BufferId *>(&ret.buffer_id));
+        result = daxa_dvc_create_buffer(self, &cinfo, r_cast<daxa_BufferId *>(&ret_cold.buffer_id));
         _DAXA_RETURN_IF_ERROR(result, result);
-        ret.offset = 0;
-        ret.owns_buffer = true;
+        ret_cold.offset = 0;
+        ret_cold.owns_buffer = true;
     }
-    ret.vk_buffer = self->slot(ret.buffer_id).vk_buffer;
+    ret_cold.vk_buffer = self->slot(ret_cold.buffer_id).vk_buffer;
 
     VkAccelerationStructureCreateInfoKHR vk_create_info = {
         .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
         .pNext = nullptr,
         .createFlags = {}, // VK_ACCELERATION_STRUCTURE_CREATE_DEVICE_ADDRESS_CAPTURE_REPLAY_BIT_KHR,
-        .buffer = self->slot(ret.buffer_id).vk_buffer,
-        .offset = ret.offset,
-        .size = ret.info.size,
+        .buffer = ret_cold.vk_buffer,
+        .offset = ret_cold.offset,
+        .size = ret_cold.info.size,
         .type = vk_as_type,
         .deviceAddress = {},
     };
@@ -522,9 +523,9 @@ auto create_acceleration_structure_helper(
         self->vk_device,
         &vk_acceleration_structure_device_address_info_khr);
 
-    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret.info.name.size != 0)
+    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret_cold.info.name.size != 0)
     {
-        auto c_str_arr = r_cast<SmallString const *>(&ret.info.name)->c_str();
+        auto c_str_arr = r_cast<SmallString const *>(&ret_cold.info.name)->c_str();
         VkDebugUtilsObjectNameInfoEXT const swapchain_image_name_info{
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
@@ -537,15 +538,12 @@ auto create_acceleration_structure_helper(
 
     if (vk_as_type == VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR)
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_acceleration_structure(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
+        self->gpu_sro_table.descriptor_writes.write_acceleration_structure(
             ret.vk_acceleration_structure,
-            id.index);
+            static_cast<u32>(id.index));
     }
 
+    table.publish_slot(id);
     *out_id = std::bit_cast<typename std::remove_pointer<decltype(out_id)>::type>(id);
     return result;
 }
@@ -764,44 +762,53 @@ auto daxa_dvc_create_blas_from_buffer(daxa_Device self, daxa_BufferBlasInfo cons
         out_id);
 }
 
-auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id) -> daxa_Result
+// A reserved slot index is owned by the caller, it is not released when the creation fails.
+auto create_image_view_helper(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id, std::optional<u32> opt_reserved_index = {}) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     /// --- Begin Validation ---
 
     /// --- End Validation ---
 
-    auto slot_opt = self->gpu_sro_table.image_slots.try_create_slot();
+    auto slot_opt = opt_reserved_index.has_value()
+                        ? std::optional{self->gpu_sro_table.image_slots.reserved_slot(opt_reserved_index.value())}
+                        : self->gpu_sro_table.image_slots.try_create_slot();
     if (!slot_opt.has_value())
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS, DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS);
     }
-    auto [id, image_slot] = slot_opt.value();
+    auto [id, image_slot, image_cold_slot] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
-            self->gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(id);
-            if (image_slot.view_slot.vk_image_view)
+            if (!opt_reserved_index.has_value())
+            {
+                self->gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(id);
+            }
+            if (image_slot.vk_image_view)
             {
-                vkDestroyImageView(self->vk_device, image_slot.view_slot.vk_image_view, nullptr);
+                vkDestroyImageView(self->vk_device, image_slot.vk_image_view, nullptr);
             }
         }
     };
 
     ImplImageSlot const & parent_image_slot = self->slot(info->image);
+    ImplImageColdSlot const & parent_image_cold_slot = self->cold_slot(info->image);
     image_slot = {};
-    auto & ret = image_slot.view_slot;
-    ret.info = *info;
-    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret.info.slice, ret.info.image);
-    ret.info.slice = slice;
+    image_cold_slot = {};
+    auto & ret = image_slot;
+    auto & ret_cold = image_cold_slot.view_slot;
+    ret_cold.info = *info;
+    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret_cold.info.slice, ret_cold.info.image);
+    ret_cold.info.slice = slice;
     VkImageViewCreateInfo const vk_image_view_create_info{
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
         .image = parent_image_slot.vk_image,
-        .viewType = static_cast<VkImageViewType>(ret.info.type),
-        .format = *r_cast<VkFormat const *>(&ret.info.format),
+        .viewType = static_cast<VkImageViewType>(ret_cold.info.type),
+        .format = *r_cast<VkFormat const *>(&ret_cold.info.format),
         .components = VkComponentMapping{
             .r = VK_COMPONENT_SWIZZLE_IDENTITY,
             .g = VK_COMPONENT_SWIZZLE_IDENTITY,
@@ -825,20 +832,164 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &name_info);
     }
 
+    self->gpu_sro_table.descriptor_writes.write_image(
+        ret.vk_image_view,
+        std::bit_cast<ImageUsageFlags>(parent_image_cold_slot.info.usage),
+        static_cast<u32>(id.index));
+    self->gpu_sro_table.image_slots.publish_slot(id);
+    *out_id = std::bit_cast<daxa_ImageViewId>(id);
+    return result;
+}
+
+auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id) -> daxa_Result
+{
+    return create_image_view_helper(self, info, out_id);
+}
+
+namespace
+{
+    auto make_image_view_cache_key(daxa_ImageViewInfo const & info) -> ImageViewCacheKey
+    {
+        return ImageViewCacheKey{
+            std::bit_cast<u64>(info.image),
+            (static_cast<u64>(info.type) << 32) | static_cast<u64>(info.format),
+            (static_cast<u64>(info.slice.base_mip_level) << 32) | static_cast<u64>(info.slice.level_count),
+            (static_cast<u64>(info.slice.base_array_layer) << 32) | static_cast<u64>(info.slice.layer_count),
+        };
+    }
+} // namespace
+
+auto daxa_dvc_cached_image_view(daxa_Device self, daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id) -> daxa_Result
+{
+    // Held for the whole lookup and creation.
+    // Destroying the parent image evicts under the same lock, so no view can be cached for an already destroyed image.
+    std::unique_lock const cache_lock{self->image_view_cache_mtx};
+    if (!daxa_dvc_is_image_valid(self, info->image))
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
-            ret.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(parent_image_slot.info.usage),
-            id.index);
-        *out_id = std::bit_cast<daxa_ImageViewId>(id);
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_INVALID_IMAGE_ID, DAXA_RESULT_INVALID_IMAGE_ID);
+    }
+    daxa_ImageViewInfo view_info = *info;
+    view_info.slice = self->validate_image_slice(view_info.slice, view_info.image);
+
+    // Views equal to the default view of the image are never cached.
+    daxa_ImageViewInfo const & default_view_info = self->cold_slot(info->image).view_slot.info;
+    if (view_info.type == default_view_info.type &&
+        view_info.format == default_view_info.format &&
+        std::bit_cast<ImageMipArraySlice>(view_info.slice) == std::bit_cast<ImageMipArraySlice>(default_view_info.slice))
+    {
+        *out_id = std::bit_cast<daxa_ImageViewId>(info->image);
+        return DAXA_RESULT_SUCCESS;
+    }
+
+    ImageViewCacheKey const cache_key = make_image_view_cache_key(view_info);
+    if (auto iter = self->image_view_cache.find(cache_key); iter != self->image_view_cache.end())
+    {
+        *out_id = std::bit_cast<daxa_ImageViewId>(iter->second);
+        return DAXA_RESULT_SUCCESS;
+    }
+    auto result = create_image_view_helper(self, &view_info, out_id);
+    _DAXA_RETURN_IF_ERROR(result, result)
+    self->image_view_cache.emplace(cache_key, std::bit_cast<ImageViewId>(*out_id));
+    self->cached_image_views_per_image[std::bit_cast<u64>(info->image)].push_back(cache_key);
+    return DAXA_RESULT_SUCCESS;
+}
+
+thread_local std::vector<u32> tl_batch_slot_indices = {};
+
+// Creates all resources of a batch or none of them.
+// The slots of the whole batch are reserved up front, a batch exceeding the resource limit fails before creating anything.
+// The descriptor writes of the batch are coalesced in the devices descriptor write queue.
+// Memory is still allocated per resource, the infos of a batch usually differ in their memory requirements.
+template <typename InfoT, typename IdT>
+auto create_batch_helper(InfoT const * infos, u64 count, IdT * out_ids, auto & slots, daxa_Result exceeded_result, auto && create_fn, auto && destroy_fn) -> daxa_Result
+{
+    auto & slot_indices = tl_batch_slot_indices;
+    slot_indices.resize(count);
+    if (!slots.try_reserve_slots(std::span{slot_indices}))
+    {
+        std::fill_n(out_ids, count, IdT{});
+        _DAXA_RETURN_IF_ERROR(exceeded_result, exceeded_result)
+    }
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    u64 created_count = 0;
+    for (; created_count < count; ++created_count)
+    {
+        result = create_fn(&infos[created_count], &out_ids[created_count], slot_indices[created_count]);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            break;
+        }
+    }
+    if (result != DAXA_RESULT_SUCCESS)
+    {
+        slots.release_reserved_slots(std::span<u32 const>{slot_indices}.subspan(created_count));
+        [[maybe_unused]] auto const _ignore = destroy_fn(out_ids, created_count);
+        std::fill_n(out_ids, count, IdT{});
     }
     return result;
 }
 
+auto daxa_dvc_create_buffers(daxa_Device self, daxa_BufferInfo const * infos, u64 count, daxa_BufferId * out_ids) -> daxa_Result
+{
+    return create_batch_helper(
+        infos, count, out_ids, self->gpu_sro_table.buffer_slots, DAXA_RESULT_EXCEEDED_MAX_BUFFERS,
+        [&](daxa_BufferInfo const * info, daxa_BufferId * out_id, u32 slot_index)
+        { return create_buffer_helper(self, info, out_id, nullptr, 0, slot_index); },
+        [&](daxa_BufferId const * ids, u64 id_count)
+        { return daxa_dvc_destroy_buffers(self, ids, id_count); });
+}
+
+auto daxa_dvc_create_images(daxa_Device self, daxa_ImageInfo const * infos, u64 count, daxa_ImageId * out_ids) -> daxa_Result
+{
+    return create_batch_helper(
+        infos, count, out_ids, self->gpu_sro_table.image_slots, DAXA_RESULT_EXCEEDED_MAX_IMAGES,
+        [&](daxa_ImageInfo const * info, daxa_ImageId * out_id, u32 slot_index)
+        { return create_image_helper(self, info, out_id, nullptr, 0, slot_index); },
+        [&](daxa_ImageId const * ids, u64 id_count)
+        { return daxa_dvc_destroy_images(self, ids, id_count); });
+}
+
+auto daxa_dvc_create_image_views(daxa_Device self, daxa_ImageViewInfo const * infos, u64 count, daxa_ImageViewId * out_ids) -> daxa_Result
+{
+    return create_batch_helper(
+        infos, count, out_ids, self->gpu_sro_table.image_slots, DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS,
+        [&](daxa_ImageViewInfo const * info, daxa_ImageViewId * out_id, u32 slot_index)
+        { return create_image_view_helper(self, info, out_id, slot_index); },
+        [&](daxa_ImageViewId const * ids, u64 id_count)
+        { return daxa_dvc_destroy_image_views(self, ids, id_count); });
+}
+
+namespace
+{
+    // -0.0f and 0.0f create identical samplers but differ in their bits, both are keyed as 0.0f.
+    auto sampler_cache_float_bits(f32 value) -> u32
+    {
+        return std::bit_cast<u32>(value == 0.0f ? 0.0f : value);
+    }
+
+    auto make_sampler_cache_key(daxa_SamplerInfo const & info) -> SamplerCacheKey
+    {
+        return SamplerCacheKey{
+            static_cast<u32>(info.magnification_filter),
+            static_cast<u32>(info.minification_filter),
+            static_cast<u32>(info.mipmap_filter),
+            static_cast<u32>(info.reduction_mode),
+            static_cast<u32>(info.address_mode_u),
+            static_cast<u32>(info.address_mode_v),
+            static_cast<u32>(info.address_mode_w),
+            sampler_cache_float_bits(info.mip_lod_bias),
+            static_cast<u32>(info.enable_anisotropy),
+            sampler_cache_float_bits(info.max_anisotropy),
+            static_cast<u32>(info.enable_compare),
+            static_cast<u32>(info.compare_op),
+            sampler_cache_float_bits(info.min_lod),
+            sampler_cache_float_bits(info.max_lod),
+            static_cast<u32>(info.border_color),
+            static_cast<u32>(info.enable_unnormalized_coordinates),
+        };
+    }
+} // namespace
+
 auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, daxa_SamplerId * out_id) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
@@ -850,12 +1001,23 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     }
 
     /// --- End Validation ---
+
+    // Held for the whole creation, so that concurrent creations of the same info can not create duplicates.
+    SamplerCacheKey const cache_key = make_sampler_cache_key(*info);
+    std::unique_lock const cache_lock{self->sampler_cache_mtx};
+    if (auto iter = self->sampler_cache.find(cache_key); iter != self->sampler_cache.end())
+    {
+        iter->second.refcount += 1;
+        *out_id = std::bit_cast<daxa_SamplerId>(iter->second.id);
+        return DAXA_RESULT_SUCCESS;
+    }
+
     auto slot_opt = self->gpu_sro_table.sampler_slots.try_create_slot();
     if (!slot_opt.has_value())
     {
-        return DAXA_RESULT_EXCEEDED_MAX_SAMPLERS;
+        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_EXCEEDED_MAX_SAMPLERS, DAXA_RESULT_EXCEEDED_MAX_SAMPLERS);
     }
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -868,33 +1030,33 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
 
     VkSamplerReductionModeCreateInfo vk_sampler_reduction_mode_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_REDUCTION_MODE_CREATE_INFO,
         .pNext = nullptr,
-        .reductionMode = static_cast<VkSamplerReductionMode>(ret.info.reduction_mode),
+        .reductionMode = static_cast<VkSamplerReductionMode>(ret_cold.info.reduction_mode),
     };
 
     VkSamplerCreateInfo const vk_sampler_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
         .pNext = r_cast<void *>(&vk_sampler_reduction_mode_create_info),
         .flags = {},
-        .magFilter = static_cast<VkFilter>(ret.info.magnification_filter),
-        .minFilter = static_cast<VkFilter>(ret.info.minification_filter),
-        .mipmapMode = static_cast<VkSamplerMipmapMode>(ret.info.mipmap_filter),
-        .addressModeU = static_cast<VkSamplerAddressMode>(ret.info.address_mode_u),
-        .addressModeV = static_cast<VkSamplerAddressMode>(ret.info.address_mode_v),
-        .addressModeW = static_cast<VkSamplerAddressMode>(ret.info.address_mode_w),
-        .mipLodBias = ret.info.mip_lod_bias,
-        .anisotropyEnable = static_cast<VkBool32>(ret.info.enable_anisotropy),
-        .maxAnisotropy = ret.info.max_anisotropy,
-        .compareEnable = static_cast<VkBool32>(ret.info.enable_compare),
-        .compareOp = static_cast<VkCompareOp>(ret.info.compare_op),
-        .minLod = ret.info.min_lod,
-        .maxLod = ret.info.max_lod,
-        .borderColor = static_cast<VkBorderColor>(ret.info.border_color),
-        .unnormalizedCoordinates = static_cast<VkBool32>(ret.info.enable_unnormalized_coordinates),
+        .magFilter = static_cast<VkFilter>(ret_cold.info.magnification_filter),
+        .minFilter = static_cast<VkFilter>(ret_cold.info.minification_filter),
+        .mipmapMode = static_cast<VkSamplerMipmapMode>(ret_cold.info.mipmap_filter),
+        .addressModeU = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_u),
+        .addressModeV = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_v),
+        .addressModeW = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_w),
+        .mipLodBias = ret_cold.info.mip_lod_bias,
+        .anisotropyEnable = static_cast<VkBool32>(ret_cold.info.enable_anisotropy),
+        .maxAnisotropy = ret_cold.info.max_anisotropy,
+        .compareEnable = static_cast<VkBool32>(ret_cold.info.enable_compare),
+        .compareOp = static_cast<VkCompareOp>(ret_cold.info.compare_op),
+        .minLod = ret_cold.info.min_lod,
+        .maxLod = ret_cold.info.max_lod,
+        .borderColor = static_cast<VkBorderColor>(ret_cold.info.border_color),
+        .unnormalizedCoordinates = static_cast<VkBool32>(ret_cold.info.enable_unnormalized_coordinates),
     };
 
     result = static_cast<daxa_Result>(vkCreateSampler(self->vk_device, &vk_sampler_create_info, nullptr, &ret.vk_sampler));
@@ -913,16 +1075,14 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
         self->vkSetDebugUtilsObjectNameEXT(self->vk_device, &sampler_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(self->vk_device, self->gpu_sro_table.vk_descriptor_set, ret.vk_sampler, id.index);
-    }
+    self->gpu_sro_table.descriptor_writes.write_sampler(ret.vk_sampler, static_cast<u32>(id.index));
+    self->sampler_cache.emplace(cache_key, SamplerCacheEntry{.id = std::bit_cast<SamplerId>(id), .refcount = 1});
+    self->gpu_sro_table.sampler_slots.publish_slot(id);
     *out_id = std::bit_cast<daxa_SamplerId>(id);
     return result;
 }
 
-#define _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(name, Name, NAME, SLOT_NAME, vk_name, VK_NAME)                        \
+#define _DAXA_DECL_GP_RES_DESTROY_FUNCTION(name, Name, NAME, SLOT_NAME)                                          \
     auto daxa_dvc_destroy_##name(daxa_Device self, daxa_##Name##Id id) -> daxa_Result                            \
     {                                                                                                            \
         _DAXA_TEST_PRINT("STRONG daxa_dvc_destroy_%s\n", #name);                                                 \
@@ -933,11 +1093,13 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
             return DAXA_RESULT_SUCCESS;                                                                          \
         }                                                                                                        \
         return DAXA_RESULT_INVALID_##NAME##_ID;                                                                  \
-    }                                                                                                            \
+    }
+
+#define _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(name, Name, NAME, SLOT_NAME, vk_name, VK_NAME)                        \
     auto daxa_dvc_info_##name(daxa_Device self, daxa_##Name##Id id, daxa_##Name##Info * out_info) -> daxa_Result \
     {                                                                                                            \
         /*NOTE: THIS CAN RACE. BUT IT IS OK AS ITS A POD AND WE CHECK IF ITS VALID AFTER THE COPY!*/             \
-        auto info_copy = self->slot(id).info;                                                                    \
+        auto info_copy = self->cold_slot(id).info;                                                               \
         if (daxa_dvc_is_##name##_valid(self, id))                                                                \
         {                                                                                                        \
             *out_info = info_copy;                                                                               \
@@ -967,6 +1129,89 @@ _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(sampler, Sampler, SAMPLER, sampler_slots, sam
 _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(tlas, Tlas, TLAS, tlas_slots, acceleration_structure, VkAccelerationStructureKHR)
 _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(blas, Blas, BLAS, blas_slots, acceleration_structure, VkAccelerationStructureKHR)
 
+_DAXA_DECL_GP_RES_DESTROY_FUNCTION(buffer, Buffer, BUFFER, buffer_slots)
+_DAXA_DECL_GP_RES_DESTROY_FUNCTION(image, Image, IMAGE, image_slots)
+_DAXA_DECL_GP_RES_DESTROY_FUNCTION(image_view, ImageView, IMAGE_VIEW, image_slots)
+_DAXA_DECL_GP_RES_DESTROY_FUNCTION(tlas, Tlas, TLAS, tlas_slots)
+_DAXA_DECL_GP_RES_DESTROY_FUNCTION(blas, Blas, BLAS, blas_slots)
+
+// Samplers are refcounted by the sampler cache, only the last destroy zombifies the sampler.
+auto daxa_dvc_destroy_sampler(daxa_Device self, daxa_SamplerId id) -> daxa_Result
+{
+    _DAXA_TEST_PRINT("STRONG daxa_dvc_destroy_sampler\n");
+    std::unique_lock const cache_lock{self->sampler_cache_mtx};
+    if (!daxa_dvc_is_sampler_valid(self, id))
+    {
+        return DAXA_RESULT_INVALID_SAMPLER_ID;
+    }
+    auto iter = self->sampler_cache.find(make_sampler_cache_key(self->cold_slot(id).info));
+    if (iter != self->sampler_cache.end() && iter->second.id == std::bit_cast<SamplerId>(id))
+    {
+        iter->second.refcount -= 1;
+        if (iter->second.refcount > 0)
+        {
+            return DAXA_RESULT_SUCCESS;
+        }
+        self->sampler_cache.erase(iter);
+    }
+    auto success = self->gpu_sro_table.sampler_slots.try_zombify(std::bit_cast<GPUResourceId>(id));
+    if (success)
+    {
+        self->zombify_sampler(std::bit_cast<SamplerId>(id));
+        return DAXA_RESULT_SUCCESS;
+    }
+    return DAXA_RESULT_INVALID_SAMPLER_ID;
+}
+
+template <typename CppIdT>
+thread_local std::vector<CppIdT> tl_batch_zombified_ids = {};
+
+// Invalid ids are skipped, all valid ids of the batch are still destroyed.
+template <typename CppIdT, typename IdT>
+auto destroy_batch_helper(IdT const * ids, u64 count, auto & slots, daxa_Result invalid_id_result, auto && zombify_fn) -> daxa_Result
+{
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    auto & zombified_ids = tl_batch_zombified_ids<CppIdT>;
+    zombified_ids.clear();
+    for (IdT const & id : std::span{ids, count})
+    {
+        if (slots.try_zombify(std::bit_cast<GPUResourceId>(id)))
+        {
+            zombified_ids.push_back(std::bit_cast<CppIdT>(id));
+        }
+        else
+        {
+            result = invalid_id_result;
+        }
+    }
+    zombify_fn(std::span<CppIdT const>{zombified_ids});
+    return result;
+}
+
+auto daxa_dvc_destroy_buffers(daxa_Device self, daxa_BufferId const * ids, u64 count) -> daxa_Result
+{
+    return destroy_batch_helper<BufferId>(
+        ids, count, self->gpu_sro_table.buffer_slots, DAXA_RESULT_INVALID_BUFFER_ID,
+        [&](std::span<BufferId const> zombified_ids)
+        { self->zombify_buffers(zombified_ids); });
+}
+
+auto daxa_dvc_destroy_images(daxa_Device self, daxa_ImageId const * ids, u64 count) -> daxa_Result
+{
+    return destroy_batch_helper<ImageId>(
+        ids, count, self->gpu_sro_table.image_slots, DAXA_RESULT_INVALID_IMAGE_ID,
+        [&](std::span<ImageId const> zombified_ids)
+        { self->zombify_images(zombified_ids); });
+}
+
+auto daxa_dvc_destroy_image_views(daxa_Device self, daxa_ImageViewId const * ids, u64 count) -> daxa_Result
+{
+    return destroy_batch_helper<ImageViewId>(
+        ids, count, self->gpu_sro_table.image_slots, DAXA_RESULT_INVALID_IMAGE_VIEW_ID,
+        [&](std::span<ImageViewId const> zombified_ids)
+        { self->zombify_image_views(zombified_ids); });
+}
+
 auto daxa_dvc_buffer_device_address(daxa_Device self, daxa_BufferId id, daxa_DeviceAddress * out_addr) -> daxa_Result
 {
     if (!daxa_dvc_is_buffer_valid(self, id))
@@ -1056,132 +1301,175 @@ auto daxa_dvc_queue_count(daxa_Device self, daxa_QueueFamily queue_family, u32 *
 
 auto daxa_dvc_submit(daxa_Device self, daxa_CommandSubmitInfo const * info) -> daxa_Result
 {
-    if (!self->valid_queue(info->queue))
+    return daxa_dvc_submit_batch(self, info, 1);
+}
+
+auto daxa_dvc_submit_batch(daxa_Device self, daxa_CommandSubmitInfo const * infos, u64 info_count) -> daxa_Result
+{
+    if (info_count == 0)
+    {
+        return DAXA_RESULT_SUCCESS;
+    }
+    daxa_Queue const submit_queue = infos[0].queue;
+    if (!self->valid_queue(submit_queue))
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
     }
 
     std::shared_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
 
-    if (static_cast<u32>(info->queue.index) >= self->queue_families[info->queue.family].queue_count)
+    if (static_cast<u32>(submit_queue.index) >= self->queue_families[submit_queue.family].queue_count)
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
     }
 
-    for (daxa_ExecutableCommandList commands : std::span{info->command_lists, info->command_list_count})
+    for (daxa_CommandSubmitInfo const & info : std::span{infos, info_count})
     {
-        if (commands->cmd_recorder->info.queue_family != info->queue.family)
+        if (info.queue.family != submit_queue.family || info.queue.index != submit_queue.index)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_SUBMIT_BATCH_QUEUE_MISMATCH, DAXA_RESULT_ERROR_SUBMIT_BATCH_QUEUE_MISMATCH);
+        }
+
+        bool const wait_binary_stages_valid = info.wait_binary_semaphore_stage_count == 0 || info.wait_binary_semaphore_stage_count == info.wait_binary_semaphore_count;
+        bool const wait_timeline_stages_valid = info.wait_timeline_semaphore_stage_count == 0 || info.wait_timeline_semaphore_stage_count == info.wait_timeline_semaphore_count;
+        if (!wait_binary_stages_valid || !wait_timeline_stages_valid)
         {
-            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_SUBMIT_WAIT_STAGE_COUNT_MISMATCH, DAXA_RESULT_ERROR_SUBMIT_WAIT_STAGE_COUNT_MISMATCH);
         }
-        for (BufferId id : commands->data.used_buffers)
+
+        for (daxa_ExecutableCommandList commands : std::span{info.command_lists, info.command_list_count})
         {
-            if (!daxa_dvc_is_buffer_valid(self, id))
+            if (commands->cmd_recorder->info.queue_family != submit_queue.family)
+            {
+                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
+            }
+            if (!self->gpu_sro_table.buffer_slots.are_ids_valid(std::span{std::as_const(commands->data.used_buffers.ids)}))
             {
                 _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID);
             }
-        }
-        for (ImageId id : commands->data.used_images)
-        {
-            if (!daxa_dvc_is_image_valid(self, id))
+            if (!self->gpu_sro_table.image_slots.are_ids_valid(std::span{std::as_const(commands->data.used_images.ids)}))
             {
                 _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID);
             }
-        }
-        for (ImageViewId id : commands->data.used_image_views)
-        {
-            if (!daxa_dvc_is_image_view_valid(self, id))
+            if (!self->gpu_sro_table.image_slots.are_ids_valid(std::span{std::as_const(commands->data.used_image_views.ids)}))
             {
                 _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID);
             }
-        }
-        for (SamplerId id : commands->data.used_samplers)
-        {
-            if (!daxa_dvc_is_sampler_valid(self, id))
+            if (!self->gpu_sro_table.sampler_slots.are_ids_valid(std::span{std::as_const(commands->data.used_samplers.ids)}))
             {
                 _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID);
             }
         }
     }
 
-    daxa_ImplDevice::ImplQueue & queue = self->get_queue(info->queue);
+    // Resources created since the last submit become visible to the gpu here.
+    self->gpu_sro_table.descriptor_writes.flush(self->vk_device, self->gpu_sro_table.vk_descriptor_set);
+
+    // The whole batch shares one global timeline value.
+    // Only the last submit signals the queue timeline, its signal operation covers all earlier submits to the queue.
+    daxa_ImplDevice::ImplQueue & queue = self->get_queue(submit_queue);
     u64 const current_timeline_value = self->global_submit_timeline.fetch_add(1) + 1;
     queue.latest_pending_submit_timeline_value.store(current_timeline_value);
 
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
-    {
-        executable_cmd_list_execute_deferred_destructions(self, commands->data);
-    }
-
-    std::vector<VkCommandBuffer> submit_vk_command_buffers = {};
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
+    for (daxa_CommandSubmitInfo const & info : std::span{infos, info_count})
     {
-        submit_vk_command_buffers.push_back(commands->data.vk_cmd_buffer);
+        for (auto const & commands : std::span{info.command_lists, info.command_list_count})
+        {
+            executable_cmd_list_execute_deferred_destructions(self, commands->data);
+        }
     }
 
-    std::vector<VkSemaphore> submit_semaphore_signals = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<u64> submit_semaphore_signal_values = {};   // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
-
-    // Add main queue timeline signaling as first timeline semaphore signaling:
-    submit_semaphore_signals.push_back(queue.gpu_queue_local_timeline);
-    submit_semaphore_signal_values.push_back(current_timeline_value);
-
-    for (auto const & pair : std::span{info->signal_timeline_semaphores, info->signal_timeline_semaphore_count})
+    auto make_semaphore_submit_info = [](VkSemaphore semaphore, u64 value, VkPipelineStageFlags2 stages)
     {
-        submit_semaphore_signals.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(pair.value);
-    }
+        return VkSemaphoreSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .pNext = nullptr,
+            .semaphore = semaphore,
+            .value = value, // Ignored for binary semaphores.
+            .stageMask = stages,
+            .deviceIndex = {},
+        };
+    };
 
-    for (auto const & binary_semaphore : std::span{info->signal_binary_semaphores, info->signal_binary_semaphore_count})
-    {
-        submit_semaphore_signals.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(0); // The vulkan spec requires to have dummy values for binary semaphores.
-    }
+    queue.submit_command_buffer_infos.clear();
+    queue.submit_wait_semaphore_infos.clear();
+    queue.submit_signal_semaphore_infos.clear();
+    queue.submit_infos.clear();
+    // The submit infos point into the scratch vectors, reserve up front so that they never reallocate while being filled.
+    usize command_buffer_count = 0;
+    usize wait_semaphore_count = 0;
+    usize signal_semaphore_count = 1;
+    for (daxa_CommandSubmitInfo const & info : std::span{infos, info_count})
+    {
+        command_buffer_count += info.command_list_count;
+        wait_semaphore_count += info.wait_timeline_semaphore_count + info.wait_binary_semaphore_count;
+        signal_semaphore_count += info.signal_timeline_semaphore_count + info.signal_binary_semaphore_count;
+    }
+    queue.submit_command_buffer_infos.reserve(command_buffer_count);
+    queue.submit_wait_semaphore_infos.reserve(wait_semaphore_count);
+    queue.submit_signal_semaphore_infos.reserve(signal_semaphore_count);
+    queue.submit_infos.reserve(info_count);
+    for (usize info_index = 0; info_index < info_count; ++info_index)
+    {
+        daxa_CommandSubmitInfo const & info = infos[info_index];
+        usize const command_buffer_offset = queue.submit_command_buffer_infos.size();
+        usize const wait_semaphore_offset = queue.submit_wait_semaphore_infos.size();
+        usize const signal_semaphore_offset = queue.submit_signal_semaphore_infos.size();
+
+        for (auto const & commands : std::span{info.command_lists, info.command_list_count})
+        {
+            queue.submit_command_buffer_infos.push_back(VkCommandBufferSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                .pNext = nullptr,
+                .commandBuffer = commands->data.vk_cmd_buffer,
+                .deviceMask = {},
+            });
+        }
 
-    // used to synchronize with previous submits:
-    std::vector<VkSemaphore> submit_semaphore_waits = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<VkPipelineStageFlags> submit_semaphore_wait_stage_masks = {};
-    std::vector<u64> submit_semaphore_wait_values = {}; // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
+        if (info_index == info_count - 1)
+        {
+            // Add queue timeline signaling as first timeline semaphore signaling:
+            queue.submit_signal_semaphore_infos.push_back(make_semaphore_submit_info(queue.gpu_queue_local_timeline, current_timeline_value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT));
+        }
+        for (auto const & pair : std::span{info.signal_timeline_semaphores, info.signal_timeline_semaphore_count})
+        {
+            queue.submit_signal_semaphore_infos.push_back(make_semaphore_submit_info(pair.semaphore->vk_semaphore, pair.value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT));
+        }
+        for (auto const & binary_semaphore : std::span{info.signal_binary_semaphores, info.signal_binary_semaphore_count})
+        {
+            queue.submit_signal_semaphore_infos.push_back(make_semaphore_submit_info(binary_semaphore->vk_semaphore, 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT));
+        }
 
-    for (auto const & pair : std::span{info->wait_timeline_semaphores, info->wait_timeline_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(pair.value);
-    }
+        // used to synchronize with previous submits:
+        VkPipelineStageFlags2 const default_wait_stages = info.wait_stages != 0 ? static_cast<VkPipelineStageFlags2>(info.wait_stages) : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        for (usize i = 0; i < info.wait_timeline_semaphore_count; ++i)
+        {
+            auto const & pair = info.wait_timeline_semaphores[i];
+            VkPipelineStageFlags2 const stages = info.wait_timeline_semaphore_stage_count != 0 ? info.wait_timeline_semaphore_stages[i] : default_wait_stages;
+            queue.submit_wait_semaphore_infos.push_back(make_semaphore_submit_info(pair.semaphore->vk_semaphore, pair.value, stages));
+        }
+        for (usize i = 0; i < info.wait_binary_semaphore_count; ++i)
+        {
+            VkPipelineStageFlags2 const stages = info.wait_binary_semaphore_stage_count != 0 ? info.wait_binary_semaphore_stages[i] : default_wait_stages;
+            queue.submit_wait_semaphore_infos.push_back(make_semaphore_submit_info(info.wait_binary_semaphores[i]->vk_semaphore, 0, stages));
+        }
 
-    for (auto const & binary_semaphore : std::span{info->wait_binary_semaphores, info->wait_binary_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(0);
+        queue.submit_infos.push_back(VkSubmitInfo2{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .pNext = nullptr,
+            .flags = {},
+            .waitSemaphoreInfoCount = static_cast<u32>(queue.submit_wait_semaphore_infos.size() - wait_semaphore_offset),
+            .pWaitSemaphoreInfos = queue.submit_wait_semaphore_infos.data() + wait_semaphore_offset,
+            .commandBufferInfoCount = static_cast<u32>(queue.submit_command_buffer_infos.size() - command_buffer_offset),
+            .pCommandBufferInfos = queue.submit_command_buffer_infos.data() + command_buffer_offset,
+            .signalSemaphoreInfoCount = static_cast<u32>(queue.submit_signal_semaphore_infos.size() - signal_semaphore_offset),
+            .pSignalSemaphoreInfos = queue.submit_signal_semaphore_infos.data() + signal_semaphore_offset,
+        });
     }
 
-    VkTimelineSemaphoreSubmitInfo timeline_info{
-        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
-        .pNext = nullptr,
-        .waitSemaphoreValueCount = static_cast<u32>(submit_semaphore_wait_values.size()),
-        .pWaitSemaphoreValues = submit_semaphore_wait_values.data(),
-        .signalSemaphoreValueCount = static_cast<u32>(submit_semaphore_signal_values.size()),
-        .pSignalSemaphoreValues = submit_semaphore_signal_values.data(),
-    };
-
-    VkSubmitInfo const vk_submit_info{
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext = r_cast<void *>(&timeline_info),
-        .waitSemaphoreCount = static_cast<u32>(submit_semaphore_waits.size()),
-        .pWaitSemaphores = submit_semaphore_waits.data(),
-        .pWaitDstStageMask = submit_semaphore_wait_stage_masks.data(),
-        .commandBufferCount = static_cast<u32>(submit_vk_command_buffers.size()),
-        .pCommandBuffers = submit_vk_command_buffers.data(),
-        .signalSemaphoreCount = static_cast<u32>(submit_semaphore_signals.size()),
-        .pSignalSemaphores = submit_semaphore_signals.data(),
-    };
-    auto result = static_cast<daxa_Result>(vkQueueSubmit(queue.vk_queue, 1, &vk_submit_info, VK_NULL_HANDLE));
+    auto result = static_cast<daxa_Result>(vkQueueSubmit2(queue.vk_queue, static_cast<u32>(queue.submit_infos.size()), queue.submit_infos.data(), VK_NULL_HANDLE));
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    std::unique_lock const lock{self->zombies_mtx};
-
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -1195,9 +1483,11 @@ auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_R
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE)
     }
-    // used to synchronize with previous submits:
-    std::vector<VkSemaphore> submit_semaphore_waits = {};
+    daxa_ImplDevice::ImplQueue & queue = self->get_queue(info->queue);
 
+    // used to synchronize with previous submits:
+    auto & submit_semaphore_waits = queue.present_wait_semaphores;
+    submit_semaphore_waits.clear();
     for (auto const & binary_semaphore : std::span{info->wait_binary_semaphores, info->wait_binary_semaphore_count})
     {
         submit_semaphore_waits.push_back(binary_semaphore->vk_semaphore);
@@ -1214,7 +1504,7 @@ auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_R
         .pResults = {},
     };
 
-    auto result = static_cast<daxa_Result>(vkQueuePresentKHR(self->get_queue(info->queue).vk_queue, &present_info));
+    auto result = static_cast<daxa_Result>(vkQueuePresentKHR(queue.vk_queue, &present_info));
     _DAXA_RETURN_IF_ERROR(result, result)
 
     return std::bit_cast<daxa_Result>(result);
@@ -1222,25 +1512,371 @@ auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_R
 
 auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
 {
-    std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
-    std::unique_lock lock{self->zombies_mtx};
+    if ((self->info.flags & DeviceInfoFlagBits::BACKGROUND_GARBAGE_COLLECTION) != DeviceInfoFlagBits::NONE)
+    {
+        self->wake_background_gc();
+        return DAXA_RESULT_SUCCESS;
+    }
+    bool finished = {};
+    return self->collect_garbage(std::numeric_limits<u64>::max(), finished);
+}
 
-    u64 min_pending_device_timeline_value_of_all_queues = std::numeric_limits<u64>::max();
-    for (auto & queue : self->queues)
+auto daxa_dvc_latest_submit_index(daxa_Device self) -> u64
+{
+    return self->global_submit_timeline.load(std::memory_order::relaxed);
+}
+
+auto daxa_dvc_oldest_pending_submit_index(daxa_Device self, u64 * out_index) -> daxa_Result
+{
+    return self->oldest_pending_submit_index(*out_index);
+}
+
+namespace
+{
+    // Prefix of serialized pipeline cache data.
+    // The driver validates its own cache header too, this header rejects data of other devices and drivers before it reaches the driver.
+    struct PipelineCacheDataHeader
+    {
+        static constexpr u32 MAGIC = 0x43505844; // "DXPC"
+        static constexpr u32 VERSION = 1;
+        u32 magic = MAGIC;
+        u32 version = VERSION;
+        u32 vendor_id = {};
+        u32 device_id = {};
+        u32 driver_version = {};
+        u8 pipeline_cache_uuid[VK_UUID_SIZE] = {};
+        u64 data_size = {};
+    };
+
+    auto make_pipeline_cache_data_header(daxa_Device self) -> PipelineCacheDataHeader
+    {
+        PipelineCacheDataHeader header = {};
+        header.vendor_id = self->properties.vendor_id;
+        header.device_id = self->properties.device_id;
+        header.driver_version = self->properties.driver_version;
+        std::memcpy(header.pipeline_cache_uuid, self->properties.pipeline_cache_uuid, VK_UUID_SIZE);
+        return header;
+    }
+} // namespace
+
+auto daxa_dvc_get_pipeline_cache_data(daxa_Device self, u64 * out_size, void * out_data) -> daxa_Result
+{
+    // Reading the cache must not overlap a merge into it, pipeline creations only read it too.
+    std::shared_lock const lock{self->pipeline_cache_mtx};
+    usize vk_data_size = {};
+    auto result = static_cast<daxa_Result>(vkGetPipelineCacheData(self->vk_device, self->vk_pipeline_cache, &vk_data_size, nullptr));
+    _DAXA_RETURN_IF_ERROR(result, result)
+    if (out_data == nullptr)
+    {
+        *out_size = sizeof(PipelineCacheDataHeader) + vk_data_size;
+        return DAXA_RESULT_SUCCESS;
+    }
+    // Incomplete and incompatible data are expected results, they are returned without the error break.
+    if (*out_size < sizeof(PipelineCacheDataHeader))
+    {
+        return DAXA_RESULT_INCOMPLETE;
+    }
+    // The cache may have grown since the size query, the driver then writes as much complete data as fits and returns incomplete.
+    vk_data_size = static_cast<usize>(*out_size - sizeof(PipelineCacheDataHeader));
+    result = static_cast<daxa_Result>(vkGetPipelineCacheData(self->vk_device, self->vk_pipeline_cache, &vk_data_size, r_cast<u8 *>(out_data) + sizeof(PipelineCacheDataHeader)));
+    if (result != DAXA_RESULT_SUCCESS && result != DAXA_RESULT_INCOMPLETE)
+    {
+        _DAXA_RETURN_IF_ERROR(result, result);
+    }
+    PipelineCacheDataHeader header = make_pipeline_cache_data_header(self);
+    header.data_size = vk_data_size;
+    std::memcpy(out_data, &header, sizeof(PipelineCacheDataHeader));
+    *out_size = sizeof(PipelineCacheDataHeader) + vk_data_size;
+    return result;
+}
+
+auto daxa_dvc_load_pipeline_cache_data(daxa_Device self, void const * data, u64 size) -> daxa_Result
+{
+    if (size < sizeof(PipelineCacheDataHeader))
+    {
+        return DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA;
+    }
+    PipelineCacheDataHeader header = {};
+    std::memcpy(&header, data, sizeof(PipelineCacheDataHeader));
+    PipelineCacheDataHeader const expected_header = make_pipeline_cache_data_header(self);
+    bool const compatible =
+        header.magic == expected_header.magic &&
+        header.version == expected_header.version &&
+        header.vendor_id == expected_header.vendor_id &&
+        header.device_id == expected_header.device_id &&
+        header.driver_version == expected_header.driver_version &&
+        std::memcmp(header.pipeline_cache_uuid, expected_header.pipeline_cache_uuid, VK_UUID_SIZE) == 0 &&
+        header.data_size <= size - sizeof(PipelineCacheDataHeader);
+    if (!compatible)
+    {
+        return DAXA_RESULT_ERROR_INCOMPATIBLE_PIPELINE_CACHE_DATA;
+    }
+    VkPipelineCacheCreateInfo const vk_pipeline_cache_create_info{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .initialDataSize = static_cast<usize>(header.data_size),
+        .pInitialData = r_cast<u8 const *>(data) + sizeof(PipelineCacheDataHeader),
+    };
+    VkPipelineCache vk_loaded_pipeline_cache = {};
+    auto result = static_cast<daxa_Result>(vkCreatePipelineCache(self->vk_device, &vk_pipeline_cache_create_info, nullptr, &vk_loaded_pipeline_cache));
+    _DAXA_RETURN_IF_ERROR(result, result)
+    {
+        std::unique_lock const lock{self->pipeline_cache_mtx};
+        result = static_cast<daxa_Result>(vkMergePipelineCaches(self->vk_device, self->vk_pipeline_cache, 1, &vk_loaded_pipeline_cache));
+    }
+    vkDestroyPipelineCache(self->vk_device, vk_loaded_pipeline_cache, nullptr);
+    return result;
+}
+
+auto daxa_dvc_memory_report(daxa_Device self, daxa_MemoryReport * out_report, daxa_MemoryReportAllocation * out_largest_allocations, u32 largest_allocation_capacity) -> daxa_Result
+{
+    *out_report = {};
+    out_report->memory_budget_enabled = static_cast<daxa_Bool8>(self->memory_budget_enabled);
+
+    VkPhysicalDeviceMemoryProperties const * vk_memory_properties = {};
+    vmaGetMemoryProperties(self->vma_allocator, &vk_memory_properties);
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> vma_budgets = {};
+    vmaGetHeapBudgets(self->vma_allocator, vma_budgets.data());
+    out_report->heap_count = std::min(vk_memory_properties->memoryHeapCount, DAXA_MAX_MEMORY_HEAPS);
+    for (u32 heap = 0; heap < out_report->heap_count; ++heap)
+    {
+        out_report->heaps[heap] = daxa_MemoryHeapReport{
+            .budget = vma_budgets[heap].budget,
+            .usage = vma_budgets[heap].usage,
+            .block_bytes = vma_budgets[heap].statistics.blockBytes,
+            .allocation_bytes = vma_budgets[heap].statistics.allocationBytes,
+            .block_count = vma_budgets[heap].statistics.blockCount,
+            .allocation_count = vma_budgets[heap].statistics.allocationCount,
+            .flags = vk_memory_properties->memoryHeaps[heap].flags,
+        };
+    }
+
+    // The largest allocations are kept in a min heap, so the smallest one is replaced first.
+    std::vector<daxa_MemoryReportAllocation> largest_allocations = {};
+    largest_allocations.reserve(largest_allocation_capacity);
+    auto const larger = [](daxa_MemoryReportAllocation const & a, daxa_MemoryReportAllocation const & b)
+    { return a.byte_size > b.byte_size; };
+    auto const add_allocation = [&](daxa_MemoryTotals & totals, daxa_MemoryReportResourceType type, u64 byte_size, daxa_SmallString const & name)
+    {
+        totals.count += 1;
+        totals.byte_size += byte_size;
+        if (largest_allocation_capacity == 0)
+        {
+            return;
+        }
+        if (largest_allocations.size() < largest_allocation_capacity)
+        {
+            largest_allocations.push_back({.type = type, .byte_size = byte_size, .name = name});
+            std::push_heap(largest_allocations.begin(), largest_allocations.end(), larger);
+        }
+        else if (byte_size > largest_allocations.front().byte_size)
+        {
+            std::pop_heap(largest_allocations.begin(), largest_allocations.end(), larger);
+            largest_allocations.back() = {.type = type, .byte_size = byte_size, .name = name};
+            std::push_heap(largest_allocations.begin(), largest_allocations.end(), larger);
+        }
+    };
+    auto const allocation_size = [&](VmaAllocation allocation) -> u64
+    {
+        VmaAllocationInfo vma_allocation_info = {};
+        vmaGetAllocationInfo(self->vma_allocator, allocation, &vma_allocation_info);
+        return vma_allocation_info.size;
+    };
+
+    {
+        // Prevents the garbage collector from destroying slots while they are inspected.
+        // Only fully created slots are visited, resources created in parallel may be missed, the report is a snapshot.
+        std::shared_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+
+        // Buffers created by acceleration structures are reported as part of the acceleration structure.
+        std::unordered_set<VkBuffer> acceleration_structure_buffers = {};
+        self->gpu_sro_table.tlas_slots.for_each_published_slot(
+            [&](ImplTlasSlot const & slot, ImplTlasColdSlot const & cold_slot)
+            {
+                // Acceleration structures placed in a user buffer are already counted with that buffer.
+                if (slot.vk_acceleration_structure == VK_NULL_HANDLE || !cold_slot.owns_buffer)
+                {
+                    return;
+                }
+                acceleration_structure_buffers.insert(cold_slot.vk_buffer);
+                add_allocation(out_report->tlas, DAXA_MEMORY_REPORT_RESOURCE_TYPE_TLAS, cold_slot.info.size, cold_slot.info.name);
+            });
+        self->gpu_sro_table.blas_slots.for_each_published_slot(
+            [&](ImplBlasSlot const & slot, ImplBlasColdSlot const & cold_slot)
+            {
+                // Acceleration structures placed in a user buffer are already counted with that buffer.
+                if (slot.vk_acceleration_structure == VK_NULL_HANDLE || !cold_slot.owns_buffer)
+                {
+                    return;
+                }
+                acceleration_structure_buffers.insert(cold_slot.vk_buffer);
+                add_allocation(out_report->blas, DAXA_MEMORY_REPORT_RESOURCE_TYPE_BLAS, cold_slot.info.size, cold_slot.info.name);
+            });
+        self->gpu_sro_table.buffer_slots.for_each_published_slot(
+            [&](ImplBufferSlot const & slot, ImplBufferColdSlot const & cold_slot)
+            {
+                if (slot.vk_buffer == VK_NULL_HANDLE || acceleration_structure_buffers.contains(slot.vk_buffer))
+                {
+                    return;
+                }
+                u64 const byte_size = cold_slot.vma_allocation != nullptr ? allocation_size(cold_slot.vma_allocation) : cold_slot.info.size;
+                add_allocation(out_report->buffers, DAXA_MEMORY_REPORT_RESOURCE_TYPE_BUFFER, byte_size, cold_slot.info.name);
+            });
+        self->gpu_sro_table.image_slots.for_each_published_slot(
+            [&](ImplImageSlot const & slot, ImplImageColdSlot const & cold_slot)
+            {
+                // Image views own no memory and swapchain images are owned by the presentation engine.
+                if (slot.vk_image == VK_NULL_HANDLE || cold_slot.swapchain_image_index != NOT_OWNED_BY_SWAPCHAIN)
+                {
+                    return;
+                }
+                u64 byte_size = {};
+                if (cold_slot.vma_allocation != nullptr)
+                {
+                    byte_size = allocation_size(cold_slot.vma_allocation);
+                }
+                else
+                {
+                    VkMemoryRequirements vk_memory_requirements = {};
+                    vkGetImageMemoryRequirements(self->vk_device, slot.vk_image, &vk_memory_requirements);
+                    byte_size = vk_memory_requirements.size;
+                }
+                add_allocation(out_report->images, DAXA_MEMORY_REPORT_RESOURCE_TYPE_IMAGE, byte_size, cold_slot.info.name);
+            });
+    }
+
+    {
+        std::unique_lock const lock{self->live_memory_blocks_mtx};
+        for (daxa_ImplMemoryBlock const * memory_block : self->live_memory_blocks)
+        {
+            u64 const byte_size = memory_block->alloc_info.size;
+            add_allocation(out_report->memory_blocks, DAXA_MEMORY_REPORT_RESOURCE_TYPE_MEMORY_BLOCK, byte_size, std::bit_cast<daxa_SmallString>(memory_block->info.name));
+            if ((memory_block->info.flags.data & DAXA_MEMORY_FLAG_CAN_ALIAS) != 0)
+            {
+                out_report->aliased_memory_blocks.count += 1;
+                out_report->aliased_memory_blocks.byte_size += byte_size;
+            }
+        }
+    }
+
+    // Sorting the min heap by the larger predicate yields descending sizes.
+    std::sort_heap(largest_allocations.begin(), largest_allocations.end(), larger);
+    out_report->largest_allocation_count = static_cast<u32>(largest_allocations.size());
+    if (!largest_allocations.empty())
+    {
+        std::memcpy(out_largest_allocations, largest_allocations.data(), largest_allocations.size() * sizeof(daxa_MemoryReportAllocation));
+    }
+    return DAXA_RESULT_SUCCESS;
+}
+
+auto daxa_dvc_properties(daxa_Device device) -> daxa_DeviceProperties const *
+{
+    return &device->properties;
+}
+
+auto daxa_dvc_inc_refcnt(daxa_Device self) -> u64
+{
+    _DAXA_TEST_PRINT("device inc refcnt from %u to %u\n", self->strong_count, self->strong_count + 1);
+    return self->inc_refcnt();
+}
+
+auto daxa_dvc_dec_refcnt(daxa_Device self) -> u64
+{
+    _DAXA_TEST_PRINT("device dec refcnt from %u to %u\n", self->strong_count, self->strong_count - 1);
+    return self->dec_refcnt(
+        &daxa_ImplDevice::zero_ref_callback,
+        self->instance);
+}
+
+// --- End API Functions ---
+
+// --- Begin Internal Functions ---
+
+auto daxa_ImplDevice::oldest_pending_submit_index(u64 & out_index) -> daxa_Result
+{
+    out_index = std::numeric_limits<u64>::max();
+    for (auto & queue : this->queues)
     {
         std::optional<u64> latest_pending_submit = {};
-        auto result = queue.get_oldest_pending_submit(self->vk_device, latest_pending_submit);
+        auto result = queue.get_oldest_pending_submit(this->vk_device, latest_pending_submit);
         _DAXA_RETURN_IF_ERROR(result, result)
 
         if (latest_pending_submit.has_value())
         {
-            min_pending_device_timeline_value_of_all_queues = std::min(min_pending_device_timeline_value_of_all_queues, latest_pending_submit.value());
+            out_index = std::min(out_index, latest_pending_submit.value());
         }
     }
+    return DAXA_RESULT_SUCCESS;
+}
+
+auto daxa_ImplDevice::collect_garbage(u64 max_cleanups, bool & out_finished) -> daxa_Result
+{
+    auto self = this;
+    std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+    std::unique_lock lock{self->zombies_mtx};
+    out_finished = false;
+
+    u64 min_pending_device_timeline_value_of_all_queues = {};
+    auto result = self->oldest_pending_submit_index(min_pending_device_timeline_value_of_all_queues);
+    _DAXA_RETURN_IF_ERROR(result, result)
+
+    // The null descriptors of all collected resources are flushed before any of their handles is destroyed,
+    // so the descriptor set never references a destroyed handle.
+    // This visits the same zombies as the cleanups below, as the resource zombies are cleaned up first.
+    u64 null_writes_left = max_cleanups;
+    auto write_null_descriptors = [&](auto const & zombies, auto const & write_fn)
+    {
+        for (auto iter = zombies.rbegin(); iter != zombies.rend() && null_writes_left > 0; ++iter)
+        {
+            auto const & [timeline_value, id] = *iter;
+            if (timeline_value >= min_pending_device_timeline_value_of_all_queues)
+            {
+                break;
+            }
+            write_fn(static_cast<u32>(std::bit_cast<GPUResourceId>(id).index), id);
+            --null_writes_left;
+        }
+    };
+    auto & descriptor_writes = self->gpu_sro_table.descriptor_writes;
+    write_null_descriptors(
+        self->buffer_zombies,
+        [&](u32 index, BufferId)
+        {
+            descriptor_writes.write_buffer(self->vk_null_buffer, 0, VK_WHOLE_SIZE, index);
+        });
+    write_null_descriptors(
+        self->image_view_zombies,
+        [&](u32 index, ImageViewId)
+        {
+            descriptor_writes.write_image(self->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, index);
+        });
+    write_null_descriptors(
+        self->image_zombies,
+        [&](u32 index, ImageId id)
+        {
+            auto const usage = std::bit_cast<ImageUsageFlags>(self->gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<GPUResourceId>(id)).info.usage);
+            descriptor_writes.write_image(self->vk_null_image_view, usage, index);
+        });
+    write_null_descriptors(
+        self->sampler_zombies,
+        [&](u32 index, SamplerId)
+        {
+            descriptor_writes.write_sampler(self->vk_null_sampler, index);
+        });
+    write_null_descriptors(
+        self->tlas_zombies,
+        [&](u32 index, TlasId)
+        {
+            // TODO(Raytracing): Add null acceleration structure.
+            descriptor_writes.discard_acceleration_structure(index);
+        });
+    descriptor_writes.flush(self->vk_device, self->gpu_sro_table.vk_descriptor_set);
 
+    u64 cleanups_left = max_cleanups;
     auto check_and_cleanup_gpu_resources = [&](auto & zombies, auto const & cleanup_fn)
     {
-        while (!zombies.empty())
+        while (!zombies.empty() && cleanups_left > 0)
         {
             auto & [timeline_value, object] = zombies.back();
 
@@ -1251,6 +1887,7 @@ auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
 
             cleanup_fn(object);
             zombies.pop_back();
+            --cleanups_left;
         }
     };
     check_and_cleanup_gpu_resources(
@@ -1323,7 +1960,7 @@ auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
         std::unique_lock const main_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_MAIN].mtx};
         std::unique_lock const compute_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_COMPUTE].mtx};
         std::unique_lock const transfer_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_TRANSFER].mtx};
-        while (!self->command_list_zombies.empty())
+        while (!self->command_list_zombies.empty() && cleanups_left > 0)
         {
             auto & [timeline_value, zombie] = self->command_list_zombies.back();
 
@@ -1339,33 +1976,141 @@ auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
 
             self->command_pool_pools[zombie.queue_family].put_back(zombie.vk_cmd_pool);
             self->command_list_zombies.pop_back();
+            --cleanups_left;
         }
     }
+    // Running out of budget exactly on the last ready zombie reports unfinished, costing at most one extra empty pass.
+    out_finished = cleanups_left > 0;
     return DAXA_RESULT_SUCCESS;
 }
 
-auto daxa_dvc_properties(daxa_Device device) -> daxa_DeviceProperties const *
+void daxa_ImplDevice::background_gc_thread_main()
 {
-    return &device->properties;
-}
+    // Bounds the time spent in vkWaitSemaphores, so that the thread notices a stop request in time.
+    static constexpr u64 TIMELINE_WAIT_TIMEOUT_NS = 4'000'000;
 
-auto daxa_dvc_inc_refcnt(daxa_Device self) -> u64
-{
-    _DAXA_TEST_PRINT("device inc refcnt from %u to %u\n", self->strong_count, self->strong_count + 1);
-    return self->inc_refcnt();
+    auto should_stop = [&]()
+    {
+        std::unique_lock lock{this->background_gc_mtx};
+        return this->background_gc_stop;
+    };
+
+    while (true)
+    {
+        // Sleeps until a zombie is created or collect_garbage is called, an idle device never takes the lifetime lock.
+        {
+            std::unique_lock lock{this->background_gc_mtx};
+            this->background_gc_cv.wait(lock, [&]
+                                        { return this->background_gc_stop || this->background_gc_requested; });
+            if (this->background_gc_stop)
+            {
+                return;
+            }
+            this->background_gc_requested = false;
+        }
+
+        while (true)
+        {
+            bool finished = false;
+            while (!finished)
+            {
+                if (should_stop())
+                {
+                    return;
+                }
+                auto result = this->collect_garbage(BACKGROUND_GC_BATCH_SIZE, finished);
+                DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "background garbage collection failed");
+                if (result != DAXA_RESULT_SUCCESS)
+                {
+                    break;
+                }
+            }
+            if (!this->has_zombies())
+            {
+                break;
+            }
+
+            // The remaining zombies are still used by pending submits.
+            // Wait for any queue to retire its oldest pending submit, as that is the only event that makes more zombies collectable.
+            std::array<VkSemaphore, std::tuple_size_v<decltype(this->queues)>> wait_semaphores = {};
+            std::array<u64, std::tuple_size_v<decltype(this->queues)>> wait_values = {};
+            u32 wait_count = 0;
+            for (auto & queue : this->queues)
+            {
+                std::optional<u64> oldest_pending_submit = {};
+                auto result = queue.get_oldest_pending_submit(this->vk_device, oldest_pending_submit);
+                if (result == DAXA_RESULT_SUCCESS && oldest_pending_submit.has_value())
+                {
+                    wait_semaphores[wait_count] = queue.gpu_queue_local_timeline;
+                    wait_values[wait_count] = oldest_pending_submit.value() + 1;
+                    ++wait_count;
+                }
+            }
+            if (wait_count == 0)
+            {
+                // Nothing to wait on, the next zombify or collect_garbage call wakes the thread again.
+                break;
+            }
+            VkSemaphoreWaitInfo const wait_info{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                .pNext = {},
+                .flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+                .semaphoreCount = wait_count,
+                .pSemaphores = wait_semaphores.data(),
+                .pValues = wait_values.data(),
+            };
+            [[maybe_unused]] auto result = vkWaitSemaphores(this->vk_device, &wait_info, TIMELINE_WAIT_TIMEOUT_NS);
+        }
+    }
 }
 
-auto daxa_dvc_dec_refcnt(daxa_Device self) -> u64
+void daxa_ImplDevice::wake_background_gc()
 {
-    _DAXA_TEST_PRINT("device dec refcnt from %u to %u\n", self->strong_count, self->strong_count - 1);
-    return self->dec_refcnt(
-        &daxa_ImplDevice::zero_ref_callback,
-        self->instance);
+    if ((this->info.flags & DeviceInfoFlagBits::BACKGROUND_GARBAGE_COLLECTION) == DeviceInfoFlagBits::NONE)
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{this->background_gc_mtx};
+        if (this->background_gc_requested)
+        {
+            return;
+        }
+        this->background_gc_requested = true;
+    }
+    this->background_gc_cv.notify_one();
 }
 
-// --- End API Functions ---
+auto daxa_ImplDevice::has_zombies() -> bool
+{
+    std::unique_lock const lock{this->zombies_mtx};
+    return !this->buffer_zombies.empty() ||
+           !this->image_zombies.empty() ||
+           !this->image_view_zombies.empty() ||
+           !this->sampler_zombies.empty() ||
+           !this->tlas_zombies.empty() ||
+           !this->blas_zombies.empty() ||
+           !this->pipeline_zombies.empty() ||
+           !this->semaphore_zombies.empty() ||
+           !this->split_barrier_zombies.empty() ||
+           !this->timeline_query_pool_zombies.empty() ||
+           !this->memory_block_zombies.empty() ||
+           !this->command_list_zombies.empty();
+}
 
-// --- Begin Internal Functions ---
+void daxa_ImplDevice::stop_background_gc()
+{
+    if (!this->background_gc_thread.joinable())
+    {
+        return;
+    }
+    {
+        std::unique_lock lock{this->background_gc_mtx};
+        this->background_gc_stop = true;
+    }
+    this->background_gc_cv.notify_one();
+    this->background_gc_thread.join();
+}
 
 auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const & info, ImplPhysicalDevice const & physical_device, daxa_DeviceProperties const & properties, daxa_Device out_device) -> daxa_Result
 {
@@ -1646,8 +2391,15 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
 #endif
     };
 
+    self->memory_budget_enabled = physical_device.extensions.extensions_present[PhysicalDeviceExtensionsStruct::physical_device_memory_budget_ext];
+    VmaAllocatorCreateFlags vma_allocator_flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    if (self->memory_budget_enabled)
+    {
+        vma_allocator_flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
+
     VmaAllocatorCreateInfo const vma_allocator_create_info{
-        .flags = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT,
+        .flags = vma_allocator_flags,
         .physicalDevice = self->vk_physical_device,
         .device = self->vk_device,
         .preferredLargeHeapBlockSize = 0, // Sets it to lib internal default (256MiB).
@@ -1692,9 +2444,26 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
             {
                 vmaDestroyBuffer(self->vma_allocator, self->buffer_device_address_buffer, self->buffer_device_address_buffer_allocation);
             }
+            if (self->vk_pipeline_cache)
+            {
+                vkDestroyPipelineCache(self->vk_device, self->vk_pipeline_cache, nullptr);
+            }
         }
     };
 
+    // Create the pipeline cache, it starts empty and is filled by pipeline creations and daxa_dvc_load_pipeline_cache_data.
+    {
+        VkPipelineCacheCreateInfo const vk_pipeline_cache_create_info{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .initialDataSize = 0,
+            .pInitialData = nullptr,
+        };
+        result = static_cast<daxa_Result>(vkCreatePipelineCache(self->vk_device, &vk_pipeline_cache_create_info, nullptr, &self->vk_pipeline_cache));
+        _DAXA_RETURN_IF_ERROR(result, result)
+    }
+
     // Create null resources:
     {
         auto buffer_data = std::array<u8, 4>{0xff, 0x00, 0xff, 0xff};
@@ -2018,6 +2787,12 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
     result = static_cast<daxa_Result>(vkDeviceWaitIdle(self->vk_device));
     _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_SUBMIT_DEVICE_INIT_COMMANDS)
 
+    if ((self->info.flags & DeviceInfoFlagBits::BACKGROUND_GARBAGE_COLLECTION) != DeviceInfoFlagBits::NONE)
+    {
+        self->background_gc_thread = std::thread{[self]()
+                                                 { self->background_gc_thread_main(); }};
+    }
+
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -2040,7 +2815,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        auto & image_info = this->slot(id).info;
+        auto & image_info = this->cold_slot(id).info;
         return daxa_ImageMipArraySlice{
             .base_mip_level = 0,
             .level_count = image_info.mip_level_count,
@@ -2058,7 +2833,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        return this->slot(id).info.slice;
+        return this->cold_slot(id).info.slice;
     }
     else
     {
@@ -2072,7 +2847,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
 
     auto slot_opt = this->gpu_sro_table.image_slots.try_create_slot();
     DAXA_DBG_ASSERT_TRUE_M(slot_opt.has_value(), "CRITICAL INTERNAL ERROR, EXCEEDED MAX IMAGES IN SWAPCHAIN CREATION");
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -2082,7 +2857,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     };
 
     ret.vk_image = swapchain_image;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(image_info.dimensions - 1),
         .format = image_info.format,
         .image = {id},
@@ -2117,10 +2892,10 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
             .layerCount = 1,
         },
     };
-    ret.swapchain_image_index = static_cast<i32>(index);
+    ret_cold.swapchain_image_index = static_cast<i32>(index);
 
-    ret.info = *r_cast<daxa_ImageInfo const *>(&image_info);
-    result = static_cast<daxa_Result>(vkCreateImageView(vk_device, &view_ci, nullptr, &ret.view_slot.vk_image_view));
+    ret_cold.info = *r_cast<daxa_ImageInfo const *>(&image_info);
+    result = static_cast<daxa_Result>(vkCreateImageView(vk_device, &view_ci, nullptr, &ret.vk_image_view));
     _DAXA_RETURN_IF_ERROR(result, result)
 
     if ((this->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && !image_info.name.empty())
@@ -2139,18 +2914,15 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
             .objectType = VK_OBJECT_TYPE_IMAGE_VIEW,
-            .objectHandle = std::bit_cast<uint64_t>(ret.view_slot.vk_image_view),
+            .objectHandle = std::bit_cast<uint64_t>(ret.vk_image_view),
             .pObjectName = c_str_arr.data(),
         };
         this->vkSetDebugUtilsObjectNameEXT(this->vk_device, &swapchain_image_view_name_info);
     }
 
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, ret.view_slot.vk_image_view, usage, id.index);
-    }
+    this->gpu_sro_table.descriptor_writes.write_image(ret.vk_image_view, usage, static_cast<u32>(id.index));
 
+    this->gpu_sro_table.image_slots.publish_slot(id);
     *out = ImageId{id};
 
     return result;
@@ -2160,19 +2932,15 @@ void daxa_ImplDevice::cleanup_buffer(BufferId id)
 {
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplBufferSlot const & buffer_slot = this->gpu_sro_table.buffer_slots.unsafe_get(gid);
+    ImplBufferColdSlot const & buffer_cold_slot = this->gpu_sro_table.buffer_slots.unsafe_get_cold(gid);
     this->buffer_device_address_buffer_host_ptr[gid.index] = 0;
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_buffer(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_buffer, 0, VK_WHOLE_SIZE, gid.index);
-    }
-    if (buffer_slot.opt_memory_block != nullptr)
+    if (buffer_cold_slot.opt_memory_block != nullptr)
     {
         vkDestroyBuffer(this->vk_device, buffer_slot.vk_buffer, {});
     }
     else
     {
-        vmaDestroyBuffer(this->vma_allocator, buffer_slot.vk_buffer, buffer_slot.vma_allocation);
+        vmaDestroyBuffer(this->vma_allocator, buffer_slot.vk_buffer, buffer_cold_slot.vma_allocation);
     }
     gpu_sro_table.buffer_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2182,26 +2950,17 @@ void daxa_ImplDevice::cleanup_image(ImageId id)
     _DAXA_TEST_PRINT("cleanup image\n");
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplImageSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(gid);
+    ImplImageColdSlot const & image_cold_slot = gpu_sro_table.image_slots.unsafe_get_cold(gid);
+    vkDestroyImageView(vk_device, image_slot.vk_image_view, nullptr);
+    if (image_cold_slot.swapchain_image_index == NOT_OWNED_BY_SWAPCHAIN)
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(
-            this->vk_device,
-            this->gpu_sro_table.vk_descriptor_set,
-            this->vk_null_image_view,
-            std::bit_cast<ImageUsageFlags>(image_slot.info.usage),
-            gid.index);
-    }
-    vkDestroyImageView(vk_device, image_slot.view_slot.vk_image_view, nullptr);
-    if (image_slot.swapchain_image_index == NOT_OWNED_BY_SWAPCHAIN)
-    {
-        if (image_slot.opt_memory_block != nullptr)
+        if (image_cold_slot.opt_memory_block != nullptr)
         {
             vkDestroyImage(this->vk_device, image_slot.vk_image, {});
         }
         else
         {
-            vmaDestroyImage(this->vma_allocator, image_slot.vk_image, image_slot.vma_allocation);
+            vmaDestroyImage(this->vma_allocator, image_slot.vk_image, image_cold_slot.vma_allocation);
         }
     }
     gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
@@ -2210,12 +2969,7 @@ void daxa_ImplDevice::cleanup_image(ImageId id)
 void daxa_ImplDevice::cleanup_image_view(ImageViewId id)
 {
     DAXA_DBG_ASSERT_TRUE_M(gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).vk_image == VK_NULL_HANDLE, "can not destroy default image view of image");
-    ImplImageViewSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).view_slot;
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, std::bit_cast<daxa::ImageViewId>(id).index);
-    }
+    ImplImageSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
     vkDestroyImageView(vk_device, image_slot.vk_image_view, nullptr);
     gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2223,11 +2977,6 @@ void daxa_ImplDevice::cleanup_image_view(ImageViewId id)
 void daxa_ImplDevice::cleanup_sampler(SamplerId id)
 {
     ImplSamplerSlot const & sampler_slot = this->gpu_sro_table.sampler_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_sampler, std::bit_cast<GPUResourceId>(id).index);
-    }
     vkDestroySampler(this->vk_device, sampler_slot.vk_sampler, nullptr);
     gpu_sro_table.sampler_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2235,8 +2984,6 @@ void daxa_ImplDevice::cleanup_sampler(SamplerId id)
 void daxa_ImplDevice::cleanup_tlas(TlasId id)
 {
     ImplTlasSlot const & tlas_slot = this->gpu_sro_table.tlas_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    // TODO(Raytracing): Add null acceleration structure:
-    // write_descriptor_set_acceleration_structure(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_acceleration_structure, std::bit_cast<GPUResourceId>(id).index);
     this->vkDestroyAccelerationStructureKHR(this->vk_device, tlas_slot.vk_acceleration_structure, nullptr);
     gpu_sro_table.tlas_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
 }
@@ -2258,9 +3005,9 @@ auto daxa_ImplDevice::slot(daxa_ImageId id) const -> ImplImageSlot const &
     return gpu_sro_table.image_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id));
 }
 
-auto daxa_ImplDevice::slot(daxa_ImageViewId id) const -> ImplImageViewSlot const &
+auto daxa_ImplDevice::slot(daxa_ImageViewId id) const -> ImplImageSlot const &
 {
-    return gpu_sro_table.image_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id)).view_slot;
+    return gpu_sro_table.image_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id));
 }
 
 auto daxa_ImplDevice::slot(daxa_SamplerId id) const -> ImplSamplerSlot const &
@@ -2278,13 +3025,45 @@ auto daxa_ImplDevice::slot(daxa_BlasId id) const -> ImplBlasSlot const &
     return gpu_sro_table.blas_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id));
 }
 
+auto daxa_ImplDevice::cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &
+{
+    return gpu_sro_table.buffer_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id)).view_slot;
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &
+{
+    return gpu_sro_table.sampler_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &
+{
+    return gpu_sro_table.tlas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &
+{
+    return gpu_sro_table.blas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
 void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zero_ref_callback\n");
     auto self = rc_cast<daxa_Device>(handle);
+    self->stop_background_gc();
     auto result = daxa_dvc_wait_idle(self);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
-    result = daxa_dvc_collect_garbage(self);
+    bool gc_finished = {};
+    result = self->collect_garbage(std::numeric_limits<u64>::max(), gc_finished);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
     for (auto & pool_pool : self->command_pool_pools)
     {
@@ -2298,6 +3077,7 @@ void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
     vmaDestroyAllocator(self->vma_allocator);
     vkDestroySampler(self->vk_device, self->vk_null_sampler, nullptr);
     vkDestroyImageView(self->vk_device, self->vk_null_image_view, nullptr);
+    vkDestroyPipelineCache(self->vk_device, self->vk_pipeline_cache, nullptr);
     for (auto & queue : self->queues)
     {
         queue.cleanup(self->vk_device);
@@ -2310,66 +3090,131 @@ void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
 }
 
 template <typename T>
-void zombiefy(daxa_Device self, T id, auto & slots, auto & zombies)
+void zombiefy(daxa_Device self, std::span<T const> ids, auto & slots, auto & zombies)
 {
-    [[maybe_unused]] auto & slot = slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    if constexpr (std::is_same_v<T, BufferId> || std::is_same_v<T, ImageId>)
+    for (T const & id : ids)
     {
-        if (slot.opt_memory_block != nullptr)
+        [[maybe_unused]] auto & slot = slots.unsafe_get_cold(std::bit_cast<GPUResourceId>(id));
+        if constexpr (std::is_same_v<T, BufferId> || std::is_same_v<T, ImageId>)
         {
-            slot.opt_memory_block->dec_weak_refcnt(
-                daxa_ImplMemoryBlock::zero_ref_callback,
-                self->instance);
+            if (slot.opt_memory_block != nullptr)
+            {
+                slot.opt_memory_block->dec_weak_refcnt(
+                    daxa_ImplMemoryBlock::zero_ref_callback,
+                    self->instance);
+            }
         }
-    }
-    if constexpr (std::is_same_v<T, TlasId> || std::is_same_v<T, BlasId>)
-    {
-        if (slot.owns_buffer)
+        if constexpr (std::is_same_v<T, TlasId> || std::is_same_v<T, BlasId>)
         {
-            self->zombify_buffer(slot.buffer_id);
+            if (slot.owns_buffer)
+            {
+                self->zombify_buffer(slot.buffer_id);
+            }
         }
     }
     u64 const submit_timeline_value = self->global_submit_timeline.load(std::memory_order::relaxed);
     {
+        // Batches take the zombie lock only once.
         std::unique_lock const lock{self->zombies_mtx};
-        zombies.push_front(std::pair{submit_timeline_value, id});
+        for (T const & id : ids)
+        {
+            zombies.push_front(std::pair{submit_timeline_value, id});
+        }
     }
+    self->wake_background_gc();
 }
 
 void daxa_ImplDevice::zombify_buffer(BufferId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_buffer\n");
-    zombiefy(this, id, gpu_sro_table.buffer_slots, this->buffer_zombies);
+    zombiefy(this, std::span<BufferId const>{&id, 1}, gpu_sro_table.buffer_slots, this->buffer_zombies);
+}
+
+void daxa_ImplDevice::zombify_buffers(std::span<BufferId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_buffers\n");
+    zombiefy(this, ids, gpu_sro_table.buffer_slots, this->buffer_zombies);
 }
 
 void daxa_ImplDevice::zombify_image(ImageId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image (%i,%i)\n", id.index, id.version);
-    zombiefy(this, id, gpu_sro_table.image_slots, this->image_zombies);
+    this->evict_cached_image_views(std::span<ImageId const>{&id, 1});
+    zombiefy(this, std::span<ImageId const>{&id, 1}, gpu_sro_table.image_slots, this->image_zombies);
+}
+
+void daxa_ImplDevice::zombify_images(std::span<ImageId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_images\n");
+    this->evict_cached_image_views(ids);
+    zombiefy(this, ids, gpu_sro_table.image_slots, this->image_zombies);
+}
+
+void daxa_ImplDevice::evict_cached_image_views(std::span<ImageId const> ids)
+{
+    std::vector<ImageViewId> evicted_views = {};
+    {
+        std::unique_lock const cache_lock{this->image_view_cache_mtx};
+        if (this->cached_image_views_per_image.empty())
+        {
+            return;
+        }
+        for (ImageId const & id : ids)
+        {
+            auto iter = this->cached_image_views_per_image.find(std::bit_cast<u64>(id));
+            if (iter == this->cached_image_views_per_image.end())
+            {
+                continue;
+            }
+            for (ImageViewCacheKey const & cache_key : iter->second)
+            {
+                auto const view_iter = this->image_view_cache.find(cache_key);
+                ImageViewId const view = view_iter->second;
+                this->image_view_cache.erase(view_iter);
+                // Views wrongly destroyed by the user are skipped, their slot may already be reused.
+                if (this->gpu_sro_table.image_slots.try_zombify(std::bit_cast<GPUResourceId>(view)))
+                {
+                    evicted_views.push_back(view);
+                }
+            }
+            this->cached_image_views_per_image.erase(iter);
+        }
+    }
+    // The views are zombified before their image, so they are also cleaned up first.
+    if (!evicted_views.empty())
+    {
+        this->zombify_image_views(evicted_views);
+    }
 }
 
 void daxa_ImplDevice::zombify_image_view(ImageViewId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image_view\n");
-    zombiefy(this, id, gpu_sro_table.image_slots, this->image_view_zombies);
+    zombiefy(this, std::span<ImageViewId const>{&id, 1}, gpu_sro_table.image_slots, this->image_view_zombies);
+}
+
+void daxa_ImplDevice::zombify_image_views(std::span<ImageViewId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image_views\n");
+    zombiefy(this, ids, gpu_sro_table.image_slots, this->image_view_zombies);
 }
 
 void daxa_ImplDevice::zombify_sampler(SamplerId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_sampler\n");
-    zombiefy(this, id, gpu_sro_table.sampler_slots, this->sampler_zombies);
+    zombiefy(this, std::span<SamplerId const>{&id, 1}, gpu_sro_table.sampler_slots, this->sampler_zombies);
 }
 
 void daxa_ImplDevice::zombify_tlas(TlasId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_tlas\n");
-    zombiefy(this, id, gpu_sro_table.tlas_slots, this->tlas_zombies);
+    zombiefy(this, std::span<TlasId const>{&id, 1}, gpu_sro_table.tlas_slots, this->tlas_zombies);
 }
 
 void daxa_ImplDevice::zombify_blas(BlasId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_blas\n");
-    zombiefy(this, id, gpu_sro_table.blas_slots, this->blas_zombies);
+    zombiefy(this, std::span<BlasId const>{&id, 1}, gpu_sro_table.blas_slots, this->blas_zombies);
 }
 
 // --- End Internal Functions ---
\ No newline at end of file
@@ -13,6 +13,11 @@
 #include <daxa/c/device.h>
 
 #include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace daxa;
 
@@ -23,10 +28,33 @@ struct SubmitZombie
 };
 
 static inline constexpr u64 MAX_PENDING_SUBMISSIONS_PER_QUEUE = 64;
+static inline constexpr u64 BACKGROUND_GC_BATCH_SIZE = 32;
 static inline constexpr u64 MAIN_QUEUE_INDEX = 0;
 static inline constexpr u64 FIRST_COMPUTE_QUEUE_IDX = 1;
 static inline constexpr u64 FIRST_TRANSFER_QUEUE_IDX = FIRST_COMPUTE_QUEUE_IDX + DAXA_MAX_COMPUTE_QUEUE_COUNT;
 
+// Hashes the bytes of padding free keys.
+struct CacheKeyHash
+{
+    template <typename T, usize N>
+    auto operator()(std::array<T, N> const & key) const -> usize
+    {
+        return std::hash<std::string_view>{}(std::string_view{r_cast<char const *>(key.data()), sizeof(T) * N});
+    }
+};
+
+// Every field of a daxa_SamplerInfo except the name, widened to 32 bit to exclude padding bytes.
+using SamplerCacheKey = std::array<u32, 16>;
+
+struct SamplerCacheEntry
+{
+    SamplerId id = {};
+    u64 refcount = {};
+};
+
+// Image id, type, format and slice of a daxa_ImageViewInfo, the name is ignored.
+using ImageViewCacheKey = std::array<u64, 4>;
+
 struct daxa_ImplDevice final : public ImplHandle
 {
     // General data:
@@ -37,6 +65,8 @@ struct daxa_ImplDevice final : public ImplHandle
     PhysicalDeviceFeaturesStruct physical_device_features = {};
     VkDevice vk_device = {};
     VmaAllocator vma_allocator = {};
+    // VK_EXT_memory_budget is enabled and used by vma for heap budgets.
+    bool memory_budget_enabled = {};
 
     // Dynamic State:
     PFN_vkCmdSetRasterizationSamplesEXT vkCmdSetRasterizationSamplesEXT = {};
@@ -80,6 +110,11 @@ struct daxa_ImplDevice final : public ImplHandle
     VmaAllocation vk_null_buffer_vma_allocation = {};
     VmaAllocation vk_null_image_vma_allocation = {};
 
+    // Pipeline cache used by all pipeline creations.
+    // Pipeline creation locks the mutex shared, merging loaded cache data requires exclusive access to the cache.
+    VkPipelineCache vk_pipeline_cache = {};
+    std::shared_mutex pipeline_cache_mtx = {};
+
     // Command Buffer/Pool recycling:
     // Index with daxa_QueueFamily.
     std::array<CommandPoolPool, 3> command_pool_pools = {};
@@ -107,6 +142,42 @@ struct daxa_ImplDevice final : public ImplHandle
     std::deque<std::pair<u64, TimelineQueryPoolZombie>> timeline_query_pool_zombies = {};
     std::deque<std::pair<u64, MemoryBlockZombie>> memory_block_zombies = {};
 
+    // Memory blocks are not stored in a resource pool, they are tracked here for memory reports.
+    std::mutex live_memory_blocks_mtx = {};
+    std::unordered_set<daxa_ImplMemoryBlock const *> live_memory_blocks = {};
+
+    // Sampler deduplication:
+    // Creating a sampler with the same info as a live sampler returns the live samplers id and increments its refcount.
+    // The sampler is only zombified once it was destroyed as often as it was created.
+    std::mutex sampler_cache_mtx = {};
+    std::unordered_map<SamplerCacheKey, SamplerCacheEntry, CacheKeyHash> sampler_cache = {};
+
+    // Image view cache:
+    // Views returned by daxa_dvc_cached_image_view are owned by the device and shared by all users.
+    // They are zombified together with their parent image, the second map tracks the cache keys of each image.
+    std::mutex image_view_cache_mtx = {};
+    std::unordered_map<ImageViewCacheKey, ImageViewId, CacheKeyHash> image_view_cache = {};
+    std::unordered_map<u64, std::vector<ImageViewCacheKey>> cached_image_views_per_image = {};
+
+    // Background garbage collection (DAXA_DEVICE_INFO_FLAG_BACKGROUND_GARBAGE_COLLECTION):
+    // The gc thread sleeps until a zombie is created or collect_garbage is called.
+    // It then waits on the queue timelines and reclaims zombies in batches of at most BACKGROUND_GC_BATCH_SIZE, until none are left.
+    // Between batches it drops the lifetime lock, so submits and command recorders are never stalled behind a long collection.
+    std::thread background_gc_thread = {};
+    std::mutex background_gc_mtx = {};
+    std::condition_variable background_gc_cv = {};
+    bool background_gc_stop = {};
+    bool background_gc_requested = {};
+    void background_gc_thread_main();
+    void stop_background_gc();
+    // Called after pushing a zombie, wakes the gc thread when background garbage collection is enabled.
+    void wake_background_gc();
+    auto has_zombies() -> bool;
+    // Collects at most max_cleanups zombies. out_finished is set when no more zombies are ready to be destroyed.
+    auto collect_garbage(u64 max_cleanups, bool & out_finished) -> daxa_Result;
+    // All submits with a submit index lower than out_index finished executing, max u64 when no submit is pending.
+    auto oldest_pending_submit_index(u64 & out_index) -> daxa_Result;
+
     // Queues
     struct ImplQueue
     {
@@ -118,6 +189,13 @@ struct daxa_ImplDevice final : public ImplHandle
         VkSemaphore gpu_queue_local_timeline = {};
         // atomically synchronized:
         std::atomic_uint64_t latest_pending_submit_timeline_value = {};
+        // Scratch memory reused by submits and presents to this queue, so that they do not allocate after warmup.
+        // Guarded by the external synchronization vulkan already requires for submitting to a VkQueue.
+        std::vector<VkCommandBufferSubmitInfo> submit_command_buffer_infos = {};
+        std::vector<VkSemaphoreSubmitInfo> submit_wait_semaphore_infos = {};
+        std::vector<VkSemaphoreSubmitInfo> submit_signal_semaphore_infos = {};
+        std::vector<VkSubmitInfo2> submit_infos = {};
+        std::vector<VkSemaphore> present_wait_semaphores = {};
 
         auto initialize(VkDevice vk_device, u32 queue_family_index, u32 queue_index) -> daxa_Result;
         void cleanup(VkDevice device);
@@ -156,11 +234,18 @@ struct daxa_ImplDevice final : public ImplHandle
 
     auto slot(daxa_BufferId id) const -> ImplBufferSlot const &;
     auto slot(daxa_ImageId id) const -> ImplImageSlot const &;
-    auto slot(daxa_ImageViewId id) const -> ImplImageViewSlot const &;
+    auto slot(daxa_ImageViewId id) const -> ImplImageSlot const &;
     auto slot(daxa_SamplerId id) const -> ImplSamplerSlot const &;
     auto slot(daxa_TlasId id) const -> ImplTlasSlot const &;
     auto slot(daxa_BlasId id) const -> ImplBlasSlot const &;
 
+    auto cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &;
+    auto cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &;
+    auto cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &;
+    auto cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &;
+    auto cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &;
+    auto cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &;
+
     void cleanup_buffer(BufferId id);
     void cleanup_image(ImageId id);
     void cleanup_image_view(ImageViewId id);
@@ -171,6 +256,11 @@ struct daxa_ImplDevice final : public ImplHandle
     void zombify_buffer(BufferId id);
     void zombify_image(ImageId id);
     void zombify_image_view(ImageViewId id);
+    void zombify_buffers(std::span<BufferId const> ids);
+    void zombify_images(std::span<ImageId const> ids);
+    // Zombifies the cached views of the images and removes them from the image view cache.
+    void evict_cached_image_views(std::span<ImageId const> ids);
+    void zombify_image_views(std::span<ImageViewId const> ids);
     void zombify_sampler(SamplerId id);
     void zombify_tlas(TlasId id);
     void zombify_blas(BlasId id);
@@ -58,6 +58,7 @@ namespace daxa
             physical_device_mesh_shader_ext,
             physical_device_ray_tracing_invocation_reorder_nv,
             physical_device_shader_atomic_float_ext,
+            physical_device_memory_budget_ext,
             // Used by DLSS
             physical_device_push_descriptor_khr,
             physical_device_binary_import_nvx,
@@ -80,6 +81,7 @@ namespace daxa
             VK_EXT_MESH_SHADER_EXTENSION_NAME,
             VK_NV_RAY_TRACING_INVOCATION_REORDER_EXTENSION_NAME,
             VK_EXT_SHADER_ATOMIC_FLOAT_EXTENSION_NAME,
+            VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
             // Used by DLSS
             VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
             VK_NVX_BINARY_IMPORT_EXTENSION_NAME,
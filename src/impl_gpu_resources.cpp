@@ -338,24 +338,25 @@ namespace daxa
             {
                 if (page)
                 {
-                    for (auto & slot : *page)
+                    for (usize i = 0; i < page->hot.size(); ++i)
                     {
+                        auto const & slot = page->hot[i];
                         bool handle_invalid = {};
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplBufferSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplBufferSlot>)
                         {
-                            handle_invalid = slot.first.vk_buffer == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_buffer == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplImageSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplImageSlot>)
                         {
-                            handle_invalid = slot.first.vk_image == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_image == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplSamplerSlot>)
+                        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(slot)>, ImplSamplerSlot>)
                         {
-                            handle_invalid = slot.first.vk_sampler == VK_NULL_HANDLE;
+                            handle_invalid = slot.vk_sampler == VK_NULL_HANDLE;
                         }
                         if (!handle_invalid)
                         {
-                            ret += fmt::format("debug name : \"{}\"", r_cast<SmallString const *>(&slot.first.info.name)->view());
+                            ret += fmt::format("debug name : \"{}\"", r_cast<SmallString const *>(&page->cold[i].info.name)->view());
                             ret += "\n";
                         }
                     }
@@ -363,9 +364,9 @@ namespace daxa
             }
             return ret;
         };
-        DAXA_DBG_ASSERT_TRUE_M(buffer_slots.free_index_stack.size() == buffer_slots.next_index, print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_M(image_slots.free_index_stack.size() == image_slots.next_index, print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_M(sampler_slots.free_index_stack.size() == sampler_slots.next_index, print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(buffer_slots.free_index_count() == buffer_slots.next_index.load(), print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(image_slots.free_index_count() == image_slots.next_index.load(), print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(sampler_slots.free_index_count() == sampler_slots.next_index.load(), print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots.pages));
         for (usize i = 0; i < PIPELINE_LAYOUT_COUNT; ++i)
         {
             vkDestroyPipelineLayout(device, pipeline_layouts.at(i), nullptr);
@@ -375,132 +376,158 @@ namespace daxa
         vkDestroyDescriptorPool(device, this->vk_descriptor_pool, nullptr);
     }
 
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index)
-    {
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = vk_sampler,
-            .imageView = VK_NULL_HANDLE,
-            .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set_storage{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+    static_assert(DescriptorWriteQueue::BINDING_COUNT == DAXA_ACCELERATION_STRUCTURE_BINDING + 1);
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set_storage, 0, nullptr);
+    void DescriptorWriteQueue::enqueue(PendingDescriptorWrite const & write)
+    {
+        std::unique_lock const lock{this->mtx};
+        auto & slot_indices = this->pending_index_of_slot[write.binding];
+        if (slot_indices.size() <= write.index)
+        {
+            slot_indices.resize(static_cast<usize>(write.index) + 1, 0);
+        }
+        if (slot_indices[write.index] != 0)
+        {
+            this->pending[slot_indices[write.index] - 1] = write;
+            return;
+        }
+        this->pending.push_back(write);
+        slot_indices[write.index] = static_cast<u32>(this->pending.size());
     }
 
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index)
+    void DescriptorWriteQueue::write_sampler(VkSampler vk_sampler, u32 index)
     {
-        VkDescriptorBufferInfo const vk_descriptor_image_info{
-            .buffer = vk_buffer,
-            .offset = offset,
-            .range = range,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_BUFFER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo = nullptr,
-            .pBufferInfo = &vk_descriptor_image_info,
-            .pTexelBufferView = nullptr,
-        };
-
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+        this->enqueue(PendingDescriptorWrite{
+            .binding = DAXA_SAMPLER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .image_info = {
+                .sampler = vk_sampler,
+                .imageView = VK_NULL_HANDLE,
+                .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            },
+        });
     }
 
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    void DescriptorWriteQueue::write_buffer(VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index)
     {
-        u32 descriptor_set_write_count = 0;
-        std::array<VkWriteDescriptorSet, 2> descriptor_set_writes = {};
-
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+        this->enqueue(PendingDescriptorWrite{
+            .binding = DAXA_STORAGE_BUFFER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .buffer_info = {
+                .buffer = vk_buffer,
+                .offset = offset,
+                .range = range,
+            },
+        });
+    }
 
+    void DescriptorWriteQueue::write_image(VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    {
         if ((usage & ImageUsageFlagBits::SHADER_STORAGE) != ImageUsageFlagBits::NONE)
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set;
+            this->enqueue(PendingDescriptorWrite{
+                .binding = DAXA_STORAGE_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .image_info = {
+                    .sampler = VK_NULL_HANDLE,
+                    .imageView = vk_image_view,
+                    .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+                },
+            });
         }
-
-        VkDescriptorImageInfo const vk_descriptor_image_info_sampled{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set_sampled{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLED_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info_sampled,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
-
         if ((usage & ImageUsageFlagBits::SHADER_SAMPLED) != ImageUsageFlagBits::NONE)
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set_sampled;
+            this->enqueue(PendingDescriptorWrite{
+                .binding = DAXA_SAMPLED_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                .image_info = {
+                    .sampler = VK_NULL_HANDLE,
+                    .imageView = vk_image_view,
+                    .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+                },
+            });
         }
-
-        vkUpdateDescriptorSets(vk_device, descriptor_set_write_count, descriptor_set_writes.data(), 0, nullptr);
     }
 
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index)
+    void DescriptorWriteQueue::write_acceleration_structure(VkAccelerationStructureKHR vk_acceleration_structure, u32 index)
     {
-        VkWriteDescriptorSetAccelerationStructureKHR vk_write_descriptor_set_as = {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
-            .pNext = nullptr,
-            .accelerationStructureCount = 1,
-            .pAccelerationStructures = &vk_acceleration_structure,
-        };
+        this->enqueue(PendingDescriptorWrite{
+            .binding = DAXA_ACCELERATION_STRUCTURE_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            .acceleration_structure = vk_acceleration_structure,
+        });
+    }
 
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = &vk_write_descriptor_set_as,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_ACCELERATION_STRUCTURE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
-            .pImageInfo = nullptr,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+    void DescriptorWriteQueue::discard_acceleration_structure(u32 index)
+    {
+        std::unique_lock const lock{this->mtx};
+        auto & slot_indices = this->pending_index_of_slot[DAXA_ACCELERATION_STRUCTURE_BINDING];
+        if (slot_indices.size() <= index || slot_indices[index] == 0)
+        {
+            return;
+        }
+        // The last pending write takes the place of the discarded one.
+        u32 const pending_index = slot_indices[index] - 1;
+        slot_indices[index] = 0;
+        if (pending_index + 1 != this->pending.size())
+        {
+            this->pending[pending_index] = this->pending.back();
+            this->pending_index_of_slot[this->pending[pending_index].binding][this->pending[pending_index].index] = pending_index + 1;
+        }
+        this->pending.pop_back();
+    }
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+    void DescriptorWriteQueue::flush(VkDevice vk_device, VkDescriptorSet vk_descriptor_set)
+    {
+        std::unique_lock const lock{this->mtx};
+        if (this->pending.empty())
+        {
+            return;
+        }
+        this->vk_writes.clear();
+        this->vk_as_writes.clear();
+        this->vk_writes.reserve(this->pending.size());
+        // Reserved up front, the writes point into this vector.
+        this->vk_as_writes.reserve(this->pending.size());
+        for (auto & write : this->pending)
+        {
+            void const * next = nullptr;
+            if (write.type == VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR)
+            {
+                next = &this->vk_as_writes.emplace_back(VkWriteDescriptorSetAccelerationStructureKHR{
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
+                    .pNext = nullptr,
+                    .accelerationStructureCount = 1,
+                    .pAccelerationStructures = &write.acceleration_structure,
+                });
+            }
+            bool const is_buffer = write.type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bool const is_image = !is_buffer && write.type != VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            this->vk_writes.push_back(VkWriteDescriptorSet{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = next,
+                .dstSet = vk_descriptor_set,
+                .dstBinding = write.binding,
+                .dstArrayElement = write.index,
+                .descriptorCount = 1,
+                .descriptorType = write.type,
+                .pImageInfo = is_image ? &write.image_info : nullptr,
+                .pBufferInfo = is_buffer ? &write.buffer_info : nullptr,
+                .pTexelBufferView = nullptr,
+            });
+        }
+        // Does not need external sync given we use update after bind.
+        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        vkUpdateDescriptorSets(vk_device, static_cast<u32>(this->vk_writes.size()), this->vk_writes.data(), 0, nullptr);
+        for (auto const & write : this->pending)
+        {
+            this->pending_index_of_slot[write.binding][write.index] = 0;
+        }
+        this->pending.clear();
     }
 } // namespace daxa
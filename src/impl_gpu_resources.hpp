@@ -4,64 +4,93 @@
 
 #include <daxa/gpu_resources.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace daxa
 {
+    // Resource slots are split into hot and cold data.
+    // Hot data is read for every command that references the resource (vk handles, addresses, aspect).
+    // Cold data is only needed on creation, destruction and info queries.
+
     struct ImplBufferSlot
     {
-        daxa_BufferInfo info = {};
         VkBuffer vk_buffer = {};
-        VmaAllocation vma_allocation = {};
-        daxa_MemoryBlock opt_memory_block = {};
         VkDeviceAddress device_address = {};
         void * host_address = {};
     };
 
+    struct ImplBufferColdSlot
+    {
+        daxa_BufferInfo info = {};
+        VmaAllocation vma_allocation = {};
+        daxa_MemoryBlock opt_memory_block = {};
+    };
+
     static inline constexpr i32 NOT_OWNED_BY_SWAPCHAIN = -1;
 
-    struct ImplImageViewSlot
+    // Image views share the image pool. For image views, vk_image is always VK_NULL_HANDLE.
+    struct ImplImageSlot
     {
-        daxa_ImageViewInfo info = {};
+        VkImage vk_image = {};
         VkImageView vk_image_view = {};
+        VkImageAspectFlags aspect_flags = {}; // Inferred from format.
     };
 
-    struct ImplImageSlot
+    struct ImplImageViewColdSlot
     {
-        ImplImageViewSlot view_slot = {};
+        daxa_ImageViewInfo info = {};
+    };
+
+    struct ImplImageColdSlot
+    {
+        ImplImageViewColdSlot view_slot = {};
         daxa_ImageInfo info = {};
-        VkImage vk_image = {};
         VmaAllocation vma_allocation = {};
         daxa_MemoryBlock opt_memory_block = {};
         i32 swapchain_image_index = NOT_OWNED_BY_SWAPCHAIN;
-        VkImageAspectFlags aspect_flags = {}; // Inferred from format.
     };
 
     struct ImplSamplerSlot
     {
-        daxa_SamplerInfo info = {};
         VkSampler vk_sampler = {};
     };
 
+    struct ImplSamplerColdSlot
+    {
+        daxa_SamplerInfo info = {};
+    };
+
     struct ImplTlasSlot
     {
-        daxa_TlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
+        VkDeviceAddress device_address = {};
+    };
+
+    struct ImplTlasColdSlot
+    {
+        daxa_TlasInfo info = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
         u64 offset = {};
-        VkDeviceAddress device_address = {};
         bool owns_buffer = {};
     };
 
     struct ImplBlasSlot
     {
-        daxa_BlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
+        VkDeviceAddress device_address = {};
+    };
+
+    struct ImplBlasColdSlot
+    {
+        daxa_BlasInfo info = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
         u64 offset = {};
-        VkDeviceAddress device_address = {};
         bool owns_buffer = {};
     };
 
@@ -75,8 +104,15 @@ namespace daxa
      *
      * To check if these assumptions are met at runtime, the debug define DAXA_GPU_ID_VALIDATION can be enabled.
      * The define enables runtime checking to detect use after free and double free at the cost of performance.
+     *
+     * Free indices are kept in a lock free intrusive stack (Treiber stack).
+     * The links of the stack are stored next to the slots within each page, as pages are never freed during the lifetime of the pool.
+     * The head of the stack is tagged with a counter that is incremented on every pop to prevent ABA problems.
+     *
+     * Slots are stored as parallel arrays within each page: versions, hot data and cold data.
+     * Validation and command recording only touch versions and hot data, keeping them within few cache lines per id.
      */
-    template <typename ResourceT>
+    template <typename HotT, typename ColdT>
     struct GpuResourcePool
     {
         static constexpr inline usize MAX_RESOURCE_COUNT = 1u << 20u;
@@ -84,20 +120,190 @@ namespace daxa
         static constexpr inline usize PAGE_SIZE = 1u << PAGE_BITS;
         static constexpr inline usize PAGE_MASK = PAGE_SIZE - 1u;
         static constexpr inline usize PAGE_COUNT = MAX_RESOURCE_COUNT / PAGE_SIZE;
+        static constexpr inline u32 FREE_LIST_END = ~0u;
         using VersionAndRefcntT = std::atomic_uint64_t;
-        // TODO: split up slots into hot and cold data.
-        using PageT = std::array<std::pair<ResourceT, VersionAndRefcntT>, PAGE_SIZE>;
+        struct PageT
+        {
+            std::array<VersionAndRefcntT, PAGE_SIZE> versions = {};
+            std::array<HotT, PAGE_SIZE> hot = {};
+            std::array<ColdT, PAGE_SIZE> cold = {};
+            // Version of the id whose hot and cold data is fully written, 0 while the slot is free or being created.
+            std::array<std::atomic_uint64_t, PAGE_SIZE> published_versions = {};
+            // Next index in the free list for each slot. Only meaningful while the slot is in the free list.
+            std::array<std::atomic_uint32_t, PAGE_SIZE> free_list_next = {};
+        };
 
-        // TODO: replace with lockless queue.
-        std::vector<u32> free_index_stack = {};
-        u32 next_index = {};
+        // Lower 32 bits: index of the first free slot, FREE_LIST_END if empty.
+        // Upper 32 bits: tag, incremented on every successful pop.
+        std::atomic_uint64_t free_list_head = {static_cast<u64>(FREE_LIST_END)};
+        std::atomic_uint32_t next_index = {};
         u32 max_resources = {};
 
-        mutable std::mutex mut = {};
         std::mutex page_alloc_mtx = {};
         std::array<std::unique_ptr<PageT>, PAGE_COUNT> pages = {};
         std::atomic_uint32_t valid_page_count = {};
 
+        static auto make_free_list_head(u32 index, u32 tag) -> u64
+        {
+            return (static_cast<u64>(tag) << 32u) | static_cast<u64>(index);
+        }
+
+        void push_free_index(u32 index)
+        {
+            auto & next = this->pages[index >> PAGE_BITS]->free_list_next[index & PAGE_MASK];
+            u64 head = this->free_list_head.load(std::memory_order_relaxed);
+            u64 new_head = {};
+            do
+            {
+                next.store(static_cast<u32>(head), std::memory_order_relaxed);
+                new_head = make_free_list_head(index, static_cast<u32>(head >> 32u));
+            } while (!this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        auto try_pop_free_index() -> std::optional<u32>
+        {
+            u64 head = this->free_list_head.load(std::memory_order_acquire);
+            while (static_cast<u32>(head) != FREE_LIST_END)
+            {
+                u32 const index = static_cast<u32>(head);
+                // The link may be stale if another thread popped the index in the meantime.
+                // In that case the tag of the head changed and the cas below fails.
+                u32 const next = this->pages[index >> PAGE_BITS]->free_list_next[index & PAGE_MASK].load(std::memory_order_relaxed);
+                u64 const new_head = make_free_list_head(next, static_cast<u32>(head >> 32u) + 1u);
+                if (this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    return index;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Pushes a chain of indices, linked through free_list_next and ending in FREE_LIST_END, with a single successful cas.
+        void push_free_chain(u32 first_index, u32 last_index)
+        {
+            auto & next = this->pages[last_index >> PAGE_BITS]->free_list_next[last_index & PAGE_MASK];
+            u64 head = this->free_list_head.load(std::memory_order_relaxed);
+            u64 new_head = {};
+            do
+            {
+                next.store(static_cast<u32>(head), std::memory_order_relaxed);
+                new_head = make_free_list_head(first_index, static_cast<u32>(head >> 32u));
+            } while (!this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief   Pops up to out_indices.size() free indices at once.
+         *          The whole list is detached with one cas, the indices not taken are put back as one chain.
+         *
+         * Always threadsafe.
+         * @returns number of indices written to out_indices.
+         */
+        auto pop_free_indices(std::span<u32> out_indices) -> usize
+        {
+            if (out_indices.empty())
+            {
+                return 0;
+            }
+            u64 head = this->free_list_head.load(std::memory_order_acquire);
+            u64 detached_head = {};
+            do
+            {
+                if (static_cast<u32>(head) == FREE_LIST_END)
+                {
+                    return 0;
+                }
+                detached_head = make_free_list_head(FREE_LIST_END, static_cast<u32>(head >> 32u) + 1u);
+            } while (!this->free_list_head.compare_exchange_weak(head, detached_head, std::memory_order_acquire, std::memory_order_acquire));
+            // The detached chain is owned by this thread, its links can not change anymore.
+            auto next_of = [&](u32 index)
+            { return this->pages[index >> PAGE_BITS]->free_list_next[index & PAGE_MASK].load(std::memory_order_relaxed); };
+            u32 index = static_cast<u32>(head);
+            usize count = 0;
+            while (index != FREE_LIST_END && count < out_indices.size())
+            {
+                out_indices[count++] = index;
+                index = next_of(index);
+            }
+            if (index != FREE_LIST_END)
+            {
+                // Usually nothing was pushed in the meantime and the rest becomes the list again without walking it.
+                u64 expected_head = detached_head;
+                if (!this->free_list_head.compare_exchange_strong(expected_head, make_free_list_head(index, static_cast<u32>(detached_head >> 32u)), std::memory_order_release, std::memory_order_relaxed))
+                {
+                    u32 last_index = index;
+                    while (next_of(last_index) != FREE_LIST_END)
+                    {
+                        last_index = next_of(last_index);
+                    }
+                    this->push_free_chain(index, last_index);
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief   Counts the indices in the free list.
+         *
+         * NOT threadsafe, only intended for leak detection on cleanup.
+         */
+        auto free_index_count() const -> usize
+        {
+            usize count = 0;
+            u32 index = static_cast<u32>(this->free_list_head.load(std::memory_order_relaxed));
+            while (index != FREE_LIST_END)
+            {
+                ++count;
+                index = this->pages[index >> PAGE_BITS]->free_list_next[index & PAGE_MASK].load(std::memory_order_relaxed);
+            }
+            return count;
+        }
+
+        /**
+         * @brief   Marks the slot of a fully created resource, making it visible to for_each_published_slot.
+         *          Must be called after all hot and cold data of the slot is written.
+         *
+         * Always threadsafe.
+         */
+        void publish_slot(GPUResourceId id)
+        {
+            auto const page = static_cast<usize>(id.index) >> PAGE_BITS;
+            auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
+            this->pages[page]->published_versions[offset].store(id.version, std::memory_order_release);
+        }
+
+        /**
+         * @brief   Calls fn(hot, cold) with copies of the data of every published slot, zombies included.
+         *          Slots that are free or still being created are skipped.
+         *
+         * Threadsafe against slot creation.
+         * NOT threadsafe against slot destruction, callers must hold the lifetime lock of the table.
+         */
+        void for_each_published_slot(auto && fn) const
+        {
+            u32 const slot_count = std::min(
+                this->next_index.load(std::memory_order_relaxed),
+                static_cast<u32>(this->valid_page_count.load(std::memory_order_acquire) * PAGE_SIZE));
+            for (u32 index = 0; index < slot_count; ++index)
+            {
+                auto const & page = *this->pages[index >> PAGE_BITS];
+                auto const offset = index & PAGE_MASK;
+                // Acquire pairs with the release in publish_slot, the slots data is complete once the version is seen.
+                u64 const version = page.published_versions[offset].load(std::memory_order_acquire);
+                if (version == 0)
+                {
+                    continue;
+                }
+                HotT const hot = page.hot[offset];
+                ColdT const cold = page.cold[offset];
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (page.published_versions[offset].load(std::memory_order_relaxed) != version)
+                {
+                    continue;
+                }
+                fn(hot, cold);
+            }
+        }
+
         /**
          * @brief   Destroys a slot.
          *          After calling this function, the id of the slot will be forever invalid.
@@ -111,15 +317,16 @@ namespace daxa
         {
             auto const page = static_cast<usize>(id.index) >> PAGE_BITS;
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
-            auto const version = this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
+            auto const version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             // Slots that reached max version CAN NOT be recycled.
             // That is because we can not guarantee uniqueness of ids when the version wraps back to 0.
             // Clear slot MUST HAPPEN before pushing into free list.
-            this->pages[page]->at(offset).first = {};
+            this->pages[page]->published_versions[offset].store(0, std::memory_order_relaxed);
+            this->pages[page]->hot[offset] = {};
+            this->pages[page]->cold[offset] = {};
             if (version != DAXA_ID_VERSION_MASK /* this is the maximum value a version is allowed to reach */)
             {
-                std::unique_lock l{mut};
-                this->free_index_stack.push_back(id.index);
+                this->push_free_index(static_cast<u32>(id.index));
             }
         }
 
@@ -130,49 +337,110 @@ namespace daxa
          * Must
          * * mutable ptr to resource is only used in parallel
          *
-         * @return The new resource slot and its id. Can fail if max resources is exceeded.
+         * @return The new resource slots hot and cold data and its id. Can fail if max resources is exceeded.
          */
-        auto try_create_slot() -> std::optional<std::pair<GPUResourceId, ResourceT &>>
+        auto try_create_slot() -> std::optional<std::tuple<GPUResourceId, HotT &, ColdT &>>
         {
-            u32 index;
+            u32 index = {};
+            if (auto const free_index = this->try_pop_free_index(); free_index.has_value())
             {
-                std::unique_lock l{mut};
-                if (this->free_index_stack.empty())
+                index = free_index.value();
+            }
+            else
+            {
+                index = this->next_index.load(std::memory_order_relaxed);
+                do
                 {
-                    index = this->next_index++;
                     if (index >= this->max_resources || index >= MAX_RESOURCE_COUNT)
                     {
                         return std::nullopt;
                     }
-                }
-                else
+                } while (!this->next_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed, std::memory_order_relaxed));
+                this->allocate_pages_up_to(static_cast<usize>(index) >> PAGE_BITS);
+            }
+            return this->reserved_slot(index);
+        }
+
+        /**
+         * @brief   Reserves out_indices.size() slots for a batch of resources at once, or none of them.
+         *          Free indices are taken first, the rest is claimed from the end of the pool with a single cas.
+         *          Each reserved index must be turned into a slot with reserved_slot or handed back with release_reserved_slots.
+         *
+         * Always threadsafe.
+         * @returns false if max resources would be exceeded.
+         */
+        auto try_reserve_slots(std::span<u32> out_indices) -> bool
+        {
+            usize const free_count = this->pop_free_indices(out_indices);
+            auto const fresh_count = static_cast<u32>(out_indices.size() - free_count);
+            if (fresh_count == 0)
+            {
+                return true;
+            }
+            u32 first_index = this->next_index.load(std::memory_order_relaxed);
+            do
+            {
+                if (static_cast<usize>(first_index) + fresh_count > this->max_resources || static_cast<usize>(first_index) + fresh_count > MAX_RESOURCE_COUNT)
                 {
-                    index = this->free_index_stack.back();
-                    this->free_index_stack.pop_back();
+                    for (u32 const index : out_indices.first(free_count))
+                    {
+                        this->push_free_index(index);
+                    }
+                    return false;
                 }
+            } while (!this->next_index.compare_exchange_weak(first_index, first_index + fresh_count, std::memory_order_relaxed, std::memory_order_relaxed));
+            for (u32 i = 0; i < fresh_count; ++i)
+            {
+                out_indices[free_count + i] = first_index + i;
             }
+            this->allocate_pages_up_to(static_cast<usize>(first_index + fresh_count - 1) >> PAGE_BITS);
+            return true;
+        }
 
+        /**
+         * @brief   Hands reserved indices that were never turned into a resource back to the pool.
+         *
+         * Always threadsafe.
+         */
+        void release_reserved_slots(std::span<u32 const> indices)
+        {
+            for (u32 const index : indices)
+            {
+                this->pages[index >> PAGE_BITS]->hot[index & PAGE_MASK] = {};
+                this->pages[index >> PAGE_BITS]->cold[index & PAGE_MASK] = {};
+                this->push_free_index(index);
+            }
+        }
+
+        // Returns the id and data of a slot whose index was claimed by try_create_slot or try_reserve_slots.
+        auto reserved_slot(u32 index) -> std::tuple<GPUResourceId, HotT &, ColdT &>
+        {
             auto const page = static_cast<usize>(index) >> PAGE_BITS;
             auto const offset = static_cast<usize>(index) & PAGE_MASK;
+            u64 const version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
+            auto const id = GPUResourceId{.index = static_cast<u64>(index), .version = version};
+            return std::tuple<GPUResourceId, HotT &, ColdT &>(id, this->pages[page]->hot[offset], this->pages[page]->cold[offset]);
+        }
 
+        void allocate_pages_up_to(usize page)
+        {
             if (page >= this->valid_page_count.load(std::memory_order_seq_cst))
             {
                 std::unique_lock l{page_alloc_mtx};
-                if (page >= this->valid_page_count.load(std::memory_order_relaxed))
+                // Other threads may have been handed out indices of later pages before this one got allocated.
+                // Always allocate all pages up to and including the required one to keep valid_page_count correct.
+                while (page >= this->valid_page_count.load(std::memory_order_relaxed))
                 {
-                    this->pages[page] = std::make_unique<PageT>();
+                    auto const new_page = this->valid_page_count.load(std::memory_order_relaxed);
+                    this->pages[new_page] = std::make_unique<PageT>();
                     for (u32 i = 0; i < PAGE_SIZE; ++i)
                     {
-                        this->pages[page]->at(i).second.store(1ull, std::memory_order_relaxed);
+                        this->pages[new_page]->versions[i].store(1ull, std::memory_order_relaxed);
                     }
                     // Needs to be sequential, so that the 0 writes to the versions are visible before the atomic op.
                     this->valid_page_count.fetch_add(1, std::memory_order_seq_cst);
                 }
             }
-            u64 version = this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
-
-            auto const id = GPUResourceId{.index = static_cast<u64>(index), .version = version};
-            return std::optional{std::pair<GPUResourceId, ResourceT &>(id, this->pages[page]->at(offset).first)};
         }
 
         auto try_zombify(GPUResourceId id) -> bool
@@ -185,7 +453,7 @@ namespace daxa
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
             u64 version = id.version;
             u64 const new_version = version + 1;
-            return (*this->pages[page])[offset].second.compare_exchange_strong(
+            return this->pages[page]->versions[offset].compare_exchange_strong(
                 version, new_version,
                 std::memory_order_relaxed,
                 std::memory_order_relaxed);
@@ -205,42 +473,126 @@ namespace daxa
             {
                 return false;
             }
-            u64 const slot_version = (*this->pages[page])[offset].second.load(std::memory_order_relaxed);
+            u64 const slot_version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             return slot_version == id.version;
         }
 
         /**
-         * @brief   Checks if an id refers to a valid resource.
+         * @brief   Validates many ids in one pass, loading the page count only once.
+         * @returns if all given ids are valid.
+         */
+        template <typename IdT>
+        auto are_ids_valid(std::span<IdT const> ids) const -> bool
+        {
+            usize const page_count = this->valid_page_count.load(std::memory_order_relaxed);
+            for (IdT const & typed_id : ids)
+            {
+                auto const id = std::bit_cast<GPUResourceId>(typed_id);
+                auto const page = static_cast<usize>(id.index) >> PAGE_BITS;
+                auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
+                if (id.version == 0 || page >= page_count || this->pages[page]->versions[offset].load(std::memory_order_relaxed) != id.version)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief   Returns the hot data of the slot of an id.
          *          May return a random slot if the id is invalid.
          *
          * Only Threadsafe when:
          * * resource is not destroyed before the reference is used for the last time.
          *
-         * @returns resource.
+         * @returns hot resource data.
+         */
+        auto unsafe_get(GPUResourceId id) const -> HotT const &
+        {
+            auto const [page, offset] = this->clamped_page_and_offset(id);
+            return pages[page]->hot[offset];
+        }
+
+        /**
+         * @brief   Returns the cold data of the slot of an id.
+         *          May return a random slot if the id is invalid.
+         *
+         * Same thread safety rules as unsafe_get.
+         *
+         * @returns cold resource data.
          */
-        auto unsafe_get(GPUResourceId id) const -> ResourceT const &
+        auto unsafe_get_cold(GPUResourceId id) const -> ColdT const &
+        {
+            auto const [page, offset] = this->clamped_page_and_offset(id);
+            return pages[page]->cold[offset];
+        }
+
+        auto clamped_page_and_offset(GPUResourceId id) const -> std::pair<usize, usize>
         {
             auto page = static_cast<usize>(id.index) >> PAGE_BITS;
             // Even in an unsafe read we never want to read memory we do not own!
             // Clamp so we get some random slot in error case but never invalid memory!
             page = std::min(static_cast<usize>(this->valid_page_count.load(std::memory_order_relaxed)) - 1, page);
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
-            return pages[page]->at(offset).first;
+            return {page, offset};
         }
     };
 
+    struct PendingDescriptorWrite
+    {
+        u32 binding = {};
+        u32 index = {};
+        VkDescriptorType type = {};
+        VkDescriptorImageInfo image_info = {};
+        VkDescriptorBufferInfo buffer_info = {};
+        VkAccelerationStructureKHR acceleration_structure = {};
+    };
+
+    /**
+     * @brief   Queue of writes to the resource table descriptor set, flushed with a single vkUpdateDescriptorSets before each submit.
+     *          Writes to the same binding and array element are coalesced, only the latest one is kept.
+     *          This also drops the writes of resources that are destroyed before the next flush.
+     *
+     * Always threadsafe.
+     * Garbage collection queues and flushes the null descriptors of collected resources before destroying their handles.
+     */
+    struct DescriptorWriteQueue
+    {
+        // The acceleration structure binding is the last binding of the resource table.
+        static constexpr u32 BINDING_COUNT = 6;
+
+        std::mutex mtx = {};
+        // All vectors are reused between flushes.
+        std::vector<PendingDescriptorWrite> pending = {};
+        // Per binding, maps each array element to the index of its pending write plus one, zero meaning no pending write.
+        // Flush only resets the entries of the flushed writes.
+        std::array<std::vector<u32>, BINDING_COUNT> pending_index_of_slot = {};
+        std::vector<VkWriteDescriptorSet> vk_writes = {};
+        std::vector<VkWriteDescriptorSetAccelerationStructureKHR> vk_as_writes = {};
+
+        void enqueue(PendingDescriptorWrite const & write);
+        void write_sampler(VkSampler vk_sampler, u32 index);
+        void write_buffer(VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index);
+        void write_image(VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
+        void write_acceleration_structure(VkAccelerationStructureKHR vk_acceleration_structure, u32 index);
+        // There is no null acceleration structure yet, so destroyed acceleration structures only drop their pending write.
+        void discard_acceleration_structure(u32 index);
+        void flush(VkDevice vk_device, VkDescriptorSet vk_descriptor_set);
+    };
+
     struct GPUShaderResourceTable
     {
         std::shared_mutex lifetime_lock = {};
-        GpuResourcePool<ImplBufferSlot> buffer_slots = {};
-        GpuResourcePool<ImplImageSlot> image_slots = {};
-        GpuResourcePool<ImplSamplerSlot> sampler_slots = {};
-        GpuResourcePool<ImplTlasSlot> tlas_slots = {};
-        GpuResourcePool<ImplBlasSlot> blas_slots = {};
+        GpuResourcePool<ImplBufferSlot, ImplBufferColdSlot> buffer_slots = {};
+        GpuResourcePool<ImplImageSlot, ImplImageColdSlot> image_slots = {};
+        GpuResourcePool<ImplSamplerSlot, ImplSamplerColdSlot> sampler_slots = {};
+        GpuResourcePool<ImplTlasSlot, ImplTlasColdSlot> tlas_slots = {};
+        GpuResourcePool<ImplBlasSlot, ImplBlasColdSlot> blas_slots = {};
 
         VkDescriptorSetLayout vk_descriptor_set_layout = {};
         VkDescriptorSet vk_descriptor_set = {};
         VkDescriptorPool vk_descriptor_pool = {};
+        DescriptorWriteQueue descriptor_writes = {};
 
         // Contains pipeline layouts with varying push constant range size.
         // The first size is 0 word, second is 1 word, all others are a power of two (maximum is MAX_PUSH_CONSTANT_BYTE_SIZE).
@@ -256,12 +608,4 @@ namespace daxa
             PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT) -> daxa_Result;
         void cleanup(VkDevice device);
     };
-
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index);
-
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index);
-
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
-
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index);
 } // namespace daxa
@@ -1,6 +1,70 @@
 #include "impl_device.hpp"
 #include "impl_pipeline.hpp"
 
+#include <cstddef>
+#include <cstring>
+
+// Holds the vulkan specialization info of one shader stage.
+// The constant values are packed into data, each truncated to its size, so the layout does not depend on the hosts endianness.
+struct ImplSpecializationInfo
+{
+    std::vector<VkSpecializationMapEntry> map_entries = {};
+    std::vector<std::byte> data = {};
+    VkSpecializationInfo vk_specialization_info = {};
+};
+
+static auto validate_specialization_constants(ShaderInfo const & shader_info) -> daxa_Result
+{
+    for (usize i = 0; i < shader_info.specialization_constants.size(); ++i)
+    {
+        auto const & constant = shader_info.specialization_constants[i];
+        if (constant.size != 1 && constant.size != 2 && constant.size != 4 && constant.size != 8)
+        {
+            return DAXA_RESULT_ERROR_INVALID_SPECIALIZATION_CONSTANT_SIZE;
+        }
+    }
+    return DAXA_RESULT_SUCCESS;
+}
+
+static auto make_specialization_info(ShaderInfo const & shader_info, std::vector<std::unique_ptr<ImplSpecializationInfo>> & storage) -> VkSpecializationInfo const *
+{
+    if (shader_info.specialization_constants.empty())
+    {
+        return nullptr;
+    }
+    auto & info = *storage.emplace_back(std::make_unique<ImplSpecializationInfo>());
+    info.map_entries.reserve(shader_info.specialization_constants.size());
+    // Every constant gets an 8 byte slot, so each value is aligned to its size.
+    info.data.resize(shader_info.specialization_constants.size() * sizeof(u64));
+    for (usize i = 0; i < shader_info.specialization_constants.size(); ++i)
+    {
+        auto const & constant = shader_info.specialization_constants[i];
+        auto const offset = static_cast<u32>(i * sizeof(u64));
+        // The size was checked by validate_specialization_constants.
+        auto const copy_value = [&](auto sized_value)
+        { std::memcpy(info.data.data() + offset, &sized_value, sizeof(sized_value)); };
+        switch (constant.size)
+        {
+        case 1: copy_value(static_cast<u8>(constant.value)); break;
+        case 2: copy_value(static_cast<u16>(constant.value)); break;
+        case 4: copy_value(static_cast<u32>(constant.value)); break;
+        default: copy_value(constant.value); break;
+        }
+        info.map_entries.push_back(VkSpecializationMapEntry{
+            .constantID = constant.constant_id,
+            .offset = offset,
+            .size = constant.size,
+        });
+    }
+    info.vk_specialization_info = VkSpecializationInfo{
+        .mapEntryCount = static_cast<u32>(info.map_entries.size()),
+        .pMapEntries = info.map_entries.data(),
+        .dataSize = info.data.size(),
+        .pData = info.data.data(),
+    };
+    return &info.vk_specialization_info;
+}
+
 // --- Begin API Functions ---
 
 auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo const * info, daxa_RasterPipeline * out_pipeline) -> daxa_Result
@@ -9,9 +73,18 @@ auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo
     daxa_ImplRasterPipeline ret = {};
     ret.device = device;
     ret.info = *reinterpret_cast<RasterPipelineInfo const *>(info);
+    for (auto const * shader_info : {&ret.info.mesh_shader_info, &ret.info.vertex_shader_info, &ret.info.tesselation_control_shader_info, &ret.info.tesselation_evaluation_shader_info, &ret.info.fragment_shader_info, &ret.info.task_shader_info})
+    {
+        if (shader_info->has_value())
+        {
+            auto const result = validate_specialization_constants(shader_info->value());
+            _DAXA_RETURN_IF_ERROR(result, result)
+        }
+    }
     std::vector<VkShaderModule> vk_shader_modules = {};
     // NOTE: Temporarily holds 0 terminated strings, incoming strings are data + size, not null terminated!
     std::vector<std::unique_ptr<std::string>> entry_point_names = {};
+    std::vector<std::unique_ptr<ImplSpecializationInfo>> specialization_infos = {};
     std::vector<VkPipelineShaderStageCreateInfo> vk_pipeline_shader_stage_create_infos = {};
 
     std::vector<VkPipelineShaderStageRequiredSubgroupSizeCreateInfo> require_subgroup_size_vkstructs = {};
@@ -48,7 +121,7 @@ auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo
             .stage = shader_stage,
             .module = vk_shader_module,
             .pName = entry_point_names.back()->c_str(),
-            .pSpecializationInfo = nullptr,
+            .pSpecializationInfo = make_specialization_info(shader_info, specialization_infos),
         };
         vk_pipeline_shader_stage_create_infos.push_back(vk_pipeline_shader_stage_create_info);
         return result;
@@ -278,13 +351,17 @@ auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex = 0,
     };
-    auto result = vkCreateGraphicsPipelines(
-        ret.device->vk_device,
-        VK_NULL_HANDLE,
-        1u,
-        &vk_graphics_pipeline_create_info,
-        nullptr,
-        &ret.vk_pipeline);
+    VkResult result = {};
+    {
+        std::shared_lock const pipeline_cache_lock{ret.device->pipeline_cache_mtx};
+        result = vkCreateGraphicsPipelines(
+            ret.device->vk_device,
+            ret.device->vk_pipeline_cache,
+            1u,
+            &vk_graphics_pipeline_create_info,
+            nullptr,
+            &ret.vk_pipeline);
+    }
     for (auto & vk_shader_module : vk_shader_modules)
     {
         vkDestroyShaderModule(ret.device->vk_device, vk_shader_module, nullptr);
@@ -335,6 +412,8 @@ auto daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineIn
     daxa_ImplComputePipeline ret = {};
     ret.device = device;
     ret.info = *reinterpret_cast<ComputePipelineInfo const *>(info);
+    auto const validation_result = validate_specialization_constants(ret.info.shader_info);
+    _DAXA_RETURN_IF_ERROR(validation_result, validation_result)
     VkShaderModule vk_shader_module = {};
     VkShaderModuleCreateInfo const shader_module_ci{
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
@@ -354,6 +433,7 @@ auto daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineIn
         .pNext = nullptr,
         .requiredSubgroupSize = ret.info.shader_info.required_subgroup_size.value_or(0),
     };
+    std::vector<std::unique_ptr<ImplSpecializationInfo>> specialization_infos = {};
     VkComputePipelineCreateInfo const vk_compute_pipeline_create_info{
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
         .pNext = nullptr,
@@ -365,19 +445,23 @@ auto daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineIn
             .stage = VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT,
             .module = vk_shader_module,
             .pName = ret.info.shader_info.entry_point.data(),
-            .pSpecializationInfo = nullptr,
+            .pSpecializationInfo = make_specialization_info(ret.info.shader_info, specialization_infos),
         },
         .layout = ret.vk_pipeline_layout,
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex = 0,
     };
-    auto pipeline_result = vkCreateComputePipelines(
-        ret.device->vk_device,
-        VK_NULL_HANDLE,
-        1u,
-        &vk_compute_pipeline_create_info,
-        nullptr,
-        &ret.vk_pipeline);
+    VkResult pipeline_result = {};
+    {
+        std::shared_lock const pipeline_cache_lock{ret.device->pipeline_cache_mtx};
+        pipeline_result = vkCreateComputePipelines(
+            ret.device->vk_device,
+            ret.device->vk_pipeline_cache,
+            1u,
+            &vk_compute_pipeline_create_info,
+            nullptr,
+            &ret.vk_pipeline);
+    }
     vkDestroyShaderModule(ret.device->vk_device, vk_shader_module, nullptr);
     if (pipeline_result != VK_SUCCESS)
     {
@@ -437,6 +521,14 @@ auto daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPip
     {
         return DAXA_RESULT_INVALID_WITHOUT_ENABLING_RAY_TRACING;
     }
+    for (auto const shader_infos : {ret.info.ray_gen_shaders, ret.info.intersection_shaders, ret.info.any_hit_shaders, ret.info.callable_shaders, ret.info.closest_hit_shaders, ret.info.miss_hit_shaders})
+    {
+        for (usize i = 0; i < shader_infos.size(); ++i)
+        {
+            auto const result = validate_specialization_constants(shader_infos[i]);
+            _DAXA_RETURN_IF_ERROR(result, result)
+        }
+    }
 
     // Stages are the shader modules
     std::vector<VkPipelineShaderStageCreateInfo> stages = {};
@@ -446,6 +538,7 @@ auto daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPip
     std::vector<VkShaderModule> vk_shader_modules = {};
     // NOTE: Temporarily holds 0 terminated strings, incoming strings are data + size, not null terminated!
     std::vector<std::unique_ptr<std::string>> entry_point_names = {};
+    std::vector<std::unique_ptr<ImplSpecializationInfo>> specialization_infos = {};
 
     defer
     {
@@ -499,7 +592,7 @@ auto daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPip
             .stage = shader_stage,
             .module = vk_shader_module,
             .pName = entry_point_names.back()->c_str(),
-            .pSpecializationInfo = nullptr,
+            .pSpecializationInfo = make_specialization_info(shader_info, specialization_infos),
         };
         stages.push_back(vk_pipeline_shader_stage_create_info);
         return result;
@@ -584,14 +677,18 @@ auto daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPip
         .basePipelineHandle = VK_NULL_HANDLE,
         .basePipelineIndex = 0,
     };
-    auto pipeline_result = ret.device->vkCreateRayTracingPipelinesKHR(
-        ret.device->vk_device,
-        VK_NULL_HANDLE,
-        VK_NULL_HANDLE,
-        1u,
-        &vk_ray_tracing_pipeline_create_info,
-        nullptr,
-        &ret.vk_pipeline);
+    VkResult pipeline_result = {};
+    {
+        std::shared_lock const pipeline_cache_lock{ret.device->pipeline_cache_mtx};
+        pipeline_result = ret.device->vkCreateRayTracingPipelinesKHR(
+            ret.device->vk_device,
+            VK_NULL_HANDLE,
+            ret.device->vk_pipeline_cache,
+            1u,
+            &vk_ray_tracing_pipeline_create_info,
+            nullptr,
+            &ret.vk_pipeline);
+    }
 
     if (pipeline_result != VK_SUCCESS)
     {
@@ -862,6 +959,7 @@ void ImplPipeline::zero_ref_callback(ImplHandle const * handle)
         PipelineZombie{
             .vk_pipeline = self->vk_pipeline,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -220,6 +220,7 @@ void daxa_ImplBinarySemaphore::zero_ref_callback(ImplHandle const * handle)
         SemaphoreZombie{
             .vk_semaphore = self->vk_semaphore,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -237,6 +238,7 @@ void daxa_ImplTimelineSemaphore::zero_ref_callback(ImplHandle const * handle)
         SemaphoreZombie{
             .vk_semaphore = self->vk_semaphore,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -253,6 +255,7 @@ void daxa_ImplEvent::zero_ref_callback(ImplHandle const * handle)
         EventZombie{
             .vk_event = self->vk_event,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -94,6 +94,7 @@ void daxa_ImplTimelineQueryPool::zero_ref_callback(ImplHandle const * handle)
         TimelineQueryPoolZombie{
             .vk_timeline_query_pool = self->vk_timeline_query_pool,
         });
+    self->device->wake_background_gc();
     self->device->dec_weak_refcnt(
         daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -28,6 +28,7 @@ struct Push
 #include <cstring>
 #include <utility>
 #include <algorithm>
+#include <iterator>
 
 void set_imgui_style()
 {
@@ -141,88 +142,71 @@ namespace daxa
     }
 #endif
 
-    void ImplImGuiRenderer::recreate_vbuffer(usize vbuffer_new_size)
+    auto ImplImGuiRenderer::acquire_upload_buffer(usize needed_size) -> ImGuiUploadBuffer &
     {
-        vbuffer = info.device.create_buffer({
-            .size = static_cast<u32>(vbuffer_new_size),
-            .name = std::string("dear ImGui vertex buffer"),
-        });
-    }
-    void ImplImGuiRenderer::recreate_ibuffer(usize ibuffer_new_size)
-    {
-        ibuffer = info.device.create_buffer({
-            .size = static_cast<u32>(ibuffer_new_size),
-            .name = std::string("dear ImGui index buffer"),
-        });
+        constexpr usize IMGUI_UPLOAD_BUFFER_MIN_SIZE = 1ull << 16;
+
+        u64 const oldest_pending_submit = info.device.oldest_pending_submit_index();
+        auto iter = std::find_if(
+            upload_buffers.begin(), upload_buffers.end(),
+            [&](ImGuiUploadBuffer const & upload_buffer)
+            { return upload_buffer.submit_index < oldest_pending_submit; });
+        if (iter == upload_buffers.end())
+        {
+            upload_buffers.push_back({});
+            iter = std::prev(upload_buffers.end());
+        }
+        if (iter->size < needed_size)
+        {
+            // The gpu is done with the buffer, so it can be destroyed immediately.
+            if (!iter->buffer.is_empty())
+            {
+                info.device.destroy_buffer(iter->buffer);
+            }
+            iter->size = std::max({needed_size, iter->size * 2, IMGUI_UPLOAD_BUFFER_MIN_SIZE});
+            iter->buffer = info.device.create_buffer({
+                .size = static_cast<u32>(iter->size),
+                .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_SEQUENTIAL_WRITE,
+                .name = std::string("dear ImGui upload buffer ") + std::to_string(std::distance(upload_buffers.begin(), iter)),
+            });
+        }
+        last_upload_buffer = static_cast<usize>(std::distance(upload_buffers.begin(), iter));
+        return *iter;
     }
 
     void ImplImGuiRenderer::record_commands(ImDrawData * draw_data, CommandRecorder & recorder, ImageId target_image, u32 size_x, u32 size_y)
     {
         ++frame_count;
+        // The commands recorded by the previous call are assumed to be submitted before this call.
+        // Their submit index is therefore at most the latest submit index.
+        if (last_upload_buffer.has_value())
+        {
+            upload_buffers[last_upload_buffer.value()].submit_index = info.device.latest_submit_index();
+            last_upload_buffer = std::nullopt;
+        }
         if ((draw_data != nullptr) && draw_data->TotalIdxCount > 0)
         {
-            auto vbuffer_current_size = info.device.buffer_info(vbuffer).value().size;
-            auto vbuffer_needed_size = static_cast<usize>(draw_data->TotalVtxCount) * sizeof(ImDrawVert);
-            auto ibuffer_current_size = info.device.buffer_info(ibuffer).value().size;
+            // Indices are stored at the start of the upload buffer, vertices follow after them.
+            constexpr usize VERTEX_ALIGNMENT = 16;
             auto ibuffer_needed_size = static_cast<usize>(draw_data->TotalIdxCount) * sizeof(ImDrawIdx);
+            auto vbuffer_offset = (ibuffer_needed_size + VERTEX_ALIGNMENT - 1) / VERTEX_ALIGNMENT * VERTEX_ALIGNMENT;
+            auto vbuffer_needed_size = static_cast<usize>(draw_data->TotalVtxCount) * sizeof(ImDrawVert);
 
-            if (vbuffer_needed_size > vbuffer_current_size)
-            {
-                auto vbuffer_new_size = vbuffer_needed_size + 4096;
-                info.device.destroy_buffer(vbuffer);
-                recreate_vbuffer(vbuffer_new_size);
-            }
-            if (ibuffer_needed_size > ibuffer_current_size)
-            {
-                auto ibuffer_new_size = ibuffer_needed_size + 4096;
-                info.device.destroy_buffer(ibuffer);
-                recreate_ibuffer(ibuffer_new_size);
-            }
-
-            constexpr usize IMGUI_RESOURCE_NAME_MAX_NUMBER = 8;
+            ImGuiUploadBuffer const & upload_buffer = acquire_upload_buffer(vbuffer_offset + vbuffer_needed_size);
 
-            auto staging_vbuffer = info.device.create_buffer({
-                .size = static_cast<u32>(vbuffer_needed_size),
-                .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_RANDOM,
-                .name = std::string("dear ImGui vertex staging buffer ") + std::to_string(frame_count % IMGUI_RESOURCE_NAME_MAX_NUMBER),
-            });
-            auto * vtx_dst = info.device.buffer_host_address_as<ImDrawVert>(staging_vbuffer).value();
-            for (i32 n = 0; n < draw_data->CmdListsCount; n++)
-            {
-                ImDrawList const * draws = draw_data->CmdLists[n];
-                std::memcpy(vtx_dst, draws->VtxBuffer.Data, static_cast<usize>(draws->VtxBuffer.Size) * sizeof(ImDrawVert));
-                vtx_dst += draws->VtxBuffer.Size;
-            }
-            recorder.destroy_buffer_deferred(staging_vbuffer);
-            auto staging_ibuffer = info.device.create_buffer({
-                .size = static_cast<u32>(ibuffer_needed_size),
-                .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_RANDOM,
-                .name = std::string("dear ImGui index staging buffer ") + std::to_string(frame_count % IMGUI_RESOURCE_NAME_MAX_NUMBER),
-            });
-            auto * idx_dst = info.device.buffer_host_address_as<ImDrawIdx>(staging_ibuffer).value();
+            auto * upload_host_address = info.device.buffer_host_address_as<u8>(upload_buffer.buffer).value();
+            auto * idx_dst = r_cast<ImDrawIdx *>(upload_host_address);
+            auto * vtx_dst = r_cast<ImDrawVert *>(upload_host_address + vbuffer_offset);
             for (i32 n = 0; n < draw_data->CmdListsCount; n++)
             {
                 ImDrawList const * draws = draw_data->CmdLists[n];
                 std::memcpy(idx_dst, draws->IdxBuffer.Data, static_cast<usize>(draws->IdxBuffer.Size) * sizeof(ImDrawIdx));
+                std::memcpy(vtx_dst, draws->VtxBuffer.Data, static_cast<usize>(draws->VtxBuffer.Size) * sizeof(ImDrawVert));
                 idx_dst += draws->IdxBuffer.Size;
+                vtx_dst += draws->VtxBuffer.Size;
             }
-            recorder.destroy_buffer_deferred(staging_ibuffer);
             recorder.pipeline_barrier({
                 .src_access = daxa::AccessConsts::HOST_WRITE,
-                .dst_access = daxa::AccessConsts::TRANSFER_READ,
-            });
-            recorder.copy_buffer_to_buffer({
-                .src_buffer = staging_ibuffer,
-                .dst_buffer = ibuffer,
-                .size = ibuffer_needed_size,
-            });
-            recorder.copy_buffer_to_buffer({
-                .src_buffer = staging_vbuffer,
-                .dst_buffer = vbuffer,
-                .size = vbuffer_needed_size,
-            });
-            recorder.pipeline_barrier({
-                .src_access = daxa::AccessConsts::TRANSFER_WRITE,
                 .dst_access = daxa::AccessConsts::VERTEX_SHADER_READ | daxa::AccessConsts::INDEX_INPUT_READ,
             });
 
@@ -234,7 +218,7 @@ namespace daxa
             render_recorder.set_pipeline(raster_pipeline);
 
             render_recorder.set_index_buffer({
-                .id = ibuffer,
+                .id = upload_buffer.buffer,
                 .offset = 0,
                 .index_type = IndexType::uint16,
             });
@@ -246,8 +230,9 @@ namespace daxa
             ImVec2 const clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
             i32 global_vtx_offset = 0;
             i32 global_idx_offset = 0;
-            push.vbuffer_ptr = this->info.device.device_address(vbuffer).value();
-            push.ibuffer_ptr = this->info.device.device_address(ibuffer).value();
+            DeviceAddress const upload_device_address = this->info.device.device_address(upload_buffer.buffer).value();
+            push.vbuffer_ptr = upload_device_address + vbuffer_offset;
+            push.ibuffer_ptr = upload_device_address;
 
             for (i32 n = 0; n < draw_data->CmdListsCount; n++)
             {
@@ -346,8 +331,6 @@ namespace daxa
         {
             set_imgui_style();
         }
-        recreate_vbuffer(4096);
-        recreate_ibuffer(4096);
 
         ImGuiIO & io = ImGui::GetIO();
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
@@ -423,8 +406,10 @@ namespace daxa
 
     ImplImGuiRenderer::~ImplImGuiRenderer()
     {
-        this->info.device.destroy_buffer(this->vbuffer);
-        this->info.device.destroy_buffer(this->ibuffer);
+        for (auto const & upload_buffer : this->upload_buffers)
+        {
+            this->info.device.destroy_buffer(upload_buffer.buffer);
+        }
         this->info.device.destroy_image(this->font_sheet);
         this->info.device.destroy_sampler(this->font_sampler);
     }
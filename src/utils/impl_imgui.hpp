@@ -4,23 +4,33 @@
 
 #include <daxa/utils/imgui.hpp>
 #include <deque>
+#include <optional>
 
 namespace daxa
 {
+    // Host visible buffer holding the indices and vertices of one frame.
+    // Reused once the gpu finished all submits up to submit_index.
+    struct ImGuiUploadBuffer
+    {
+        BufferId buffer = {};
+        usize size = {};
+        u64 submit_index = {};
+    };
+
     struct ImplImGuiRenderer final : ImplHandle
     {
         ImGuiRendererInfo info = {};
         RasterPipeline raster_pipeline = {};
-        BufferId vbuffer = {};
-        BufferId ibuffer = {};
+        // One upload buffer per frame in flight, grows when all are in use by the gpu.
+        std::vector<ImGuiUploadBuffer> upload_buffers = {};
+        std::optional<usize> last_upload_buffer = {};
         ImageId font_sheet = {};
         SamplerId font_sampler = {};
         usize frame_count = {};
 
         std::vector<ImGuiImageContext> image_sampler_pairs = {};
 
-        void recreate_vbuffer(usize vbuffer_new_size);
-        void recreate_ibuffer(usize ibuffer_new_size);
+        auto acquire_upload_buffer(usize needed_size) -> ImGuiUploadBuffer &;
         void record_commands(ImDrawData * draw_data, CommandRecorder & recorder, ImageId target_image, u32 size_x, u32 size_y);
 
         ImplImGuiRenderer(ImGuiRendererInfo a_info);
@@ -1,6 +1,8 @@
 #if DAXA_BUILT_WITH_UTILS_MEM
 
 #include <daxa/utils/mem.hpp>
+#include <algorithm>
+#include <bit>
 #include <utility>
 
 namespace daxa
@@ -21,17 +23,25 @@ namespace daxa
     {
     }
 
+    // Moving a pool is not threadsafe, the atomics are only swapped to move their values.
+    static void swap_atomic(std::atomic_uint64_t & a, std::atomic_uint64_t & b)
+    {
+        u64 const a_value = a.load(std::memory_order_relaxed);
+        a.store(b.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        b.store(a_value, std::memory_order_relaxed);
+    }
+
     TransferMemoryPool::TransferMemoryPool(TransferMemoryPool && other)
     {
         std::swap(this->m_info, other.m_info);
         std::swap(this->gpu_timeline, other.gpu_timeline);
-        std::swap(this->current_timeline_value, other.current_timeline_value);
-        std::swap(this->live_allocations, other.live_allocations);
+        swap_atomic(this->current_timeline_value, other.current_timeline_value);
+        swap_atomic(this->claimed_start, other.claimed_start);
+        swap_atomic(this->claimed_end, other.claimed_end);
+        std::swap(this->checkpoints, other.checkpoints);
         std::swap(this->m_buffer, other.m_buffer);
         std::swap(this->buffer_device_address, other.buffer_device_address);
         std::swap(this->buffer_host_address, other.buffer_host_address);
-        std::swap(this->claimed_start, other.claimed_start);
-        std::swap(this->claimed_size, other.claimed_size);
     }
 
     auto TransferMemoryPool::operator=(TransferMemoryPool && other) -> TransferMemoryPool &
@@ -42,13 +52,13 @@ namespace daxa
         }
         std::swap(this->m_info, other.m_info);
         std::swap(this->gpu_timeline, other.gpu_timeline);
-        std::swap(this->current_timeline_value, other.current_timeline_value);
-        std::swap(this->live_allocations, other.live_allocations);
+        swap_atomic(this->current_timeline_value, other.current_timeline_value);
+        swap_atomic(this->claimed_start, other.claimed_start);
+        swap_atomic(this->claimed_end, other.claimed_end);
+        std::swap(this->checkpoints, other.checkpoints);
         std::swap(this->m_buffer, other.m_buffer);
         std::swap(this->buffer_device_address, other.buffer_device_address);
         std::swap(this->buffer_host_address, other.buffer_host_address);
-        std::swap(this->claimed_start, other.claimed_start);
-        std::swap(this->claimed_size, other.claimed_size);
         return *this;
     }
 
@@ -62,93 +72,93 @@ namespace daxa
 
     auto TransferMemoryPool::allocate(u32 allocation_size, u32 alignment_requirement) -> std::optional<TransferMemoryPool::Allocation>
     {
-        u32 const tail_alloc_offset = (this->claimed_start + this->claimed_size) % this->m_info.capacity;
+        u64 const capacity = this->m_info.capacity;
+        if (allocation_size > capacity)
+        {
+            return std::nullopt;
+        }
         auto up_align_offset = [](auto value, auto alignment)
         {
             return (value + alignment - 1) / alignment * alignment;
         };
-        u32 const tail_alloc_offset_aligned = up_align_offset(tail_alloc_offset, alignment_requirement);
-        u32 const tail_alloc_align_padding = tail_alloc_offset_aligned - tail_alloc_offset;
-        // Two allocations are possible:
-        // Tail allocation is when the allocation is placed directly at the end of all other allocations.
-        // Zero offset allocation is possible when there is not enough space left at the tail BUT there is enough space from 0 up to the start of the other allocations.
-        auto calc_tail_allocation_possible = [&]()
-        {
-            u32 const tail = tail_alloc_offset_aligned;
-            bool const wrapped = this->claimed_start + this->claimed_size > this->m_info.capacity;
-            u32 const end = wrapped ? this->claimed_start : this->m_info.capacity;
-            return tail + allocation_size <= end;
-        };
-        auto calc_zero_offset_allocation_possible = [&]()
+        // Taken before claiming, so any claim seen by reclaim_unused_memory already has its timeline value handed out.
+        u64 const timeline_index = this->current_timeline_value.fetch_add(1, std::memory_order_seq_cst) + 1;
+        // Claims the allocation by bumping claimed_end, returns the ring position of the allocation.
+        // When the allocation does not fit in front of the end of the buffer, it is placed at offset 0 and the rest of the buffer is skipped.
+        // Illustration: |XXX ## |; "X": new allocation; "#": used up space; " ": free space.
+        auto try_claim = [&]() -> std::optional<u64>
         {
-            return this->claimed_start + this->claimed_size <= this->m_info.capacity && allocation_size < this->claimed_start;
+            u64 end = this->claimed_end.load(std::memory_order_relaxed);
+            while (true)
+            {
+                u64 const wrap_start = end - end % capacity;
+                u64 const aligned_offset = up_align_offset(end % capacity, static_cast<u64>(alignment_requirement));
+                u64 const start = aligned_offset + allocation_size <= capacity ? wrap_start + aligned_offset : wrap_start + capacity;
+                u64 const new_end = start + allocation_size;
+                if (new_end - this->claimed_start.load(std::memory_order_acquire) > capacity)
+                {
+                    return std::nullopt;
+                }
+                if (this->claimed_end.compare_exchange_weak(end, new_end, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    return start;
+                }
+            }
         };
-        // Firstly, test if there is enough continuous space left to allocate.
-        bool tail_allocation_possible = calc_tail_allocation_possible();
-        // When there is no tail space left, it may be the case that we can place the allocation at offset 0.
-        // Illustration: |XXX ## |; "X": new allocation; "#": used up space; " ": free space.
-        bool zero_offset_allocation_possible = calc_zero_offset_allocation_possible();
-        if (!tail_allocation_possible && !zero_offset_allocation_possible)
+        std::optional<u64> start = try_claim();
+        if (!start.has_value())
         {
             this->reclaim_unused_memory();
-            tail_allocation_possible = calc_tail_allocation_possible();
-            zero_offset_allocation_possible = calc_zero_offset_allocation_possible();
-            if (!tail_allocation_possible && !zero_offset_allocation_possible)
+            start = try_claim();
+            if (!start.has_value())
             {
                 return std::nullopt;
             }
         }
-        current_timeline_value += 1;
-        u32 returned_allocation_offset = {};
-        u32 actual_allocation_offset = {};
-        u32 actual_allocation_size = {};
-        if (tail_allocation_possible)
-        {
-            actual_allocation_size = allocation_size + tail_alloc_align_padding;
-            returned_allocation_offset = tail_alloc_offset_aligned;
-            actual_allocation_offset = tail_alloc_offset;
-        }
-        else // Zero offset allocation.
-        {
-            u32 const left_tail_space = this->m_info.capacity - (this->claimed_start + this->claimed_size);
-            actual_allocation_size = allocation_size + left_tail_space;
-            returned_allocation_offset = {};
-            actual_allocation_offset = {};
-        }
-        this->claimed_size += actual_allocation_size;
-        live_allocations.push_back(TrackedAllocation{
-            .timeline_index = this->current_timeline_value,
-            .offset = actual_allocation_offset,
-            .size = actual_allocation_size,
-        });
+        u32 const returned_allocation_offset = static_cast<u32>(start.value() % capacity);
         return Allocation{
             .device_address = this->buffer_device_address + returned_allocation_offset,
             .host_address = reinterpret_cast<void *>(reinterpret_cast<u8 *>(this->buffer_host_address) + returned_allocation_offset),
             .buffer_offset = returned_allocation_offset,
             .size = allocation_size,
-            .timeline_index = this->current_timeline_value,
+            .timeline_index = timeline_index,
         };
     }
 
     auto TransferMemoryPool::timeline_value() const -> usize
     {
-        return this->current_timeline_value;
+        return this->current_timeline_value.load(std::memory_order_relaxed);
     }
 
     auto TransferMemoryPool::inc_timeline_value() -> usize
     {
-        return ++this->current_timeline_value;
+        return this->current_timeline_value.fetch_add(1, std::memory_order_seq_cst) + 1;
     }
 
     void TransferMemoryPool::reclaim_unused_memory()
     {
-        auto const current_gpu_timeline_value = this->gpu_timeline.value();
-        while (!live_allocations.empty() && live_allocations.front().timeline_index <= current_gpu_timeline_value)
+        std::unique_lock const lock{this->reclaim_mtx};
+        // Every claim before end took its timeline value before claiming, so all of them are covered by timeline_value.
+        u64 const end = this->claimed_end.load(std::memory_order_seq_cst);
+        u64 const timeline_value = this->current_timeline_value.load(std::memory_order_seq_cst);
+        u64 const current_gpu_timeline_value = this->gpu_timeline.value();
+        u64 reclaimed_end = this->claimed_start.load(std::memory_order_relaxed);
+        while (!this->checkpoints.empty() && this->checkpoints.front().timeline_value <= current_gpu_timeline_value)
+        {
+            reclaimed_end = this->checkpoints.front().claimed_end;
+            this->checkpoints.pop_front();
+        }
+        if (timeline_value <= current_gpu_timeline_value)
         {
-            this->claimed_start = (this->claimed_start + live_allocations.front().size) % this->m_info.capacity;
-            this->claimed_size -= live_allocations.front().size;
-            live_allocations.pop_front();
+            reclaimed_end = end;
+            this->checkpoints.clear();
         }
+        else if (this->checkpoints.empty() || this->checkpoints.back().claimed_end < end)
+        {
+            // Remembered so that a later reclamation can release everything up to end once the gpu reaches timeline_value.
+            this->checkpoints.push_back(TimelineCheckpoint{.timeline_value = timeline_value, .claimed_end = end});
+        }
+        this->claimed_start.store(reclaimed_end, std::memory_order_release);
     }
 
     auto TransferMemoryPool::timeline_semaphore() -> TimelineSemaphore const &
@@ -165,6 +175,141 @@ namespace daxa
     {
         return this->m_buffer;
     }
+
+    BufferSubAllocator::BufferSubAllocator(BufferSubAllocatorInfo a_info)
+        : m_info{std::move(a_info)}
+    {
+        // Size classes and slabs must be powers of two, so that every block stays aligned to its size class.
+        this->m_info.min_allocation_size = std::bit_ceil(std::max(this->m_info.min_allocation_size, 1u));
+        this->m_info.max_allocation_size = std::bit_ceil(std::max(this->m_info.max_allocation_size, this->m_info.min_allocation_size));
+        this->m_info.slab_size = std::bit_ceil(std::max(this->m_info.slab_size, this->m_info.max_allocation_size));
+        u32 const size_class_count = static_cast<u32>(std::countr_zero(this->m_info.max_allocation_size) - std::countr_zero(this->m_info.min_allocation_size)) + 1u;
+        this->size_classes.resize(size_class_count);
+    }
+
+    BufferSubAllocator::BufferSubAllocator(BufferSubAllocator && other)
+    {
+        std::swap(this->m_info, other.m_info);
+        std::swap(this->slabs, other.slabs);
+        std::swap(this->size_classes, other.size_classes);
+    }
+
+    auto BufferSubAllocator::operator=(BufferSubAllocator && other) -> BufferSubAllocator &
+    {
+        this->destroy_slabs();
+        std::swap(this->m_info, other.m_info);
+        std::swap(this->slabs, other.slabs);
+        std::swap(this->size_classes, other.size_classes);
+        return *this;
+    }
+
+    BufferSubAllocator::~BufferSubAllocator()
+    {
+        this->destroy_slabs();
+    }
+
+    auto BufferSubAllocator::allocate(u32 size) -> std::optional<BufferSubAllocator::Allocation>
+    {
+        if (size > this->m_info.max_allocation_size)
+        {
+            return std::nullopt;
+        }
+        u32 const class_size = std::bit_ceil(std::max(size, this->m_info.min_allocation_size));
+        auto & size_class = this->size_classes[static_cast<usize>(std::countr_zero(class_size) - std::countr_zero(this->m_info.min_allocation_size))];
+
+        this->reclaim_pending_frees(size_class);
+        FreeBlock block = {};
+        if (!size_class.free_blocks.empty())
+        {
+            block = size_class.free_blocks.back();
+            size_class.free_blocks.pop_back();
+        }
+        else
+        {
+            if (size_class.bump_slab_index == ~0u || size_class.bump_offset + class_size > this->m_info.slab_size)
+            {
+                auto const slab_index = static_cast<u32>(this->slabs.size());
+                auto const slab_name = this->m_info.name + " slab " + std::to_string(slab_index);
+                BufferInfo const buffer_info = {
+                    .size = this->m_info.slab_size,
+                    .name = slab_name,
+                };
+                MemoryBlock memory_block = this->m_info.device.create_memory({
+                    .requirements = this->m_info.device.buffer_memory_requirements(buffer_info),
+                    .flags = MemoryFlagBits::NONE,
+                    .name = slab_name,
+                });
+                BufferId const buffer = this->m_info.device.create_buffer_from_memory_block({
+                    .buffer_info = buffer_info,
+                    .memory_block = memory_block,
+                    .offset = 0,
+                });
+                this->slabs.push_back(Slab{
+                    .memory_block = std::move(memory_block),
+                    .buffer = buffer,
+                    .device_address = this->m_info.device.device_address(buffer).value(),
+                });
+                size_class.bump_slab_index = slab_index;
+                size_class.bump_offset = 0;
+            }
+            block = FreeBlock{
+                .slab_index = size_class.bump_slab_index,
+                .offset = size_class.bump_offset,
+            };
+            size_class.bump_offset += class_size;
+        }
+
+        auto const & slab = this->slabs[block.slab_index];
+        return Allocation{
+            .buffer = slab.buffer,
+            .offset = block.offset,
+            .size = class_size,
+            .device_address = slab.device_address + block.offset,
+            .slab_index = block.slab_index,
+        };
+    }
+
+    void BufferSubAllocator::free(Allocation const & allocation)
+    {
+        auto & size_class = this->size_classes[static_cast<usize>(std::countr_zero(allocation.size) - std::countr_zero(this->m_info.min_allocation_size))];
+        size_class.pending_frees.push_back(PendingFree{
+            .submit_index = this->m_info.device.latest_submit_index(),
+            .block = FreeBlock{
+                .slab_index = allocation.slab_index,
+                .offset = allocation.offset,
+            },
+        });
+    }
+
+    void BufferSubAllocator::reclaim_pending_frees(SizeClass & size_class)
+    {
+        if (size_class.pending_frees.empty())
+        {
+            return;
+        }
+        u64 const oldest_pending_submit = this->m_info.device.oldest_pending_submit_index();
+        while (!size_class.pending_frees.empty() && size_class.pending_frees.front().submit_index < oldest_pending_submit)
+        {
+            size_class.free_blocks.push_back(size_class.pending_frees.front().block);
+            size_class.pending_frees.pop_front();
+        }
+    }
+
+    auto BufferSubAllocator::info() const -> BufferSubAllocatorInfo const &
+    {
+        return this->m_info;
+    }
+
+    void BufferSubAllocator::destroy_slabs()
+    {
+        // Destruction of the buffers is deferred by the device until all submits using them finished.
+        for (auto const & slab : this->slabs)
+        {
+            this->m_info.device.destroy_buffer(slab.buffer);
+        }
+        this->slabs.clear();
+        this->size_classes.clear();
+    }
 } // namespace daxa
 
 #endif
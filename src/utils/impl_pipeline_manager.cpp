@@ -127,6 +127,12 @@ static constexpr TBuiltInResource DAXA_DEFAULT_BUILTIN_RESOURCE = {
 
 // #include <re2/re2.h>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
 #include <utility>
 #include <sstream>
 #include <iostream>
@@ -247,9 +253,9 @@ namespace daxa
                 return nullptr;
             }
             auto header_name_str = std::string{header_name};
-            if (impl_pipeline_manager->virtual_files.contains(header_name_str))
+            if (impl_pipeline_manager->compile_virtual_files().contains(header_name_str))
             {
-                return process_include(Result{ShaderCode{impl_pipeline_manager->virtual_files.at(header_name_str).contents}}, header_name_str);
+                return process_include(Result{ShaderCode{impl_pipeline_manager->compile_virtual_files().at(header_name_str).contents}}, header_name_str);
             }
             auto result = impl_pipeline_manager->full_path_to_file(includer_name);
             if (result.is_err())
@@ -269,9 +275,9 @@ namespace daxa
                 return nullptr;
             }
             auto header_name_str = std::string{header_name};
-            if (impl_pipeline_manager->virtual_files.contains(header_name_str))
+            if (impl_pipeline_manager->compile_virtual_files().contains(header_name_str))
             {
-                return process_include(Result{ShaderCode{impl_pipeline_manager->virtual_files.at(header_name_str).contents}}, header_name_str);
+                return process_include(Result{ShaderCode{impl_pipeline_manager->compile_virtual_files().at(header_name_str).contents}}, header_name_str);
             }
             auto result = impl_pipeline_manager->full_path_to_file(header_name);
             if (result.is_err())
@@ -385,6 +391,36 @@ namespace daxa
         return impl.add_raster_pipeline(info);
     }
 
+    auto PipelineManager::add_ray_tracing_pipelines(std::span<RayTracingPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RayTracingPipeline>>>
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.add_ray_tracing_pipelines(infos);
+    }
+
+    auto PipelineManager::add_compute_pipelines(std::span<ComputePipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.add_compute_pipelines(infos);
+    }
+
+    auto PipelineManager::add_raster_pipelines(std::span<RasterPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.add_raster_pipelines(infos);
+    }
+
+    auto PipelineManager::add_compute_pipeline_variants(ComputePipelineCompileInfo const & info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.add_compute_pipeline_variants(info, variants);
+    }
+
+    auto PipelineManager::add_raster_pipeline_variants(RasterPipelineCompileInfo const & info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.add_raster_pipeline_variants(info, variants);
+    }
+
     void PipelineManager::remove_compute_pipeline(std::shared_ptr<ComputePipeline> const & pipeline)
     {
         auto & impl = *r_cast<ImplPipelineManager *>(this->object);
@@ -415,6 +451,24 @@ namespace daxa
         return impl.reload_all();
     }
 
+    void PipelineManager::save_pipeline_cache()
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        impl.save_pipeline_cache();
+    }
+
+    void PipelineManager::save_spirv_cache()
+    {
+        auto & impl = *r_cast<ImplPipelineManager *>(this->object);
+        impl.flush_shader_cache_archives();
+    }
+
+    auto PipelineManager::spirv_cache_statistics() const -> SpirvCacheStatistics
+    {
+        auto const & impl = *r_cast<ImplPipelineManager *>(this->object);
+        return impl.spirv_cache_statistics();
+    }
+
     auto PipelineManager::all_pipelines_valid() const -> bool
     {
         auto const & impl = *r_cast<ImplPipelineManager *>(this->object);
@@ -439,6 +493,11 @@ namespace daxa
         {
             this->info.shader_compile_options.enable_debug_info = {false};
         }
+        this->compile_thread_count = this->info.compile_thread_count;
+        if (this->compile_thread_count == 0)
+        {
+            this->compile_thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+        }
 
         {
             auto lock = std::lock_guard{glslang_init_mtx};
@@ -453,10 +512,28 @@ namespace daxa
             }
             ++pipeline_manager_count;
         }
+
+        load_pipeline_cache();
+
+        if (this->info.async_reload)
+        {
+            this->async_reload_thread = std::thread{&ImplPipelineManager::async_reload_watcher, this};
+        }
     }
 
     ImplPipelineManager::~ImplPipelineManager()
     {
+        if (this->async_reload_thread.joinable())
+        {
+            {
+                auto lock = std::lock_guard{async_reload_mtx};
+                async_reload_stop = true;
+            }
+            async_reload_cv.notify_one();
+            this->async_reload_thread.join();
+        }
+        save_pipeline_cache();
+        flush_shader_cache_archives();
 #if DAXA_BUILT_WITH_UTILS_PIPELINE_MANAGER_GLSLANG
         {
             auto lock = std::lock_guard{glslang_init_mtx};
@@ -545,6 +622,7 @@ namespace daxa
                     .create_flags = shader_compile_info.compile_options.create_flags.value_or(ShaderCreateFlagBits::NONE),
                     .required_subgroup_size =
                         shader_compile_info.compile_options.required_subgroup_size.has_value() ? Optional{shader_compile_info.compile_options.required_subgroup_size.value()} : daxa::None,
+                    .specialization_constants = {shader_compile_info.specialization_constants.data(), shader_compile_info.specialization_constants.size()},
                 });
                 if (shader_compile_info.compile_options.entry_point.has_value() && (shader_compile_info.compile_options.language != ShaderLanguage::SLANG))
                 {
@@ -595,24 +673,70 @@ namespace daxa
                 return Result<ComputePipelineState>(spirv_result.message());
             }
         }
+        (*pipe_result.pipeline_ptr) = instantiate_compute_pipeline(pipe_result.info, spirv_result.value());
+        return Result<ComputePipelineState>(std::move(pipe_result));
+    }
+
+    auto ImplPipelineManager::instantiate_compute_pipeline(ComputePipelineCompileInfo const & a_info, std::vector<u32> const & spirv) -> ComputePipeline
+    {
         char const * entry_point = "main";
         if (a_info.shader_info.compile_options.entry_point.has_value() && a_info.shader_info.compile_options.language != ShaderLanguage::SLANG)
         {
             entry_point = a_info.shader_info.compile_options.entry_point.value().c_str();
         }
-        (*pipe_result.pipeline_ptr) = this->info.device.create_compute_pipeline({
+        return this->info.device.create_compute_pipeline({
             .shader_info = {
-                .byte_code = spirv_result.value().data(),
-                .byte_code_size = static_cast<u32>(spirv_result.value().size()),
+                .byte_code = spirv.data(),
+                .byte_code_size = static_cast<u32>(spirv.size()),
                 .create_flags = a_info.shader_info.compile_options.create_flags.value_or(ShaderCreateFlagBits::NONE),
                 .required_subgroup_size =
                     a_info.shader_info.compile_options.required_subgroup_size.has_value() ? Optional{a_info.shader_info.compile_options.required_subgroup_size.value()} : daxa::None,
                 .entry_point = entry_point,
+                .specialization_constants = {a_info.shader_info.specialization_constants.data(), a_info.shader_info.specialization_constants.size()},
             },
             .push_constant_size = a_info.push_constant_size,
             .name = a_info.name.c_str(),
         });
-        return Result<ComputePipelineState>(std::move(pipe_result));
+    }
+
+    static auto raster_shader_compile_infos(RasterPipelineCompileInfo const & info) -> std::array<Optional<ShaderCompileInfo> const *, RASTER_SHADER_STAGE_COUNT>
+    {
+        return {
+            &info.vertex_shader_info,
+            &info.fragment_shader_info,
+            &info.tesselation_control_shader_info,
+            &info.tesselation_evaluation_shader_info,
+            &info.task_shader_info,
+            &info.mesh_shader_info,
+        };
+    }
+
+    static constexpr auto RASTER_SHADER_STAGES = std::array<ImplPipelineManager::ShaderStage, RASTER_SHADER_STAGE_COUNT>{
+        ImplPipelineManager::ShaderStage::VERT,
+        ImplPipelineManager::ShaderStage::FRAG,
+        ImplPipelineManager::ShaderStage::TESS_CONTROL,
+        ImplPipelineManager::ShaderStage::TESS_EVAL,
+        ImplPipelineManager::ShaderStage::TASK,
+        ImplPipelineManager::ShaderStage::MESH,
+    };
+
+    auto ImplPipelineManager::compile_raster_spirv(RasterPipelineCompileInfo const & a_info) -> Result<RasterPipelineSpirv>
+    {
+        auto stage_spirv = RasterPipelineSpirv{};
+        auto const shader_compile_infos = raster_shader_compile_infos(a_info);
+        for (usize stage_i = 0; stage_i < RASTER_SHADER_STAGE_COUNT; ++stage_i)
+        {
+            if (shader_compile_infos[stage_i]->has_value())
+            {
+                auto spv_result = get_spirv(shader_compile_infos[stage_i]->value(), a_info.name, RASTER_SHADER_STAGES[stage_i]);
+                if (spv_result.is_err())
+                {
+                    return Result<RasterPipelineSpirv>(spv_result.message());
+                }
+                stage_spirv[stage_i] = std::move(spv_result.value());
+            }
+        }
+        return Result<RasterPipelineSpirv>(std::move(stage_spirv));
     }
 
     auto ImplPipelineManager::create_raster_pipeline(RasterPipelineCompileInfo const & a_info) -> Result<RasterPipelineState>
@@ -632,6 +756,26 @@ namespace daxa
             .observed_hotload_files = {},
         };
         this->current_observed_hotload_files = &pipe_result.observed_hotload_files;
+        auto spirv_result = compile_raster_spirv(pipe_result.info);
+        if (spirv_result.is_err())
+        {
+            if (this->info.register_null_pipelines_when_first_compile_fails)
+            {
+                auto result = Result<RasterPipelineState>(pipe_result);
+                result.m = spirv_result.message();
+                return result;
+            }
+            else
+            {
+                return Result<RasterPipelineState>(spirv_result.message());
+            }
+        }
+        (*pipe_result.pipeline_ptr) = instantiate_raster_pipeline(pipe_result.info, spirv_result.value());
+        return Result<RasterPipelineState>(std::move(pipe_result));
+    }
+
+    auto ImplPipelineManager::instantiate_raster_pipeline(RasterPipelineCompileInfo const & a_info, RasterPipelineSpirv const & stage_spirv) -> RasterPipeline
+    {
         auto raster_pipeline_info = RasterPipelineInfo{
             .color_attachments = {a_info.color_attachments.data(), a_info.color_attachments.size()},
             .depth_test = a_info.depth_test,
@@ -640,164 +784,381 @@ namespace daxa
             .push_constant_size = a_info.push_constant_size,
             .name = a_info.name,
         };
-        auto vertex_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        auto fragment_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        auto tesselation_control_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        auto tesselation_evaluation_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        auto task_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        auto mesh_spirv_result = daxa::Result<std::vector<unsigned int>>("useless string");
-        using ElemT = std::tuple<Optional<ShaderCompileInfo> *, Optional<ShaderInfo> *, daxa::Result<std::vector<unsigned int>> *, ShaderStage>;
-        auto const result_shader_compile_infos = std::array<ElemT, 6>{
-            ElemT{&pipe_result.info.vertex_shader_info, &raster_pipeline_info.vertex_shader_info, &vertex_spirv_result, ShaderStage::VERT},
-            ElemT{&pipe_result.info.fragment_shader_info, &raster_pipeline_info.fragment_shader_info, &fragment_spirv_result, ShaderStage::FRAG},
-            ElemT{&pipe_result.info.tesselation_control_shader_info, &raster_pipeline_info.tesselation_control_shader_info, &tesselation_control_spirv_result, ShaderStage::TESS_CONTROL},
-            ElemT{&pipe_result.info.tesselation_evaluation_shader_info, &raster_pipeline_info.tesselation_evaluation_shader_info, &tesselation_evaluation_spirv_result, ShaderStage::TESS_EVAL},
-            ElemT{&pipe_result.info.task_shader_info, &raster_pipeline_info.task_shader_info, &task_spirv_result, ShaderStage::TASK},
-            ElemT{&pipe_result.info.mesh_shader_info, &raster_pipeline_info.mesh_shader_info, &mesh_spirv_result, ShaderStage::MESH},
+        auto const shader_compile_infos = raster_shader_compile_infos(a_info);
+        auto const final_shader_infos = std::array<Optional<ShaderInfo> *, RASTER_SHADER_STAGE_COUNT>{
+            &raster_pipeline_info.vertex_shader_info,
+            &raster_pipeline_info.fragment_shader_info,
+            &raster_pipeline_info.tesselation_control_shader_info,
+            &raster_pipeline_info.tesselation_evaluation_shader_info,
+            &raster_pipeline_info.task_shader_info,
+            &raster_pipeline_info.mesh_shader_info,
         };
-        for (auto [pipe_result_shader_info, final_shader_info, spv_result, stage] : result_shader_compile_infos)
+        for (usize stage_i = 0; stage_i < RASTER_SHADER_STAGE_COUNT; ++stage_i)
         {
-            if (pipe_result_shader_info->has_value())
+            if (!shader_compile_infos[stage_i]->has_value())
             {
-                *spv_result = get_spirv(pipe_result_shader_info->value(), pipe_result.info.name, stage);
-                if (spv_result->is_err())
-                {
-                    if (this->info.register_null_pipelines_when_first_compile_fails)
-                    {
-                        auto result = Result<RasterPipelineState>(pipe_result);
-                        result.m = spv_result->message();
-                        return result;
-                    }
-                    else
-                    {
-                        return Result<RasterPipelineState>(spv_result->message());
-                    }
-                }
-                *final_shader_info = daxa::ShaderInfo{
-                    .byte_code = spv_result->value().data(),
-                    .byte_code_size = static_cast<u32>(spv_result->value().size()),
-                    .create_flags = pipe_result_shader_info->value().compile_options.create_flags.value_or(ShaderCreateFlagBits::NONE),
-                    .required_subgroup_size =
-                        pipe_result_shader_info->value().compile_options.required_subgroup_size.has_value() ? Optional{pipe_result_shader_info->value().compile_options.required_subgroup_size.value()} : daxa::None,
-                };
-                if (pipe_result_shader_info->value().compile_options.language != ShaderLanguage::SLANG)
-                {
-                    final_shader_info->value().entry_point = {pipe_result_shader_info->value().compile_options.entry_point.value()};
-                }
+                continue;
+            }
+            auto const & shader_compile_info = shader_compile_infos[stage_i]->value();
+            auto & final_shader_info = *final_shader_infos[stage_i];
+            final_shader_info = daxa::ShaderInfo{
+                .byte_code = stage_spirv[stage_i].data(),
+                .byte_code_size = static_cast<u32>(stage_spirv[stage_i].size()),
+                .create_flags = shader_compile_info.compile_options.create_flags.value_or(ShaderCreateFlagBits::NONE),
+                .required_subgroup_size =
+                    shader_compile_info.compile_options.required_subgroup_size.has_value() ? Optional{shader_compile_info.compile_options.required_subgroup_size.value()} : daxa::None,
+                .specialization_constants = {shader_compile_info.specialization_constants.data(), shader_compile_info.specialization_constants.size()},
+            };
+            if (shader_compile_info.compile_options.language != ShaderLanguage::SLANG)
+            {
+                final_shader_info.value().entry_point = {shader_compile_info.compile_options.entry_point.value()};
             }
         }
-        (*pipe_result.pipeline_ptr) = this->info.device.create_raster_pipeline(raster_pipeline_info);
-        return Result<RasterPipelineState>(std::move(pipe_result));
+        return this->info.device.create_raster_pipeline(raster_pipeline_info);
     }
 
-    auto ImplPipelineManager::add_ray_tracing_pipeline(RayTracingPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RayTracingPipeline>>
+    static void inherit_compile_options(RayTracingPipelineCompileInfo & info, ShaderCompileOptions const & options)
     {
-        // DAXA_DBG_ASSERT_TRUE_M(!daxa::holds_alternative<daxa::Monostate>(a_info.shader_info.source), "must provide shader source");
-        auto modified_info = a_info;
-        for (auto & shader_compile_info : modified_info.ray_gen_infos)
-        {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+        for (auto * shader_compile_infos : std::array{
+                 &info.ray_gen_infos,
+                 &info.intersection_infos,
+                 &info.any_hit_infos,
+                 &info.callable_infos,
+                 &info.closest_hit_infos,
+                 &info.miss_hit_infos,
+             })
+        {
+            for (auto & shader_compile_info : *shader_compile_infos)
+            {
+                shader_compile_info.compile_options.inherit(options);
+            }
         }
-        for (auto & shader_compile_info : modified_info.intersection_infos)
+    }
+
+    static void inherit_compile_options(ComputePipelineCompileInfo & info, ShaderCompileOptions const & options)
+    {
+        DAXA_DBG_ASSERT_TRUE_M(!daxa::holds_alternative<daxa::Monostate>(info.shader_info.source), "must provide shader source");
+        info.shader_info.compile_options.inherit(options);
+    }
+
+    static void inherit_compile_options(RasterPipelineCompileInfo & info, ShaderCompileOptions const & options)
+    {
+        auto const shader_compile_infos = std::array<Optional<ShaderCompileInfo> *, 6>{
+            &info.vertex_shader_info,
+            &info.tesselation_control_shader_info,
+            &info.tesselation_evaluation_shader_info,
+            &info.fragment_shader_info,
+            &info.mesh_shader_info,
+            &info.task_shader_info,
+        };
+        for (auto * shader_compile_info : shader_compile_infos)
         {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+            if (shader_compile_info->has_value())
+            {
+                shader_compile_info->value().compile_options.inherit(options);
+            }
         }
-        for (auto & shader_compile_info : modified_info.any_hit_infos)
+    }
+
+    // Calls fn(i) for every i in [0, count) on up to thread_count threads, the calling thread included.
+    // The first exception thrown by fn is rethrown on the calling thread after all threads finished.
+    template <typename FnT>
+    static void parallel_for(u32 thread_count, usize count, FnT const & fn)
+    {
+        auto const worker_count = std::min(static_cast<usize>(thread_count), count);
+        if (worker_count <= 1)
         {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+            for (usize i = 0; i < count; ++i)
+            {
+                fn(i);
+            }
+            return;
         }
-        for (auto & shader_compile_info : modified_info.callable_infos)
+        auto next_index = std::atomic<usize>{0};
+        auto exception_mtx = std::mutex{};
+        auto first_exception = std::exception_ptr{};
+        auto worker = [&]()
+        {
+            for (usize i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1))
+            {
+                try
+                {
+                    fn(i);
+                }
+                catch (...)
+                {
+                    auto lock = std::lock_guard{exception_mtx};
+                    if (!first_exception)
+                    {
+                        first_exception = std::current_exception();
+                    }
+                }
+            }
+        };
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(worker_count - 1);
+        for (usize i = 0; i < worker_count - 1; ++i)
         {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+            threads.emplace_back(worker);
         }
-        for (auto & shader_compile_info : modified_info.closest_hit_infos)
+        worker();
+        for (auto & thread : threads)
         {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+            thread.join();
         }
-        for (auto & shader_compile_info : modified_info.miss_hit_infos)
+        if (first_exception)
         {
-            shader_compile_info.compile_options.inherit(this->info.shader_compile_options);
+            std::rethrow_exception(first_exception);
         }
+    }
 
-        auto pipe_result = create_ray_tracing_pipeline(modified_info);
+    template <typename PipeT, typename InfoT>
+    auto ImplPipelineManager::register_pipeline(std::vector<PipelineState<PipeT, InfoT>> & pipelines, Result<PipelineState<PipeT, InfoT>> && pipe_result) -> Result<std::shared_ptr<PipeT>>
+    {
         if (pipe_result.is_err())
         {
-            return Result<std::shared_ptr<RayTracingPipeline>>(pipe_result.m);
+            return Result<std::shared_ptr<PipeT>>(pipe_result.m);
         }
-        this->ray_tracing_pipelines.push_back(pipe_result.value());
+        pipelines.push_back(pipe_result.value());
         if (this->info.register_null_pipelines_when_first_compile_fails)
         {
-            auto result = Result<std::shared_ptr<RayTracingPipeline>>(std::move(pipe_result.value().pipeline_ptr));
+            auto result = Result<std::shared_ptr<PipeT>>(std::move(pipe_result.value().pipeline_ptr));
             result.m = std::move(pipe_result.m);
             return result;
         }
         else
         {
-            return Result<std::shared_ptr<RayTracingPipeline>>(std::move(pipe_result.value().pipeline_ptr));
+            return Result<std::shared_ptr<PipeT>>(std::move(pipe_result.value().pipeline_ptr));
         }
     }
 
+    auto ImplPipelineManager::add_ray_tracing_pipeline(RayTracingPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RayTracingPipeline>>
+    {
+        return std::move(add_ray_tracing_pipelines({&a_info, 1}).front());
+    }
+
     auto ImplPipelineManager::add_compute_pipeline(ComputePipelineCompileInfo const & a_info) -> Result<std::shared_ptr<ComputePipeline>>
     {
-        DAXA_DBG_ASSERT_TRUE_M(!daxa::holds_alternative<daxa::Monostate>(a_info.shader_info.source), "must provide shader source");
-        auto modified_info = a_info;
-        modified_info.shader_info.compile_options.inherit(this->info.shader_compile_options);
-        auto pipe_result = create_compute_pipeline(modified_info);
-        if (pipe_result.is_err())
+        return std::move(add_compute_pipelines({&a_info, 1}).front());
+    }
+
+    auto ImplPipelineManager::add_raster_pipeline(RasterPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RasterPipeline>>
+    {
+        return std::move(add_raster_pipelines({&a_info, 1}).front());
+    }
+
+    auto ImplPipelineManager::add_ray_tracing_pipelines(std::span<RayTracingPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RayTracingPipeline>>>
+    {
+        auto pipe_results = std::vector<Result<RayTracingPipelineState>>(infos.size(), Result<RayTracingPipelineState>(std::string_view{"pipeline was not compiled"}));
         {
-            return Result<std::shared_ptr<ComputePipeline>>(pipe_result.m);
+            auto lock = std::shared_lock{pipelines_mtx};
+            parallel_for(
+                this->compile_thread_count, infos.size(),
+                [&](usize i)
+                {
+                    auto modified_info = infos[i];
+                    inherit_compile_options(modified_info, this->info.shader_compile_options);
+                    pipe_results[i] = create_ray_tracing_pipeline(modified_info);
+                });
         }
-        this->compute_pipelines.push_back(pipe_result.value());
-        if (this->info.register_null_pipelines_when_first_compile_fails)
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto ret = std::vector<Result<std::shared_ptr<RayTracingPipeline>>>{};
+        ret.reserve(infos.size());
+        for (auto & pipe_result : pipe_results)
         {
-            auto result = Result<std::shared_ptr<ComputePipeline>>(std::move(pipe_result.value().pipeline_ptr));
-            result.m = std::move(pipe_result.m);
-            return result;
+            ret.push_back(register_pipeline(this->ray_tracing_pipelines, std::move(pipe_result)));
         }
-        else
+        return ret;
+    }
+
+    auto ImplPipelineManager::add_compute_pipelines(std::span<ComputePipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>
+    {
+        auto pipe_results = std::vector<Result<ComputePipelineState>>(infos.size(), Result<ComputePipelineState>(std::string_view{"pipeline was not compiled"}));
         {
-            return Result<std::shared_ptr<ComputePipeline>>(std::move(pipe_result.value().pipeline_ptr));
+            auto lock = std::shared_lock{pipelines_mtx};
+            parallel_for(
+                this->compile_thread_count, infos.size(),
+                [&](usize i)
+                {
+                    auto modified_info = infos[i];
+                    inherit_compile_options(modified_info, this->info.shader_compile_options);
+                    pipe_results[i] = create_compute_pipeline(modified_info);
+                });
+        }
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto ret = std::vector<Result<std::shared_ptr<ComputePipeline>>>{};
+        ret.reserve(infos.size());
+        for (auto & pipe_result : pipe_results)
+        {
+            ret.push_back(register_pipeline(this->compute_pipelines, std::move(pipe_result)));
         }
+        return ret;
     }
 
-    auto ImplPipelineManager::add_raster_pipeline(RasterPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RasterPipeline>>
+    auto ImplPipelineManager::add_raster_pipelines(std::span<RasterPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>
+    {
+        auto pipe_results = std::vector<Result<RasterPipelineState>>(infos.size(), Result<RasterPipelineState>(std::string_view{"pipeline was not compiled"}));
+        {
+            auto lock = std::shared_lock{pipelines_mtx};
+            parallel_for(
+                this->compile_thread_count, infos.size(),
+                [&](usize i)
+                {
+                    auto modified_info = infos[i];
+                    inherit_compile_options(modified_info, this->info.shader_compile_options);
+                    pipe_results[i] = create_raster_pipeline(modified_info);
+                });
+        }
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto ret = std::vector<Result<std::shared_ptr<RasterPipeline>>>{};
+        ret.reserve(infos.size());
+        for (auto & pipe_result : pipe_results)
+        {
+            ret.push_back(register_pipeline(this->raster_pipelines, std::move(pipe_result)));
+        }
+        return ret;
+    }
+
+    static auto check_push_constant_size(u32 push_constant_size) -> std::optional<std::string>
+    {
+        if (push_constant_size > MAX_PUSH_CONSTANT_BYTE_SIZE)
+        {
+            return std::string("push constant size of ") + std::to_string(push_constant_size) + std::string(" exceeds the maximum size of ") + std::to_string(MAX_PUSH_CONSTANT_BYTE_SIZE);
+        }
+        if (push_constant_size % 4 != 0)
+        {
+            return std::string("push constant size of ") + std::to_string(push_constant_size) + std::string(" is not a multiple of 4(bytes)");
+        }
+        return std::nullopt;
+    }
+
+    static void apply_variant(ShaderCompileInfo & shader_compile_info, PipelineVariantInfo const & variant)
+    {
+        shader_compile_info.specialization_constants.insert(shader_compile_info.specialization_constants.end(), variant.specialization_constants.begin(), variant.specialization_constants.end());
+    }
+
+    auto ImplPipelineManager::add_compute_pipeline_variants(ComputePipelineCompileInfo const & a_info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>
     {
         auto modified_info = a_info;
-        auto const modified_shader_compile_infos = std::array<Optional<ShaderCompileInfo> *, 6>{
-            &modified_info.vertex_shader_info,
-            &modified_info.tesselation_control_shader_info,
-            &modified_info.tesselation_evaluation_shader_info,
-            &modified_info.fragment_shader_info,
-            &modified_info.mesh_shader_info,
-            &modified_info.task_shader_info,
-        };
-        for (auto * shader_compile_info : modified_shader_compile_infos)
+        inherit_compile_options(modified_info, this->info.shader_compile_options);
+        if (auto error = check_push_constant_size(modified_info.push_constant_size); error.has_value())
         {
-            if (shader_compile_info->has_value())
-            {
-                shader_compile_info->value().compile_options.inherit(this->info.shader_compile_options);
-            }
+            return std::vector<Result<std::shared_ptr<ComputePipeline>>>(variants.size(), Result<std::shared_ptr<ComputePipeline>>(error.value()));
         }
-        auto pipe_result = create_raster_pipeline(modified_info);
-        if (pipe_result.is_err())
+        auto pipe_results = std::vector<Result<ComputePipelineState>>(variants.size(), Result<ComputePipelineState>(std::string_view{"pipeline was not compiled"}));
         {
-            return Result<std::shared_ptr<RasterPipeline>>(pipe_result.m);
+            auto lock = std::shared_lock{pipelines_mtx};
+            auto observed_hotload_files = ShaderFileTimeSet{};
+            this->current_observed_hotload_files = &observed_hotload_files;
+            auto const spirv_result = get_spirv(modified_info.shader_info, modified_info.name, ShaderStage::COMP);
+            parallel_for(
+                this->compile_thread_count, variants.size(),
+                [&](usize i)
+                {
+                    auto pipe_result = ComputePipelineState{
+                        .pipeline_ptr = std::make_shared<ComputePipeline>(),
+                        .info = modified_info,
+                        .last_hotload_time = std::chrono::file_clock::now(),
+                        .observed_hotload_files = observed_hotload_files,
+                    };
+                    apply_variant(pipe_result.info.shader_info, variants[i]);
+                    if (!variants[i].name.empty())
+                    {
+                        pipe_result.info.name = variants[i].name;
+                    }
+                    if (spirv_result.is_err())
+                    {
+                        pipe_results[i] = Result<ComputePipelineState>(spirv_result.message());
+                        if (this->info.register_null_pipelines_when_first_compile_fails)
+                        {
+                            pipe_results[i] = Result<ComputePipelineState>(pipe_result);
+                            pipe_results[i].m = spirv_result.message();
+                        }
+                        return;
+                    }
+                    (*pipe_result.pipeline_ptr) = instantiate_compute_pipeline(pipe_result.info, spirv_result.value());
+                    pipe_results[i] = Result<ComputePipelineState>(std::move(pipe_result));
+                });
         }
-        this->raster_pipelines.push_back(pipe_result.value());
-        if (this->info.register_null_pipelines_when_first_compile_fails)
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto ret = std::vector<Result<std::shared_ptr<ComputePipeline>>>{};
+        ret.reserve(variants.size());
+        for (auto & pipe_result : pipe_results)
         {
-            auto result = Result<std::shared_ptr<RasterPipeline>>(std::move(pipe_result.value().pipeline_ptr));
-            result.m = std::move(pipe_result.m);
-            return result;
+            ret.push_back(register_pipeline(this->compute_pipelines, std::move(pipe_result)));
         }
-        else
+        return ret;
+    }
+
+    auto ImplPipelineManager::add_raster_pipeline_variants(RasterPipelineCompileInfo const & a_info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>
+    {
+        auto modified_info = a_info;
+        inherit_compile_options(modified_info, this->info.shader_compile_options);
+        if (auto error = check_push_constant_size(modified_info.push_constant_size); error.has_value())
         {
-            return Result<std::shared_ptr<RasterPipeline>>(std::move(pipe_result.value().pipeline_ptr));
+            return std::vector<Result<std::shared_ptr<RasterPipeline>>>(variants.size(), Result<std::shared_ptr<RasterPipeline>>(error.value()));
+        }
+        auto pipe_results = std::vector<Result<RasterPipelineState>>(variants.size(), Result<RasterPipelineState>(std::string_view{"pipeline was not compiled"}));
+        {
+            auto lock = std::shared_lock{pipelines_mtx};
+            auto observed_hotload_files = ShaderFileTimeSet{};
+            this->current_observed_hotload_files = &observed_hotload_files;
+            auto const spirv_result = compile_raster_spirv(modified_info);
+            parallel_for(
+                this->compile_thread_count, variants.size(),
+                [&](usize i)
+                {
+                    auto pipe_result = RasterPipelineState{
+                        .pipeline_ptr = std::make_shared<RasterPipeline>(),
+                        .info = modified_info,
+                        .last_hotload_time = std::chrono::file_clock::now(),
+                        .observed_hotload_files = observed_hotload_files,
+                    };
+                    for (auto * shader_compile_info : std::array{
+                             &pipe_result.info.vertex_shader_info,
+                             &pipe_result.info.fragment_shader_info,
+                             &pipe_result.info.tesselation_control_shader_info,
+                             &pipe_result.info.tesselation_evaluation_shader_info,
+                             &pipe_result.info.task_shader_info,
+                             &pipe_result.info.mesh_shader_info,
+                         })
+                    {
+                        if (shader_compile_info->has_value())
+                        {
+                            apply_variant(shader_compile_info->value(), variants[i]);
+                        }
+                    }
+                    if (!variants[i].name.empty())
+                    {
+                        pipe_result.info.name = variants[i].name;
+                    }
+                    if (spirv_result.is_err())
+                    {
+                        pipe_results[i] = Result<RasterPipelineState>(spirv_result.message());
+                        if (this->info.register_null_pipelines_when_first_compile_fails)
+                        {
+                            pipe_results[i] = Result<RasterPipelineState>(pipe_result);
+                            pipe_results[i].m = spirv_result.message();
+                        }
+                        return;
+                    }
+                    (*pipe_result.pipeline_ptr) = instantiate_raster_pipeline(pipe_result.info, spirv_result.value());
+                    pipe_results[i] = Result<RasterPipelineState>(std::move(pipe_result));
+                });
         }
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto ret = std::vector<Result<std::shared_ptr<RasterPipeline>>>{};
+        ret.reserve(variants.size());
+        for (auto & pipe_result : pipe_results)
+        {
+            ret.push_back(register_pipeline(this->raster_pipelines, std::move(pipe_result)));
+        }
+        return ret;
     }
 
     void ImplPipelineManager::remove_ray_tracing_pipeline(std::shared_ptr<RayTracingPipeline> const & pipeline)
     {
+        auto lock = std::unique_lock{pipelines_mtx};
         auto pipeline_iter = std::find_if(
             this->ray_tracing_pipelines.begin(),
             this->ray_tracing_pipelines.end(),
@@ -814,6 +1175,7 @@ namespace daxa
 
     void ImplPipelineManager::remove_compute_pipeline(std::shared_ptr<ComputePipeline> const & pipeline)
     {
+        auto lock = std::unique_lock{pipelines_mtx};
         auto pipeline_iter = std::find_if(
             this->compute_pipelines.begin(),
             this->compute_pipelines.end(),
@@ -830,6 +1192,7 @@ namespace daxa
 
     void ImplPipelineManager::remove_raster_pipeline(std::shared_ptr<RasterPipeline> const & pipeline)
     {
+        auto lock = std::unique_lock{pipelines_mtx};
         auto pipeline_iter = std::find_if(
             this->raster_pipelines.begin(),
             this->raster_pipelines.end(),
@@ -920,6 +1283,7 @@ namespace daxa
 
     void ImplPipelineManager::add_virtual_file(VirtualFileInfo const & virtual_info)
     {
+        auto lock = std::unique_lock{pipelines_mtx};
         virtual_files[virtual_info.name] = VirtualFileState{
             .contents = virtual_info.contents,
             .timestamp = std::chrono::file_clock::now(),
@@ -932,104 +1296,192 @@ namespace daxa
         shader_preprocess(virtual_file.contents, virtual_info.name);
     }
 
-    auto ImplPipelineManager::reload_all() -> PipelineReloadResult
+    auto ImplPipelineManager::collect_changed_pipelines() -> PipelineReloadBatch
     {
-        bool reloaded = false;
-
         // Optimization for caching the write times so that multiple pipelines don't check the
         // filesystem for the same file's write-time. Filesystem checks are really slow...
         auto lookup_table = FileWriteTimeLookupTable{};
 
-        for (auto & [pipeline, compile_info, last_hotload_time, observed_hotload_files] : this->compute_pipelines)
+        auto batch = PipelineReloadBatch{};
+        for (auto & state : this->compute_pipelines)
         {
-            if (check_if_sources_changed(last_hotload_time, observed_hotload_files, virtual_files, lookup_table))
+            if (check_if_sources_changed(state.last_hotload_time, state.observed_hotload_files, virtual_files, lookup_table))
             {
-                reloaded = true;
-                auto new_pipeline = create_compute_pipeline(compile_info);
-                bool is_valid = true;
-                if (this->info.register_null_pipelines_when_first_compile_fails)
-                {
-                    is_valid = new_pipeline.is_ok() && new_pipeline.value().pipeline_ptr->is_valid();
-                }
-                else
-                {
-                    is_valid = new_pipeline.is_ok();
-                }
-                if (is_valid)
-                {
-                    *pipeline = std::move(*new_pipeline.value().pipeline_ptr);
-                }
-                else
-                {
-                    return PipelineReloadError{new_pipeline.m};
-                }
+                batch.compute_pipelines.push_back({.pipeline_ptr = state.pipeline_ptr, .info = state.info});
+            }
+        }
+        for (auto & state : this->raster_pipelines)
+        {
+            if (check_if_sources_changed(state.last_hotload_time, state.observed_hotload_files, virtual_files, lookup_table))
+            {
+                batch.raster_pipelines.push_back({.pipeline_ptr = state.pipeline_ptr, .info = state.info});
             }
         }
+        for (auto & state : this->ray_tracing_pipelines)
+        {
+            if (check_if_sources_changed(state.last_hotload_time, state.observed_hotload_files, virtual_files, lookup_table))
+            {
+                batch.ray_tracing_pipelines.push_back({.pipeline_ptr = state.pipeline_ptr, .info = state.info});
+            }
+        }
+        return batch;
+    }
+
+    void ImplPipelineManager::compile_reload_batch(PipelineReloadBatch & batch, VirtualFileSet const & batch_virtual_files)
+    {
+        auto compile_reload = [&](usize i)
+        {
+            if (i < batch.compute_pipelines.size())
+            {
+                auto & reload = batch.compute_pipelines[i];
+                reload.new_pipeline = create_compute_pipeline(reload.info);
+                return;
+            }
+            i -= batch.compute_pipelines.size();
+            if (i < batch.raster_pipelines.size())
+            {
+                auto & reload = batch.raster_pipelines[i];
+                reload.new_pipeline = create_raster_pipeline(reload.info);
+                return;
+            }
+            i -= batch.raster_pipelines.size();
+            auto & reload = batch.ray_tracing_pipelines[i];
+            reload.new_pipeline = create_ray_tracing_pipeline(reload.info);
+        };
+        parallel_for(
+            this->compile_thread_count, batch.size(),
+            [&](usize i)
+            {
+                current_virtual_files = &batch_virtual_files;
+                compile_reload(i);
+                current_virtual_files = nullptr;
+            });
+    }
 
-        for (auto & [pipeline, compile_info, last_hotload_time, observed_hotload_files] : this->raster_pipelines)
+    auto ImplPipelineManager::apply_reload_batch(PipelineReloadBatch & batch) -> PipelineReloadResult
+    {
+        if (batch.size() == 0)
         {
-            if (check_if_sources_changed(last_hotload_time, observed_hotload_files, virtual_files, lookup_table))
+            return NoPipelineChanged{};
+        }
+        // All successfully recompiled pipelines are swapped in, the first failure is reported.
+        // Pipelines removed from the manager since the batch was collected are skipped.
+        auto first_error = std::optional<std::string>{};
+        auto apply_reloads = [&](auto & reloads, auto const & states)
+        {
+            for (auto & reload : reloads)
             {
-                reloaded = true;
-                auto new_pipeline = create_raster_pipeline(compile_info);
+                bool const still_managed = std::find_if(
+                                               states.begin(), states.end(),
+                                               [&](auto const & state)
+                                               { return state.pipeline_ptr == reload.pipeline_ptr; }) != states.end();
+                if (!still_managed)
+                {
+                    continue;
+                }
                 bool is_valid = true;
                 if (this->info.register_null_pipelines_when_first_compile_fails)
                 {
-                    is_valid = new_pipeline.is_ok() && new_pipeline.value().pipeline_ptr->is_valid();
+                    is_valid = reload.new_pipeline.is_ok() && reload.new_pipeline.value().pipeline_ptr->is_valid();
                 }
                 else
                 {
-                    is_valid = new_pipeline.is_ok();
+                    is_valid = reload.new_pipeline.is_ok();
                 }
                 if (is_valid)
                 {
-                    *pipeline = std::move(*new_pipeline.value().pipeline_ptr);
+                    *reload.pipeline_ptr = std::move(*reload.new_pipeline.value().pipeline_ptr);
                 }
-                else
+                else if (!first_error.has_value())
                 {
-                    return PipelineReloadError{new_pipeline.m};
+                    first_error = reload.new_pipeline.m;
                 }
             }
+        };
+        apply_reloads(batch.compute_pipelines, this->compute_pipelines);
+        apply_reloads(batch.raster_pipelines, this->raster_pipelines);
+        apply_reloads(batch.ray_tracing_pipelines, this->ray_tracing_pipelines);
+
+        if (first_error.has_value())
+        {
+            return PipelineReloadError{first_error.value()};
         }
+        return PipelineReloadSuccess{};
+    }
 
-        for (auto & [pipeline, compile_info, last_hotload_time, observed_hotload_files] : this->ray_tracing_pipelines)
+    auto ImplPipelineManager::reload_all() -> PipelineReloadResult
+    {
+        if (this->info.async_reload)
         {
-            if (check_if_sources_changed(last_hotload_time, observed_hotload_files, virtual_files, lookup_table))
+            // The watcher thread detects changes and compiles, here the finished pipelines are only swapped in.
+            if (!async_reload_has_finished_batches.load(std::memory_order_acquire))
             {
-                reloaded = true;
-                auto new_pipeline = create_ray_tracing_pipeline(compile_info);
-                bool is_valid = true;
-                if (this->info.register_null_pipelines_when_first_compile_fails)
-                {
-                    is_valid = new_pipeline.is_ok() && new_pipeline.value().pipeline_ptr->is_valid();
-                }
-                else
+                return NoPipelineChanged{};
+            }
+            auto finished_batches = std::vector<PipelineReloadBatch>{};
+            {
+                auto lock = std::lock_guard{async_reload_mtx};
+                std::swap(finished_batches, async_reload_finished_batches);
+                async_reload_has_finished_batches.store(false, std::memory_order_relaxed);
+            }
+            auto lock = std::unique_lock{pipelines_mtx};
+            PipelineReloadResult result = NoPipelineChanged{};
+            for (auto & batch : finished_batches)
+            {
+                auto batch_result = apply_reload_batch(batch);
+                if (!daxa::holds_alternative<PipelineReloadError>(result) && !daxa::holds_alternative<NoPipelineChanged>(batch_result))
                 {
-                    is_valid = new_pipeline.is_ok();
+                    result = std::move(batch_result);
                 }
-                if (is_valid)
+            }
+            return result;
+        }
+
+        // Change detection runs serially on the calling thread.
+        // Only the recompilation of the changed pipelines is spread over the compile threads.
+        auto lock = std::unique_lock{pipelines_mtx};
+        auto batch = collect_changed_pipelines();
+        compile_reload_batch(batch, this->virtual_files);
+        return apply_reload_batch(batch);
+    }
+
+    void ImplPipelineManager::async_reload_watcher()
+    {
+        while (true)
+        {
+            {
+                auto lock = std::unique_lock{async_reload_mtx};
+                async_reload_cv.wait_for(lock, this->info.async_reload_poll_interval, [&]
+                                         { return async_reload_stop; });
+                if (async_reload_stop)
                 {
-                    *pipeline = std::move(*new_pipeline.value().pipeline_ptr);
+                    return;
                 }
-                else
+            }
+            // The pipeline infos and virtual files are copied out, so compiling holds no lock and never stalls reload_all or adding pipelines.
+            auto batch = PipelineReloadBatch{};
+            {
+                auto lock = std::unique_lock{pipelines_mtx};
+                batch = collect_changed_pipelines();
+                if (batch.size() != 0)
                 {
-                    return PipelineReloadError{new_pipeline.m};
+                    batch.virtual_files = virtual_files;
                 }
             }
-        }
-
-        if (reloaded)
-        {
-            return PipelineReloadSuccess{};
-        }
-        else
-        {
-            return NoPipelineChanged{};
+            if (batch.size() == 0)
+            {
+                continue;
+            }
+            compile_reload_batch(batch, batch.virtual_files);
+            auto lock = std::lock_guard{async_reload_mtx};
+            async_reload_finished_batches.push_back(std::move(batch));
+            async_reload_has_finished_batches.store(true, std::memory_order_release);
         }
     }
 
     auto ImplPipelineManager::all_pipelines_valid() const -> bool
     {
+        auto lock = std::shared_lock{pipelines_mtx};
         for (RasterPipelineState const & raster_pipeline_state : this->raster_pipelines)
         {
             if (!raster_pipeline_state.pipeline_ptr->is_valid())
@@ -1056,176 +1508,561 @@ namespace daxa
         return true;
     }
 
-    static auto hash_shader_info(std::string const & source_string, ShaderCompileOptions const & compile_options, ImplPipelineManager::ShaderStage shader_stage) -> uint64_t
+    // MurmurHash3 x64 128, stable across platforms and standard libraries unlike std::hash.
+    static auto hash_128(std::string_view data) -> ShaderCacheHash
     {
-        auto result = uint64_t{};
+        auto rotl = [](u64 x, i32 r) -> u64
+        { return (x << r) | (x >> (64 - r)); };
+        auto fmix = [](u64 k) -> u64
+        {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdull;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ull;
+            k ^= k >> 33;
+            return k;
+        };
+        auto load_u64 = [](char const * ptr) -> u64
+        {
+            u64 ret = {};
+            std::memcpy(&ret, ptr, sizeof(u64));
+            return ret;
+        };
+        static constexpr u64 C1 = 0x87c37b91114253d5ull;
+        static constexpr u64 C2 = 0x4cf5ad432745937full;
+
+        usize const block_count = data.size() / 16;
+        u64 h1 = {};
+        u64 h2 = {};
+        for (usize i = 0; i < block_count; ++i)
+        {
+            u64 k1 = load_u64(data.data() + i * 16);
+            u64 k2 = load_u64(data.data() + i * 16 + 8);
+            k1 *= C1;
+            k1 = rotl(k1, 31);
+            k1 *= C2;
+            h1 ^= k1;
+            h1 = rotl(h1, 27);
+            h1 += h2;
+            h1 = h1 * 5 + 0x52dce729;
+            k2 *= C2;
+            k2 = rotl(k2, 33);
+            k2 *= C1;
+            h2 ^= k2;
+            h2 = rotl(h2, 31);
+            h2 += h1;
+            h2 = h2 * 5 + 0x38495ab5;
+        }
+
+        auto const * tail = reinterpret_cast<u8 const *>(data.data() + block_count * 16);
+        usize const tail_size = data.size() & 15;
+        u64 k1 = {};
+        u64 k2 = {};
+        for (usize i = tail_size; i > 8; --i)
+        {
+            k2 ^= static_cast<u64>(tail[i - 1]) << ((i - 9) * 8);
+        }
+        for (usize i = std::min(tail_size, usize{8}); i > 0; --i)
+        {
+            k1 ^= static_cast<u64>(tail[i - 1]) << ((i - 1) * 8);
+        }
+        if (tail_size > 8)
+        {
+            k2 *= C2;
+            k2 = rotl(k2, 33);
+            k2 *= C1;
+            h2 ^= k2;
+        }
+        if (tail_size > 0)
+        {
+            k1 *= C1;
+            k1 = rotl(k1, 31);
+            k1 *= C2;
+            h1 ^= k1;
+        }
+
+        h1 ^= static_cast<u64>(data.size());
+        h2 ^= static_cast<u64>(data.size());
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix(h1);
+        h2 = fmix(h2);
+        h1 += h2;
+        h2 += h1;
+        return ShaderCacheHash{.low = h1, .high = h2};
+    }
 
-        auto hash_combine = [](uint64_t h1, uint64_t h2) -> uint64_t
+    static auto hash_shader_info(std::string const & source_string, ShaderCompileOptions const & compile_options, ImplPipelineManager::ShaderStage shader_stage) -> ShaderCacheHash
+    {
+        // All fields are length prefixed into one key string, so that no two different inputs produce the same key string.
+        auto key = std::string{};
+        auto append = [&](std::string_view str)
+        {
+            auto const size = static_cast<u64>(str.size());
+            key.append(reinterpret_cast<char const *>(&size), sizeof(size));
+            key.append(str);
+        };
+        auto append_u32 = [&](u32 value)
+        {
+            key.append(reinterpret_cast<char const *>(&value), sizeof(value));
+        };
+        // Lists are prefixed by their element count.
+        auto append_count = [&](usize count)
         {
-            return h1 ^ (h2 << 1);
+            auto const count_u64 = static_cast<u64>(count);
+            key.append(reinterpret_cast<char const *>(&count_u64), sizeof(count_u64));
         };
 
-        auto hash_shader_compile_options = [&hash_combine](ShaderCompileOptions const & options) -> uint64_t
+        append(source_string);
+        append(compile_options.entry_point.value_or(""));
+        append_count(compile_options.root_paths.size());
+        for (auto const & path : compile_options.root_paths)
         {
-            auto result = uint64_t{};
-            if (options.entry_point.has_value())
-            {
-                result = hash_combine(result, std::hash<std::string>{}(options.entry_point.value()));
-            }
-            for (auto const & path : options.root_paths)
-            {
-                result = hash_combine(result, std::hash<std::string>{}(path.string()));
-            }
-            if (options.language.has_value())
-            {
-                result = hash_combine(result, std::hash<uint32_t>{}(static_cast<uint32_t>(options.language.value())));
-            }
-            for (auto const & define : options.defines)
+            append(path.string());
+        }
+        append_u32(compile_options.language.has_value() ? static_cast<u32>(compile_options.language.value()) : ~0u);
+        append_count(compile_options.defines.size());
+        for (auto const & define : compile_options.defines)
+        {
+            append(define.name);
+            append(define.value);
+        }
+        append_u32(compile_options.enable_debug_info.has_value() ? static_cast<u32>(compile_options.enable_debug_info.value()) : ~0u);
+        append_u32(static_cast<u32>(shader_stage));
+        return hash_128(key);
+    }
+
+    void ImplPipelineManager::load_pipeline_cache()
+    {
+        if (this->info.pipeline_cache_path.empty())
+        {
+            return;
+        }
+        auto in_file = std::ifstream{this->info.pipeline_cache_path, std::ios::binary | std::ios::ate};
+        if (!in_file.good())
+        {
+            return;
+        }
+        auto data = std::vector<std::byte>(static_cast<usize>(in_file.tellg()));
+        in_file.seekg(0);
+        in_file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!in_file.good())
+        {
+            return;
+        }
+        // Incompatible data (other device, driver or daxa version) is ignored, the cache is simply rebuilt and overwritten on save.
+        [[maybe_unused]] bool const loaded = this->info.device.load_pipeline_cache_data(data);
+    }
+
+    void ImplPipelineManager::save_pipeline_cache()
+    {
+        if (this->info.pipeline_cache_path.empty())
+        {
+            return;
+        }
+        // Called from the destructor, so failures are not reported, the cache is simply not saved.
+        // Uses the c api to get results instead of exceptions.
+        daxa_Device const device = this->info.device.get();
+        auto data = std::vector<std::byte>{};
+        daxa_Result result = DAXA_RESULT_INCOMPLETE;
+        while (result == DAXA_RESULT_INCOMPLETE)
+        {
+            u64 size = {};
+            if (daxa_dvc_get_pipeline_cache_data(device, &size, nullptr) != DAXA_RESULT_SUCCESS)
             {
-                result = hash_combine(result, std::hash<std::string>{}(define.name));
-                result = hash_combine(result, std::hash<std::string>{}(define.value));
+                return;
             }
-            if (options.enable_debug_info.has_value())
+            data.resize(size);
+            result = daxa_dvc_get_pipeline_cache_data(device, &size, data.data());
+            data.resize(size);
+        }
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            return;
+        }
+        if (this->info.pipeline_cache_path.has_parent_path())
+        {
+            std::error_code error_code = {};
+            std::filesystem::create_directories(this->info.pipeline_cache_path.parent_path(), error_code);
+            if (error_code)
             {
-                result = hash_combine(result, std::hash<uint32_t>{}(static_cast<uint32_t>(options.enable_debug_info.value())));
+                return;
             }
-            return result;
-        };
-
-        result = hash_combine(result, std::hash<std::string>{}(source_string));
-        result = hash_combine(result, hash_shader_compile_options(compile_options));
-        result = hash_combine(result, std::hash<uint32_t>{}(static_cast<uint32_t>(shader_stage)));
-
-        return result;
+        }
+        auto out_file = std::ofstream{this->info.pipeline_cache_path, std::ios::binary | std::ios::trunc};
+        out_file.write(reinterpret_cast<char const *>(data.data()), static_cast<std::streamsize>(data.size()));
     }
 
     static constexpr auto CACHE_FILE_MAGIC_NUMBER = std::bit_cast<uint64_t>(std::to_array("daxpipe"));
-    static constexpr auto CACHE_FILE_VERSION = uint64_t{2};
+    static constexpr auto CACHE_FILE_VERSION = uint64_t{3};
+    static constexpr auto CACHE_FILE_NAME = std::string_view{"spirv_cache.bin"};
 
+    // Layout of the archive file:
+    // ShaderCacheFileHeader, then per entry:
+    // ShaderCacheFileEntryHeader, per dependency: ShaderCacheFileDependencyHeader followed by the path string, then the spirv.
     struct ShaderCacheFileHeader
     {
         uint64_t magic_number;
         uint64_t version;
+        uint64_t entry_n;
+        uint64_t use_counter;
+    };
+
+    struct ShaderCacheFileEntryHeader
+    {
+        ShaderCacheHash key;
+        uint64_t last_use;
         uint64_t dependency_n;
         uint64_t spirv_size;
     };
 
-    void ImplPipelineManager::save_shader_cache(std::filesystem::path const & cache_folder, uint64_t shader_info_hash, std::vector<u32> const & spirv)
+    struct ShaderCacheFileDependencyHeader
+    {
+        uint64_t flags;
+        int64_t write_time;
+        ShaderCacheHash content_hash;
+        uint64_t path_size;
+    };
+
+    static auto shader_cache_entry_byte_size(ShaderCacheEntry const & entry) -> u64
+    {
+        u64 size = sizeof(ShaderCacheFileEntryHeader) + entry.spirv.size() * sizeof(u32);
+        for (auto const & dependency : entry.dependencies)
+        {
+            size += sizeof(ShaderCacheFileDependencyHeader) + dependency.path.size();
+        }
+        return size;
+    }
+
+    static auto hash_file_contents(std::filesystem::path const & path) -> std::optional<ShaderCacheHash>
+    {
+        auto in_file = std::ifstream{path, std::ios::binary};
+        if (!in_file.good())
+        {
+            return std::nullopt;
+        }
+        auto contents = std::string{std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>()};
+        return hash_128(contents);
+    }
+
+    auto ImplPipelineManager::get_shader_cache_archive(std::filesystem::path const & cache_folder) -> ShaderCacheArchive &
     {
-        std::filesystem::create_directories(cache_folder);
-        auto out_file = std::ofstream{cache_folder / std::filesystem::path{std::to_string(shader_info_hash)}, std::ios::binary};
+        auto archive_iter = shader_cache_archives.find(cache_folder);
+        if (archive_iter != shader_cache_archives.end())
+        {
+            return archive_iter->second;
+        }
+        auto & archive = shader_cache_archives[cache_folder];
+        auto in_file = std::ifstream{cache_folder / CACHE_FILE_NAME, std::ios::binary | std::ios::ate};
+        if (!in_file.good())
+        {
+            return archive;
+        }
+        // Every length read from the file is checked against the remaining file size before anything is allocated or read.
+        // A corrupt or truncated archive is dropped as a whole, it is rewritten on the next flush.
+        auto remaining_size = static_cast<u64>(in_file.tellg());
+        in_file.seekg(0);
+        auto read = [&](void * dst, u64 size) -> bool
+        {
+            if (size > remaining_size)
+            {
+                return false;
+            }
+            in_file.read(reinterpret_cast<char *>(dst), static_cast<std::streamsize>(size));
+            remaining_size -= size;
+            return in_file.good();
+        };
         auto header = ShaderCacheFileHeader{};
-        header.magic_number = CACHE_FILE_MAGIC_NUMBER;
-        header.version = CACHE_FILE_VERSION;
-        header.dependency_n = current_observed_hotload_files->size();
-        header.spirv_size = spirv.size() * sizeof(u32);
+        if (!read(&header, sizeof(header)) || header.magic_number != CACHE_FILE_MAGIC_NUMBER || header.version != CACHE_FILE_VERSION)
+        {
+            return archive;
+        }
+        auto loaded_archive = ShaderCacheArchive{.use_counter = header.use_counter};
+        for (uint64_t entry_i = 0; entry_i < header.entry_n; ++entry_i)
+        {
+            auto entry_header = ShaderCacheFileEntryHeader{};
+            if (!read(&entry_header, sizeof(entry_header)) ||
+                entry_header.dependency_n > remaining_size / sizeof(ShaderCacheFileDependencyHeader) ||
+                entry_header.spirv_size > remaining_size ||
+                entry_header.spirv_size % sizeof(u32) != 0)
+            {
+                return archive;
+            }
+            auto entry = ShaderCacheEntry{.last_use = entry_header.last_use};
+            entry.dependencies.resize(entry_header.dependency_n);
+            for (auto & dependency : entry.dependencies)
+            {
+                auto dependency_header = ShaderCacheFileDependencyHeader{};
+                if (!read(&dependency_header, sizeof(dependency_header)) || dependency_header.path_size > remaining_size)
+                {
+                    return archive;
+                }
+                dependency.is_virtual_file = ((dependency_header.flags >> 0) & 1) != 0;
+                dependency.write_time = dependency_header.write_time;
+                dependency.content_hash = dependency_header.content_hash;
+                dependency.path.resize(dependency_header.path_size);
+                if (!read(dependency.path.data(), dependency_header.path_size))
+                {
+                    return archive;
+                }
+            }
+            if (entry_header.spirv_size > remaining_size)
+            {
+                return archive;
+            }
+            entry.spirv.resize(entry_header.spirv_size / sizeof(u32));
+            if (!read(entry.spirv.data(), entry_header.spirv_size))
+            {
+                return archive;
+            }
+            loaded_archive.byte_size += shader_cache_entry_byte_size(entry);
+            loaded_archive.entries[entry_header.key] = std::move(entry);
+        }
+        archive = std::move(loaded_archive);
+        return archive;
+    }
 
-        out_file.write(reinterpret_cast<char const *>(&header), sizeof(header));
-        // TODO: Save more granular dependency info
+    void ImplPipelineManager::save_shader_cache(std::filesystem::path const & cache_folder, ShaderCacheHash shader_info_hash, std::vector<u32> const & spirv)
+    {
+        auto entry = ShaderCacheEntry{.spirv = spirv};
+        auto const & visible_virtual_files = compile_virtual_files();
         for (auto const & [path, time_point] : *current_observed_hotload_files)
         {
-            auto flags = uint64_t{};
-            auto path_string = path.string();
-            auto path_string_size = uint64_t{path_string.size()};
-            auto virtual_file_iter = virtual_files.find(path_string);
-            bool is_virtual_file = virtual_file_iter != virtual_files.end();
-            flags |= (is_virtual_file << 0);
-            auto time_since_epoch = time_point.time_since_epoch().count();
-            out_file.write(reinterpret_cast<char const *>(&flags), sizeof(flags));
-            out_file.write(reinterpret_cast<char const *>(&path_string_size), sizeof(path_string_size));
-            out_file.write(path_string.data(), path_string.size());
-            if (is_virtual_file)
-            {
-                auto const & virtual_file_contents = virtual_file_iter->second.contents;
-                auto virtual_file_size = uint64_t{virtual_file_contents.size()};
-                out_file.write(reinterpret_cast<char const *>(&virtual_file_size), sizeof(virtual_file_size));
-                out_file.write(virtual_file_contents.data(), virtual_file_contents.size());
+            auto dependency = ShaderCacheDependency{.path = path.string()};
+            auto virtual_file_iter = visible_virtual_files.find(dependency.path);
+            dependency.is_virtual_file = virtual_file_iter != visible_virtual_files.end();
+            if (dependency.is_virtual_file)
+            {
+                dependency.content_hash = hash_128(virtual_file_iter->second.contents);
             }
             else
             {
-                out_file.write(reinterpret_cast<char const *>(&time_since_epoch), sizeof(time_since_epoch));
+                auto content_hash = hash_file_contents(path);
+                auto error = std::error_code{};
+                auto const file_write_time = std::filesystem::last_write_time(path, error);
+                if (!content_hash.has_value() || error)
+                {
+                    // Can not validate this entry later, do not cache it.
+                    return;
+                }
+                dependency.write_time = file_write_time.time_since_epoch().count();
+                dependency.content_hash = content_hash.value();
             }
+            entry.dependencies.push_back(std::move(dependency));
+        }
+
+        auto lock = std::lock_guard{shader_cache_mtx};
+        auto & archive = get_shader_cache_archive(cache_folder);
+        entry.last_use = ++archive.use_counter;
+        auto entry_iter = archive.entries.find(shader_info_hash);
+        if (entry_iter != archive.entries.end())
+        {
+            archive.byte_size -= shader_cache_entry_byte_size(entry_iter->second);
         }
-        out_file.write(reinterpret_cast<char const *>(spirv.data()), header.spirv_size);
+        archive.byte_size += shader_cache_entry_byte_size(entry);
+        archive.entries[shader_info_hash] = std::move(entry);
+        archive.dirty = true;
     }
 
-    auto ImplPipelineManager::try_load_shader_cache(std::filesystem::path const & cache_folder, uint64_t shader_info_hash) -> Result<std::vector<u32>>
+    auto ImplPipelineManager::try_load_shader_cache(std::filesystem::path const & cache_folder, ShaderCacheHash shader_info_hash) -> Result<std::vector<u32>>
     {
-        auto in_file = std::ifstream{cache_folder / std::filesystem::path{std::to_string(shader_info_hash)}, std::ios::binary};
-        if (in_file.good())
+        // The dependencies are copied out and validated without holding the lock, hashing files must not block other compiling threads.
+        auto dependencies = std::vector<ShaderCacheDependency>{};
         {
-            auto header = ShaderCacheFileHeader{};
-            in_file.read(reinterpret_cast<char *>(&header), sizeof(header));
-            if (header.magic_number != CACHE_FILE_MAGIC_NUMBER)
+            auto lock = std::lock_guard{shader_cache_mtx};
+            auto & archive = get_shader_cache_archive(cache_folder);
+            auto entry_iter = archive.entries.find(shader_info_hash);
+            if (entry_iter == archive.entries.end())
             {
-                return Result<std::vector<u32>>(std::string_view{"bad cache file"});
+                ++spirv_cache_misses;
+                return Result<std::vector<u32>>(std::string_view{"no cache found"});
             }
-            if (header.version != CACHE_FILE_VERSION)
+            dependencies = entry_iter->second.dependencies;
+        }
+        // Dependencies are validated by content. The write time only allows skipping the rehash of unchanged files.
+        bool write_times_changed = false;
+        auto const & visible_virtual_files = compile_virtual_files();
+        for (auto & dependency : dependencies)
+        {
+            bool up_to_date = false;
+            if (dependency.is_virtual_file)
             {
-                return Result<std::vector<u32>>(std::string_view{"needs update"});
+                auto virtual_file_iter = visible_virtual_files.find(dependency.path);
+                up_to_date = virtual_file_iter != visible_virtual_files.end() && hash_128(virtual_file_iter->second.contents) == dependency.content_hash;
             }
-
-            for (uint64_t dep_i = 0; dep_i < header.dependency_n; ++dep_i)
-            {
-                auto flags = uint64_t{};
-                auto path = std::filesystem::path{};
-                auto time_since_epoch = std::chrono::system_clock::rep{};
-                auto path_string = std::string{};
-                auto path_string_size = uint64_t{};
-                in_file.read(reinterpret_cast<char *>(&flags), sizeof(flags));
-                auto is_virtual_file = ((flags >> 0) & 1) != 0;
-                in_file.read(reinterpret_cast<char *>(&path_string_size), sizeof(path_string_size));
-                path_string.resize(path_string_size);
-                in_file.read(path_string.data(), path_string_size);
-                path = path_string;
-                if (is_virtual_file)
+            else if (auto error = std::error_code{}; std::filesystem::exists(dependency.path, error))
+            {
+                // A dependency that can not be queried is treated as out of date instead of throwing.
+                auto const file_write_time = std::filesystem::last_write_time(dependency.path, error);
+                auto const write_time = file_write_time.time_since_epoch().count();
+                if (error)
                 {
-                    auto virtual_file_contents = std::string{};
-                    auto virtual_file_size = uint64_t{};
-
-                    in_file.read(reinterpret_cast<char *>(&virtual_file_size), sizeof(virtual_file_size));
-                    virtual_file_contents.resize(virtual_file_size);
-                    in_file.read(virtual_file_contents.data(), virtual_file_size);
-
-                    auto virtual_file_iter = virtual_files.find(path_string);
-                    if (virtual_file_iter == virtual_files.end())
-                    {
-                        return Result<std::vector<u32>>(std::string_view{"needs update"});
-                    }
-                    if (virtual_file_iter->second.contents != virtual_file_contents)
+                    up_to_date = false;
+                }
+                else if (write_time == dependency.write_time)
+                {
+                    up_to_date = true;
+                }
+                else
+                {
+                    auto const content_hash = hash_file_contents(dependency.path);
+                    up_to_date = content_hash.has_value() && content_hash.value() == dependency.content_hash;
+                    if (up_to_date)
                     {
-                        return Result<std::vector<u32>>(std::string_view{"needs update"});
+                        dependency.write_time = write_time;
+                        write_times_changed = true;
                     }
                 }
-                else
+            }
+            if (!up_to_date)
+            {
+                auto lock = std::lock_guard{shader_cache_mtx};
+                ++spirv_cache_misses;
+                return Result<std::vector<u32>>(std::string_view{"needs update"});
+            }
+        }
+
+        auto lock = std::lock_guard{shader_cache_mtx};
+        auto & archive = get_shader_cache_archive(cache_folder);
+        auto entry_iter = archive.entries.find(shader_info_hash);
+        // Another thread may have replaced the entry while it was validated, then the validation does not apply to it.
+        bool const entry_unchanged =
+            entry_iter != archive.entries.end() &&
+            std::equal(
+                dependencies.begin(), dependencies.end(),
+                entry_iter->second.dependencies.begin(), entry_iter->second.dependencies.end(),
+                [](ShaderCacheDependency const & a, ShaderCacheDependency const & b)
+                { return a.path == b.path && a.is_virtual_file == b.is_virtual_file && a.content_hash == b.content_hash; });
+        if (!entry_unchanged)
+        {
+            ++spirv_cache_misses;
+            return Result<std::vector<u32>>(std::string_view{"needs update"});
+        }
+        auto & entry = entry_iter->second;
+        if (write_times_changed)
+        {
+            entry.dependencies = std::move(dependencies);
+        }
+        for (auto const & dependency : entry.dependencies)
+        {
+            // NOTE(grundlett): Setting the time to now is fine, as we successfully handle
+            // any temporal changes above. This is a bus sus tho.
+            current_observed_hotload_files->insert({dependency.path, std::chrono::file_clock::now()});
+        }
+        // Hits only update the lru order, the archive is not rewritten for them.
+        // The new order is persisted with the next flush that has inserts or evictions to write.
+        entry.last_use = ++archive.use_counter;
+        ++spirv_cache_hits;
+        return Result<std::vector<u32>>{entry.spirv};
+    }
+
+    void ImplPipelineManager::flush_shader_cache_archives()
+    {
+        auto lock = std::lock_guard{shader_cache_mtx};
+        for (auto & [cache_folder, archive] : shader_cache_archives)
+        {
+            // Evict the least recently used entries until the archive fits the size cap.
+            if (archive.byte_size > this->info.spirv_cache_max_byte_size)
+            {
+                archive.dirty = true;
+                auto entries_by_use = std::vector<std::map<ShaderCacheHash, ShaderCacheEntry>::iterator>{};
+                entries_by_use.reserve(archive.entries.size());
+                for (auto iter = archive.entries.begin(); iter != archive.entries.end(); ++iter)
                 {
-                    in_file.read(reinterpret_cast<char *>(&time_since_epoch), sizeof(time_since_epoch));
-                    if (!std::filesystem::exists(path))
+                    entries_by_use.push_back(iter);
+                }
+                std::sort(entries_by_use.begin(), entries_by_use.end(), [](auto const & a, auto const & b)
+                          { return a->second.last_use < b->second.last_use; });
+                for (auto & iter : entries_by_use)
+                {
+                    if (archive.byte_size <= this->info.spirv_cache_max_byte_size)
                     {
-                        return Result<std::vector<u32>>(std::string_view{"needs update"});
+                        break;
                     }
-                    auto write_time = std::filesystem::last_write_time(path);
-                    if (write_time.time_since_epoch().count() > time_since_epoch)
+                    archive.byte_size -= shader_cache_entry_byte_size(iter->second);
+                    archive.entries.erase(iter);
+                    ++spirv_cache_evictions;
+                }
+            }
+            if (!archive.dirty)
+            {
+                continue;
+            }
+
+            // Runs in the destructor, so filesystem errors only skip the archive.
+            auto directory_error = std::error_code{};
+            std::filesystem::create_directories(cache_folder, directory_error);
+            if (directory_error)
+            {
+                continue;
+            }
+            // Written to a temporary file first, so that a crash never leaves a half written archive behind.
+            auto const archive_path = cache_folder / CACHE_FILE_NAME;
+            auto temp_path = archive_path;
+            temp_path += ".tmp";
+            {
+                auto out_file = std::ofstream{temp_path, std::ios::binary | std::ios::trunc};
+                auto header = ShaderCacheFileHeader{
+                    .magic_number = CACHE_FILE_MAGIC_NUMBER,
+                    .version = CACHE_FILE_VERSION,
+                    .entry_n = archive.entries.size(),
+                    .use_counter = archive.use_counter,
+                };
+                out_file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+                for (auto const & [key, entry] : archive.entries)
+                {
+                    auto entry_header = ShaderCacheFileEntryHeader{
+                        .key = key,
+                        .last_use = entry.last_use,
+                        .dependency_n = entry.dependencies.size(),
+                        .spirv_size = entry.spirv.size() * sizeof(u32),
+                    };
+                    out_file.write(reinterpret_cast<char const *>(&entry_header), sizeof(entry_header));
+                    for (auto const & dependency : entry.dependencies)
                     {
-                        return Result<std::vector<u32>>(std::string_view{"needs update"});
+                        auto dependency_header = ShaderCacheFileDependencyHeader{
+                            .flags = static_cast<uint64_t>(dependency.is_virtual_file) << 0,
+                            .write_time = dependency.write_time,
+                            .content_hash = dependency.content_hash,
+                            .path_size = dependency.path.size(),
+                        };
+                        out_file.write(reinterpret_cast<char const *>(&dependency_header), sizeof(dependency_header));
+                        out_file.write(dependency.path.data(), static_cast<std::streamsize>(dependency.path.size()));
                     }
+                    out_file.write(reinterpret_cast<char const *>(entry.spirv.data()), static_cast<std::streamsize>(entry_header.spirv_size));
+                }
+                if (!out_file.good())
+                {
+                    continue;
                 }
-                // NOTE(grundlett): Setting the time to now is fine, as we successfully handle
-                // any temporal changes above. This is a bus sus tho.
-                current_observed_hotload_files->insert({path, std::chrono::file_clock::now()});
             }
+            auto error = std::error_code{};
+            std::filesystem::rename(temp_path, archive_path, error);
+            if (!error)
+            {
+                archive.dirty = false;
+            }
+        }
+    }
 
-            auto spirv = std::vector<u32>{};
-            spirv.resize(header.spirv_size / sizeof(u32));
-            in_file.read(reinterpret_cast<char *>(spirv.data()), header.spirv_size);
-            return Result<std::vector<u32>>{spirv};
+    auto ImplPipelineManager::spirv_cache_statistics() const -> SpirvCacheStatistics
+    {
+        auto lock = std::lock_guard{shader_cache_mtx};
+        auto ret = SpirvCacheStatistics{
+            .hits = spirv_cache_hits,
+            .misses = spirv_cache_misses,
+            .evictions = spirv_cache_evictions,
+        };
+        for (auto const & [cache_folder, archive] : shader_cache_archives)
+        {
+            ret.entry_count += archive.entries.size();
+            ret.byte_size += archive.byte_size;
         }
-        return Result<std::vector<u32>>(std::string_view{"no cache found"});
+        return ret;
     }
 
     auto ImplPipelineManager::get_spirv(ShaderCompileInfo const & shader_info, std::string const & debug_name_opt, ShaderStage shader_stage) -> Result<std::vector<u32>>
     {
-        // TODO: Not internally threadsafe
         current_shader_info = &shader_info;
         std::vector<u32> spirv = {};
         // if (daxa::holds_alternative<ShaderByteCode>(shader_info.source))
@@ -1240,7 +2077,7 @@ namespace daxa
             {
                 auto ret = [this, &shader_source]() -> daxa::Result<std::filesystem::path>
                 {
-                    if (this->virtual_files.contains(shader_source->path.string()))
+                    if (this->compile_virtual_files().contains(shader_source->path.string()))
                     {
                         return daxa::Result<std::filesystem::path>(shader_source->path);
                     }
@@ -1267,10 +2104,10 @@ namespace daxa
                 code = daxa::get<ShaderCode>(shader_info.source);
             }
 
-            // TODO: Test if this is slow, as it's not needed if there's no shader cache.
-            auto shader_info_hash = hash_shader_info(code.string, shader_info.compile_options, shader_stage);
+            auto shader_info_hash = ShaderCacheHash{};
             if (shader_info.compile_options.spirv_cache_folder.has_value())
             {
+                shader_info_hash = hash_shader_info(code.string, shader_info.compile_options, shader_stage);
                 auto cache_ret = try_load_shader_cache(shader_info.compile_options.spirv_cache_folder.value(), shader_info_hash);
                 if (cache_ret.is_ok())
                 {
@@ -1351,6 +2188,7 @@ namespace daxa
         }
 
 #if DAXA_BUILT_WITH_UTILS_PIPELINE_MANAGER_SPIRV_VALIDATION
+        auto spirv_tools_lock = std::lock_guard{spirv_tools_mtx};
         spirv_tools.SetMessageConsumer(
             [&](spv_message_level_t level, [[maybe_unused]] char const * source, [[maybe_unused]] spv_position_t const & position, char const * message)
             { DAXA_DBG_ASSERT_TRUE_M(level > SPV_MSG_WARNING, fmt::format("SPIR-V Validation error after compiling {}:\n - {}", debug_name_opt, message)); });
@@ -1683,7 +2521,7 @@ namespace daxa
         };
         slangRequest->processCommandLineArguments(cmd_args.data(), static_cast<int>(cmd_args.size()));
 
-        for (auto const & [virtual_path, virtual_file] : virtual_files)
+        for (auto const & [virtual_path, virtual_file] : compile_virtual_files())
         {
             int virtualFileIndex = slangRequest->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, virtual_path.c_str());
             slangRequest->addTranslationUnitSourceString(virtualFileIndex, virtual_path.c_str(), virtual_file.contents.c_str());
@@ -2,6 +2,13 @@
 
 #include <daxa/utils/pipeline_manager.hpp>
 
+#include <map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+
 #if DAXA_BUILT_WITH_UTILS_PIPELINE_MANAGER_SLANG
 #include <slang.h>
 #include <slang-com-ptr.h>
@@ -31,6 +38,45 @@ namespace daxa
 
     using VirtualFileSet = std::map<std::string, VirtualFileState>;
 
+    static inline constexpr usize RASTER_SHADER_STAGE_COUNT = 6;
+    // Spirv of each raster shader stage in the order vertex, fragment, tesselation control, tesselation evaluation, task, mesh.
+    using RasterPipelineSpirv = std::array<std::vector<u32>, RASTER_SHADER_STAGE_COUNT>;
+
+    struct ShaderCacheHash
+    {
+        u64 low = {};
+        u64 high = {};
+
+        auto operator<=>(ShaderCacheHash const & other) const = default;
+    };
+
+    struct ShaderCacheDependency
+    {
+        std::string path = {};
+        bool is_virtual_file = {};
+        // Only used to skip rehashing unchanged files, validity is decided by the content hash.
+        i64 write_time = {};
+        ShaderCacheHash content_hash = {};
+    };
+
+    struct ShaderCacheEntry
+    {
+        std::vector<ShaderCacheDependency> dependencies = {};
+        std::vector<u32> spirv = {};
+        // Value of the archives use counter at the last hit or store, used for lru eviction.
+        u64 last_use = {};
+    };
+
+    // In memory copy of one spirv_cache_folder's archive file.
+    // Loaded on first access and written back with flush_shader_cache_archives.
+    struct ShaderCacheArchive
+    {
+        std::map<ShaderCacheHash, ShaderCacheEntry> entries = {};
+        u64 use_counter = {};
+        u64 byte_size = {};
+        bool dirty = {};
+    };
+
     struct ImplPipelineManager final : ImplHandle
     {
         enum class ShaderStage
@@ -51,12 +97,29 @@ namespace daxa
         };
 
         PipelineManagerInfo info = {};
-
-        std::vector<std::filesystem::path> current_seen_shader_files = {};
-        ShaderFileTimeSet * current_observed_hotload_files = nullptr;
+        u32 compile_thread_count = {};
+
+        // The compile state is per thread, so that pipelines can be compiled in parallel by the batch functions and reload_all.
+        // It is accessed by the includers and only valid for the duration of one pipeline creation on that thread.
+        static inline thread_local std::vector<std::filesystem::path> current_seen_shader_files = {};
+        static inline thread_local ShaderFileTimeSet * current_observed_hotload_files = nullptr;
+        static inline thread_local ShaderCompileInfo const * current_shader_info = nullptr;
+        // Set while the async watcher compiles, it then reads its own copy of the virtual files instead of the guarded set.
+        static inline thread_local VirtualFileSet const * current_virtual_files = nullptr;
+        // Guards the shader cache archives and statistics, compiling threads share them.
+        mutable std::mutex shader_cache_mtx = {};
+        std::map<std::filesystem::path, ShaderCacheArchive> shader_cache_archives = {};
+        u64 spirv_cache_hits = {};
+        u64 spirv_cache_misses = {};
+        u64 spirv_cache_evictions = {};
 
         VirtualFileSet virtual_files = {};
 
+        auto compile_virtual_files() const -> VirtualFileSet const &
+        {
+            return current_virtual_files != nullptr ? *current_virtual_files : virtual_files;
+        }
+
         template <typename PipeT, typename InfoT>
         struct PipelineState
         {
@@ -70,15 +133,45 @@ namespace daxa
         using RasterPipelineState = PipelineState<RasterPipeline, RasterPipelineCompileInfo>;
         using RayTracingPipelineState = PipelineState<RayTracingPipeline, RayTracingPipelineCompileInfo>;
 
+        // Guards the pipeline states and virtual files.
+        // Compiling takes it shared, everything modifying the states or virtual files takes it exclusively.
+        // The async watcher only holds it while copying out a reload batch and compiles without it.
+        mutable std::shared_mutex pipelines_mtx = {};
         std::vector<ComputePipelineState> compute_pipelines;
         std::vector<RasterPipelineState> raster_pipelines;
         std::vector<RayTracingPipelineState> ray_tracing_pipelines;
 
-        // TODO(grundlett): Maybe make the pipeline compiler *internally* thread-safe!
-        // This variable is accessed by the includer, which makes that not thread-safe
-        // PipelineManager is still externally thread-safe. You can create as many
-        // PipelineManagers from as many threads as you'd like!
-        ShaderCompileInfo const * current_shader_info = nullptr;
+        template <typename PipeT, typename InfoT>
+        struct PipelineReload
+        {
+            std::shared_ptr<PipeT> pipeline_ptr = {};
+            InfoT info = {};
+            Result<PipelineState<PipeT, InfoT>> new_pipeline = Result<PipelineState<PipeT, InfoT>>(std::string_view{"pipeline was not compiled"});
+        };
+
+        // Pipelines whose sources changed, copied out of the states so that they can be compiled without holding the lock exclusively.
+        struct PipelineReloadBatch
+        {
+            std::vector<PipelineReload<ComputePipeline, ComputePipelineCompileInfo>> compute_pipelines = {};
+            std::vector<PipelineReload<RasterPipeline, RasterPipelineCompileInfo>> raster_pipelines = {};
+            std::vector<PipelineReload<RayTracingPipeline, RayTracingPipelineCompileInfo>> ray_tracing_pipelines = {};
+            // Only filled by the async watcher, which compiles without holding pipelines_mtx.
+            VirtualFileSet virtual_files = {};
+
+            auto size() const -> usize
+            {
+                return compute_pipelines.size() + raster_pipelines.size() + ray_tracing_pipelines.size();
+            }
+        };
+
+        // Async reload: the watcher thread collects and compiles changed pipelines, reload_all swaps them in.
+        std::thread async_reload_thread = {};
+        std::mutex async_reload_mtx = {};
+        std::condition_variable async_reload_cv = {};
+        bool async_reload_stop = false;
+        std::vector<PipelineReloadBatch> async_reload_finished_batches = {};
+        // Lets reload_all skip both locks while the watcher has nothing to swap in.
+        std::atomic<bool> async_reload_has_finished_batches = false;
 
 #if DAXA_BUILT_WITH_UTILS_PIPELINE_MANAGER_GLSLANG
         struct GlslangBackend
@@ -99,6 +192,7 @@ namespace daxa
 
 #if DAXA_BUILT_WITH_UTILS_PIPELINE_MANAGER_SPIRV_VALIDATION
         spvtools::SpirvTools spirv_tools = spvtools::SpirvTools{SPV_ENV_VULKAN_1_3};
+        std::mutex spirv_tools_mtx = {};
 #endif
 
         ImplPipelineManager(PipelineManagerInfo && a_info);
@@ -110,15 +204,34 @@ namespace daxa
         auto add_ray_tracing_pipeline(RayTracingPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RayTracingPipeline>>;
         auto add_compute_pipeline(ComputePipelineCompileInfo const & a_info) -> Result<std::shared_ptr<ComputePipeline>>;
         auto add_raster_pipeline(RasterPipelineCompileInfo const & a_info) -> Result<std::shared_ptr<RasterPipeline>>;
+        auto add_ray_tracing_pipelines(std::span<RayTracingPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RayTracingPipeline>>>;
+        auto add_compute_pipelines(std::span<ComputePipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>;
+        auto add_raster_pipelines(std::span<RasterPipelineCompileInfo const> infos) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>;
+        auto add_compute_pipeline_variants(ComputePipelineCompileInfo const & a_info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<ComputePipeline>>>;
+        auto add_raster_pipeline_variants(RasterPipelineCompileInfo const & a_info, std::span<PipelineVariantInfo const> variants) -> std::vector<Result<std::shared_ptr<RasterPipeline>>>;
+        auto instantiate_compute_pipeline(ComputePipelineCompileInfo const & a_info, std::vector<u32> const & spirv) -> ComputePipeline;
+        auto compile_raster_spirv(RasterPipelineCompileInfo const & a_info) -> Result<RasterPipelineSpirv>;
+        auto instantiate_raster_pipeline(RasterPipelineCompileInfo const & a_info, RasterPipelineSpirv const & stage_spirv) -> RasterPipeline;
+        template <typename PipeT, typename InfoT>
+        auto register_pipeline(std::vector<PipelineState<PipeT, InfoT>> & pipelines, Result<PipelineState<PipeT, InfoT>> && pipe_result) -> Result<std::shared_ptr<PipeT>>;
         void remove_ray_tracing_pipeline(std::shared_ptr<RayTracingPipeline> const & pipeline);
         void remove_compute_pipeline(std::shared_ptr<ComputePipeline> const & pipeline);
         void remove_raster_pipeline(std::shared_ptr<RasterPipeline> const & pipeline);
         void add_virtual_file(VirtualFileInfo const & virtual_info);
+        auto collect_changed_pipelines() -> PipelineReloadBatch;
+        void compile_reload_batch(PipelineReloadBatch & batch, VirtualFileSet const & batch_virtual_files);
+        auto apply_reload_batch(PipelineReloadBatch & batch) -> PipelineReloadResult;
         auto reload_all() -> PipelineReloadResult;
+        void async_reload_watcher();
         auto all_pipelines_valid() const -> bool;
-
-        auto try_load_shader_cache(std::filesystem::path const & cache_folder, uint64_t shader_info_hash) -> Result<std::vector<u32>>;
-        void save_shader_cache(std::filesystem::path const & out_folder, uint64_t shader_info_hash, std::vector<u32> const & spirv);
+        void load_pipeline_cache();
+        void save_pipeline_cache();
+
+        auto get_shader_cache_archive(std::filesystem::path const & cache_folder) -> ShaderCacheArchive &;
+        auto try_load_shader_cache(std::filesystem::path const & cache_folder, ShaderCacheHash shader_info_hash) -> Result<std::vector<u32>>;
+        void save_shader_cache(std::filesystem::path const & cache_folder, ShaderCacheHash shader_info_hash, std::vector<u32> const & spirv);
+        void flush_shader_cache_archives();
+        auto spirv_cache_statistics() const -> SpirvCacheStatistics;
         auto full_path_to_file(std::filesystem::path const & path) -> Result<std::filesystem::path>;
         auto load_shader_source_from_file(std::filesystem::path const & path) -> Result<ShaderCode>;
 
@@ -1104,18 +1104,8 @@ namespace daxa
                     }
                     validate_runtime_image_slice(*this, permutation, task_image_attach_index, tid.index, slice);
                     validate_image_attachs(*this, permutation, task_image_attach_index, tid.index, image_attach.task_access, task.base_task->name());
-                    for (auto & view : view_cache)
-                    {
-                        if (info.device.is_id_valid(view))
-                        {
-                            ImageViewId const parent_image_default_view = info.device.image_view_info(view).value().image.default_view();
-                            // Can not destroy the default view of an image!!!
-                            if (parent_image_default_view != view)
-                            {
-                                info.device.destroy_image_view(view);
-                            }
-                        }
-                    }
+                    // The views are owned by the devices image view cache and destroyed together with their images.
+                    // Swapping back to previously used images therefore only costs cache lookups.
                     view_cache.clear();
                     if (image_attach.shader_array_type == TaskHeadImageArrayType::RUNTIME_IMAGES)
                     {
@@ -1133,19 +1123,10 @@ namespace daxa
                             }
 
                             // When the use image view parameters match the default view,
-                            // then use the default view id and avoid creating a new id here.
-                            bool const is_use_default_slice = view_info.slice == slice;
-                            bool const is_use_default_view_type = use_view_type == view_info.type;
-                            if (is_use_default_slice && is_use_default_view_type)
-                            {
-                                view_cache.push_back(parent.default_view());
-                            }
-                            else
-                            {
-                                view_info.type = use_view_type;
-                                view_info.slice = slice;
-                                view_cache.push_back(info.device.create_image_view(view_info));
-                            }
+                            // the cache returns the default view id instead of creating a new view.
+                            view_info.type = use_view_type;
+                            view_info.slice = slice;
+                            view_cache.push_back(info.device.cached_image_view(view_info));
                         }
                     }
                     else // image_attach.shader_array_type == TaskHeadImageArrayType::MIP_LEVELS
@@ -1161,7 +1142,7 @@ namespace daxa
                             view_info.slice = image_attach.translated_view.slice;
                             view_info.slice.base_mip_level = base_mip_level + index;
                             view_info.slice.level_count = 1;
-                            view_cache.push_back(info.device.create_image_view(view_info));
+                            view_cache.push_back(info.device.cached_image_view(view_info));
                         }
                         // When the slice is smaller then the array size,
                         // The indices larger then the size are filled with 0 ids.
@@ -1240,6 +1221,16 @@ namespace daxa
                         impl.info.name,
                         image_index,
                         PERSISTENT_RESOURCE_MESSAGE));
+                // Task graph does not record queue family ownership transfers.
+                DAXA_DBG_ASSERT_TRUE_M(
+                    !permutation.image_infos[local_image_i].used_off_main_queue ||
+                        impl.info.device.image_info(runtime_images[image_index]).value().sharing_mode == SharingMode::CONCURRENT,
+                    fmt::format(
+                        "Detected persistent task image \"{}\" used in task graph \"{}\" by a task outside of the main queue, "
+                        "but its runtime image (runtime image index: {}) was not created with SharingMode::CONCURRENT",
+                        impl.global_image_infos[local_image_i].get_name(),
+                        impl.info.name,
+                        image_index));
             }
         }
 #endif // #if DAXA_VALIDATION
@@ -1472,6 +1463,11 @@ namespace daxa
         }
     };
 
+    auto is_same_queue(Queue const & a, Queue const & b) -> bool
+    {
+        return a.family == b.family && a.index == b.index;
+    }
+
     auto schedule_task(
         ImplTaskGraph & impl,
         TaskGraphPermutation & perm,
@@ -1525,6 +1521,7 @@ namespace daxa
                 DAXA_DBG_ASSERT_TRUE_M(!task_image.swapchain_semaphore_waited_upon, "swapchain image is already presented!");
                 if (glob_task_image.is_persistent() && glob_task_image.get_persistent().info.swapchain_image)
                 {
+                    DAXA_DBG_ASSERT_TRUE_M(is_same_queue(current_submit_scope.queue, QUEUE_MAIN), "swapchain images can only be used by tasks on the main queue");
                     if (perm.swapchain_image_first_use_submit_scope_index == std::numeric_limits<u64>::max())
                     {
                         perm.swapchain_image_first_use_submit_scope_index = current_submit_scope_index;
@@ -1574,6 +1571,8 @@ namespace daxa
         return first_possible_batch_index;
     }
 
+    // Also resolves the attachment accesses and layouts here, as they only depend on the task access.
+    // Permutations only read the attachments afterwards, so jit compilation may run while other permutations execute.
     void translate_persistent_ids(ImplTaskGraph const & impl, ITask * task)
     {
         for_each(
@@ -1582,11 +1581,15 @@ namespace daxa
             {
                 validate_buffer_blas_tlas_task_view(*task, i, attach);
                 attach.translated_view = impl.buffer_blas_tlas_id_to_local_id(attach.view);
+                attach.access = task_buffer_access_to_access(static_cast<TaskBufferAccess>(attach.task_access)).first;
             },
             [&](u32 i, TaskImageAttachmentInfo & attach)
             {
                 validate_image_task_view(*task, i, attach);
                 attach.translated_view = impl.id_to_local_id(attach.view);
+                auto const layout_access = task_image_access_to_layout_access(attach.task_access);
+                attach.layout = std::get<0>(layout_access);
+                attach.access = std::get<1>(layout_access);
             });
     }
 
@@ -1609,9 +1612,16 @@ namespace daxa
         };
         translate_persistent_ids(impl, impl_task.base_task.get());
 
-        for (auto * permutation : impl.record_active_permutations)
+        if (impl.info.jit_compile_permutations)
+        {
+            impl.jit_recorded_operations.push_back({impl.record_active_conditional_scopes, impl.record_conditional_states, task_id});
+        }
+        else
         {
-            permutation->add_task(impl, impl_task, task_id);
+            for (auto * permutation : impl.record_active_permutations)
+            {
+                permutation->add_task(impl, impl_task, task_id);
+            }
         }
 
         impl.tasks.emplace_back(std::move(impl_task));
@@ -1764,8 +1774,48 @@ namespace daxa
                 }
             });
 
+        // A task on another queue than the current submit scope starts a new submit scope on its queue.
+        // Empty scopes simply change their queue, except for the first scope.
+        // The first scope always stays on the main queue, as it holds the runtime synchronization of persistent resources.
+        Queue task_queue = task.queue();
+        if (task_graph_impl.info.device.queue_count(task_queue.family) <= task_queue.index)
+        {
+            // Devices without the requested compute or transfer queue run the task on the main queue.
+            task_queue = QUEUE_MAIN;
+        }
+        if (!is_same_queue(this->batch_submit_scopes.back().queue, task_queue))
+        {
+            if (this->batch_submit_scopes.size() == 1 || !this->batch_submit_scopes.back().task_batches.empty())
+            {
+                this->batch_submit_scopes.back().submit_info = {};
+                this->batch_submit_scopes.emplace_back();
+            }
+            this->batch_submit_scopes.back().queue = task_queue;
+            this->uses_multiple_queues = true;
+        }
+
         usize const current_submit_scope_index = this->batch_submit_scopes.size() - 1;
         TaskBatchSubmitScope & current_submit_scope = this->batch_submit_scopes[current_submit_scope_index];
+        bool const is_off_main_queue = !is_same_queue(current_submit_scope.queue, QUEUE_MAIN);
+
+        // Accesses following an access in a submit scope on another queue can not use events or barriers to synchronize.
+        // Instead the current scope waits on a timeline semaphore signaled by the other scope.
+        // Returns true when the given scope is on another queue and a wait was registered.
+        auto const sync_cross_queue = [&](usize src_submit_scope_index) -> bool
+        {
+            TaskBatchSubmitScope & src_submit_scope = this->batch_submit_scopes[src_submit_scope_index];
+            if (src_submit_scope_index == current_submit_scope_index || is_same_queue(src_submit_scope.queue, current_submit_scope.queue))
+            {
+                return false;
+            }
+            auto & waits = current_submit_scope.cross_queue_wait_scope_indices;
+            if (std::find(waits.begin(), waits.end(), src_submit_scope_index) == waits.end())
+            {
+                waits.push_back(src_submit_scope_index);
+            }
+            src_submit_scope.signals_cross_queue = true;
+            return true;
+        };
 
         // All tasks are reordered while recording.
         // Tasks are grouped into "task batches" which are just a group of tasks,
@@ -1800,7 +1850,6 @@ namespace daxa
                 // For transient buffers, we need to record first and last use so that we can later name their allocations.
                 // TODO(msakmary, pahrens) We should think about how to combine this with update_buffer_first_access below since
                 // they both overlap in what they are doing
-                buffer_attach.access = current_buffer_access;
                 if (!task_graph_impl.global_buffer_infos.at(buffer_attach.translated_view.index).is_persistent())
                 {
                     auto & buffer_first_use = task_buffer.lifetime.first_use;
@@ -1839,7 +1888,34 @@ namespace daxa
                 bool const last_access_concurrent_and_external =
                     daxa::holds_alternative<Monostate>(task_buffer.latest_concurrent_access_barrer_index) &&
                     (relation.is_previous_read || relation.is_previous_rw_concurrent);
-                if (!relation.is_previous_none && !last_access_concurrent_and_external)
+                if (is_off_main_queue)
+                {
+                    task_buffer.used_off_main_queue = true;
+                }
+                // First accesses of persistent buffers are synchronized by the runtime barriers in the first submit scope.
+                bool const is_cross_queue_access =
+                    relation.is_previous_none
+                        ? (task_graph_impl.global_buffer_infos.at(buffer_attach.translated_view.index).is_persistent() && sync_cross_queue(0))
+                        : sync_cross_queue(task_buffer.latest_access_submit_scope_index);
+                if (is_cross_queue_access)
+                {
+                    // The semaphore wait is a full memory dependency, so the access itself needs no barrier.
+                    // Concurrent accesses still get an execution only barrier on this queue,
+                    // so that following accesses on this queue have a barrier to extend or to synchronize against.
+                    task_buffer.latest_concurrent_access_barrer_index = Monostate{};
+                    if (relation.is_current_concurrent)
+                    {
+                        usize const barrier_index = this->barriers.size();
+                        this->barriers.push_back(TaskBarrier{
+                            .image_id = {},
+                            .src_access = {.stages = current_buffer_access.stages},
+                            .dst_access = current_buffer_access,
+                        });
+                        batch.pipeline_barrier_indices.push_back(barrier_index);
+                        task_buffer.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
+                    }
+                }
+                else if (!relation.is_previous_none && !last_access_concurrent_and_external)
                 {
                     if (relation.are_both_concurrent)
                     {
@@ -1956,9 +2032,11 @@ namespace daxa
                 }
                 task_image.usage |= access_to_usage(used_image_t_access);
                 task_image.create_flags |= view_type_to_create_flags(image_attach.view_type);
+                if (is_off_main_queue)
+                {
+                    task_image.used_off_main_queue = true;
+                }
                 auto [current_image_layout, current_image_access, current_access_concurrency] = task_image_access_to_layout_access(used_image_t_access);
-                image_attach.layout = current_image_layout;
-                image_attach.access = current_image_access;
                 // Now this seems strange, why would be need multiple current use slices, as we only have one here.
                 // This is because when we intersect this slice with the tracked slices, we get an intersection and a rest.
                 // We need to then test the rest against all the remaining tracked uses,
@@ -2048,8 +2126,27 @@ namespace daxa
                         // To be able to do this the layout of the image slice must also match.
                         // If they differ we need to insert an execution barrier with a layout transition.
                         AccessRelation<decltype(tracked_slice)> relation{tracked_slice, current_image_access, current_access_concurrency, tracked_slice.state.latest_layout, current_image_layout};
+                        if (sync_cross_queue(tracked_slice.latest_access_submit_scope_index))
+                        {
+                            // The semaphore wait is a full memory dependency, the barrier only performs the layout transition.
+                            // Its source stages are the destination stages, chaining it to the semaphore wait on this queue.
+                            usize const barrier_index = this->barriers.size();
+                            this->barriers.push_back(TaskBarrier{
+                                .image_id = used_image_t_id,
+                                .slice = intersection,
+                                .layout_before = tracked_slice.state.latest_layout,
+                                .layout_after = current_image_layout,
+                                .src_access = {.stages = current_image_access.stages},
+                                .dst_access = current_image_access,
+                            });
+                            batch.pipeline_barrier_indices.push_back(barrier_index);
+                            if (relation.is_current_concurrent)
+                            {
+                                ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
+                            }
+                        }
                         // Read write concurrent and reads (implicitly concurrent) are reusing the already inserted barriers if there was a previous identical access.
-                        if (relation.are_both_concurrent_and_same_layout)
+                        else if (relation.are_both_concurrent_and_same_layout)
                         {
                             // Reuse first barrier in coherent access sequence.
                             if (auto const * index0 = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
@@ -2142,6 +2239,12 @@ namespace daxa
                         ++tracked_slice_iter;
                     }
                 }
+                if (!tl_new_use_slices.empty())
+                {
+                    // Parts of the image are accessed for the first time.
+                    // Their initial barriers are recorded in the first submit scope.
+                    sync_cross_queue(0);
+                }
                 tl_new_use_slices.clear();
                 // Now we need to add the latest use and tracked range of our current access:
                 task_image.last_slice_states.push_back(ret_new_use_tracked_slice);
@@ -2160,6 +2263,11 @@ namespace daxa
         auto & impl = *r_cast<ImplTaskGraph *>(this->object);
         DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "completed task graphs can not record new tasks");
 
+        if (impl.info.jit_compile_permutations)
+        {
+            impl.jit_recorded_operations.push_back({impl.record_active_conditional_scopes, impl.record_conditional_states, info});
+            return;
+        }
         for (auto & permutation : impl.record_active_permutations)
         {
             permutation->submit(info);
@@ -2182,6 +2290,11 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "completed task graphs can not record new tasks");
         DAXA_DBG_ASSERT_TRUE_M(impl.info.swapchain.has_value(), "can only present, when a swapchain was provided in creation");
 
+        if (impl.info.jit_compile_permutations)
+        {
+            impl.jit_recorded_operations.push_back({impl.record_active_conditional_scopes, impl.record_conditional_states, info});
+            return;
+        }
         for (auto & permutation : impl.record_active_permutations)
         {
             permutation->present(info);
@@ -2241,7 +2354,7 @@ namespace daxa
                         .size = transient_info.info.size,
                         .name = transient_info.info.name,
                     },
-                    .memory_block = transient_data_memory_block,
+                    .memory_block = permutation.transient_memory_block,
                     .offset = perm_buffer.allocation_offset,
                 });
             }
@@ -2273,20 +2386,145 @@ namespace daxa
                             .array_layer_count = transient_image_info.array_layer_count,
                             .sample_count = transient_image_info.sample_count,
                             .usage = perm_image.usage,
+                            .sharing_mode = perm_image.used_off_main_queue ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
                             .name = transient_image_info.name,
                         },
-                        .memory_block = transient_data_memory_block,
+                        .memory_block = permutation.transient_memory_block,
                         .offset = perm_image.allocation_offset,
                     });
             }
         }
     }
 
-    void ImplTaskGraph::allocate_transient_resources()
+    auto ImplTaskGraph::begin_gpu_timing_frame(u32 permutation_index) -> TimelineQueryPool &
+    {
+        // Resolve finished frames oldest first, so that the newest results are kept.
+        auto & pending_frames = gpu_timing_pending_frames;
+        pending_frames.clear();
+        for (auto & frame : gpu_timing_frames)
+        {
+            if (frame.pending)
+            {
+                pending_frames.push_back(&frame);
+            }
+        }
+        std::sort(pending_frames.begin(), pending_frames.end(), [](GpuTimingFrame const * first, GpuTimingFrame const * second)
+                  { return first->execution_index < second->execution_index; });
+        for (auto * frame : pending_frames)
+        {
+            try_resolve_gpu_timing_frame(*frame);
+        }
+        GpuTimingFrame & frame = gpu_timing_frames[gpu_timing_execution_count % gpu_timing_frames.size()];
+        // A frame still pending here belongs to an execution the gpu has not finished yet, its timings are dropped instead of waiting.
+        u32 const query_count = permutations[permutation_index].gpu_timing_query_count;
+        if (!frame.query_pool.is_valid() || frame.query_pool.info().query_count < query_count)
+        {
+            frame.query_pool = info.device.create_timeline_query_pool({
+                .query_count = query_count,
+                .name = std::string("tg \"") + info.name + "\" gpu timing",
+            });
+        }
+        frame.permutation_index = permutation_index;
+        frame.query_count = query_count;
+        frame.execution_index = gpu_timing_execution_count++;
+        frame.pending = true;
+        return frame.query_pool;
+    }
+
+    auto ImplTaskGraph::try_resolve_gpu_timing_frame(GpuTimingFrame & frame) -> bool
+    {
+        // Every query has a value and an availability result.
+        auto & results = gpu_timing_query_results;
+        results.resize(static_cast<usize>(frame.query_count) * 2);
+        check_result(
+            daxa_timeline_query_pool_query_results(frame.query_pool.get(), 0, frame.query_count, results.data()),
+            "failed to query results of task graph gpu timing", std::array{DAXA_RESULT_SUCCESS, DAXA_RESULT_NOT_READY});
+        for (u32 query = 0; query < frame.query_count; ++query)
+        {
+            if (results[query * 2 + 1] == 0)
+            {
+                return false;
+            }
+        }
+        frame.pending = false;
+        u64 first_timestamp = std::numeric_limits<u64>::max();
+        for (u32 query = 0; query < frame.query_count; ++query)
+        {
+            first_timestamp = std::min(first_timestamp, results[query * 2]);
+        }
+        f64 const nanoseconds_per_tick = static_cast<f64>(info.device.properties().limits.timestamp_period);
+        auto timestamp_ns = [&](u32 query) -> u64
+        {
+            return static_cast<u64>(static_cast<f64>(results[query * 2] - first_timestamp) * nanoseconds_per_tick);
+        };
+        usize timing_count = 0;
+        auto write_timing = [&](TaskGpuTimingType type, u32 submit_scope_index, u32 batch_index, u32 task_index, u32 begin_query, u32 end_query) -> std::string &
+        {
+            if (timing_count == gpu_timings.size())
+            {
+                gpu_timings.emplace_back();
+            }
+            TaskGpuTiming & timing = gpu_timings[timing_count++];
+            timing.type = type;
+            timing.submit_scope_index = submit_scope_index;
+            timing.batch_index = batch_index;
+            timing.task_index = task_index;
+            timing.begin_ns = timestamp_ns(begin_query);
+            timing.end_ns = timestamp_ns(end_query);
+            timing.name.clear();
+            return timing.name;
+        };
+        TaskGraphPermutation const & permutation = permutations[frame.permutation_index];
+        for (u32 submit_scope_index = 0; submit_scope_index < permutation.batch_submit_scopes.size(); ++submit_scope_index)
+        {
+            auto const & submit_scope = permutation.batch_submit_scopes[submit_scope_index];
+            for (u32 batch_index = 0; batch_index < submit_scope.task_batches.size(); ++batch_index)
+            {
+                TaskBatch const & task_batch = submit_scope.task_batches[batch_index];
+                u32 const offset = task_batch.gpu_timing_query_offset;
+                if (offset == std::numeric_limits<u32>::max())
+                {
+                    continue;
+                }
+                fmt::format_to(std::back_inserter(write_timing(TaskGpuTimingType::BATCH, submit_scope_index, batch_index, 0, offset, offset + 2)), "submit {} batch {}", submit_scope_index, batch_index);
+                fmt::format_to(std::back_inserter(write_timing(TaskGpuTimingType::BATCH_BARRIERS, submit_scope_index, batch_index, 0, offset, offset + 1)), "submit {} batch {} barriers", submit_scope_index, batch_index);
+                for (u32 task_index = 0; task_index < task_batch.tasks.size(); ++task_index)
+                {
+                    write_timing(TaskGpuTimingType::TASK, submit_scope_index, batch_index, task_index, offset + 3 + 2 * task_index, offset + 4 + 2 * task_index)
+                        .assign(tasks[task_batch.tasks[task_index]].base_task->name());
+                }
+            }
+        }
+        gpu_timings.resize(timing_count);
+        return true;
+    }
+
+    auto ImplTaskGraph::get_queue_timeline(Queue queue) -> TimelineSemaphore const &
+    {
+        for (auto const & queue_timeline : queue_timelines)
+        {
+            if (is_same_queue(queue_timeline.queue, queue))
+            {
+                return queue_timeline.semaphore;
+            }
+        }
+        queue_timelines.push_back(QueueTimeline{
+            .queue = queue,
+            .semaphore = info.device.create_timeline_semaphore({
+                .initial_value = 0,
+                .name = std::string("tg \"") + info.name + "\" " + std::string(to_string(queue.family)) + " " + std::to_string(queue.index),
+            }),
+        });
+        return queue_timelines.back().semaphore;
+    }
+
+    auto ImplTaskGraph::allocate_transient_resources(std::span<TaskGraphPermutation> target_permutations) -> usize
     {
         usize transient_resource_count = 0;
         usize max_alignment_requirement = 0;
-        for (auto & permutation : permutations)
+        usize required_block_size = 0;
+        u32 memory_type_bits = 0xFFFFFFFFu;
+        for (auto & permutation : target_permutations)
         {
             for (u32 image_i = 0; image_i < permutation.image_infos.size(); ++image_i)
             {
@@ -2305,6 +2543,7 @@ namespace daxa
                         .array_layer_count = trans_img_info.array_layer_count,
                         .sample_count = trans_img_info.sample_count,
                         .usage = permut_image.usage,
+                        .sharing_mode = permut_image.used_off_main_queue ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
                         .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
                         .name = "Dummy to figure mem requirements",
                     };
@@ -2332,11 +2571,11 @@ namespace daxa
         }
         if (transient_resource_count == 0)
         {
-            return;
+            return 0;
         }
 
         // for each permutation figure out the max memory requirements
-        for (auto & permutation : permutations)
+        for (auto & permutation : target_permutations)
         {
             usize batches = 0;
             std::vector<usize> submit_batch_offsets(permutation.batch_submit_scopes.size());
@@ -2374,10 +2613,16 @@ namespace daxa
                     continue;
                 }
 
-                usize const start_idx = submit_batch_offsets.at(perm_task_image.lifetime.first_use.submit_scope_index) +
-                                        perm_task_image.lifetime.first_use.task_batch_index;
-                usize const end_idx = submit_batch_offsets.at(perm_task_image.lifetime.last_use.submit_scope_index) +
-                                      perm_task_image.lifetime.last_use.task_batch_index;
+                usize start_idx = submit_batch_offsets.at(perm_task_image.lifetime.first_use.submit_scope_index) +
+                                  perm_task_image.lifetime.first_use.task_batch_index;
+                usize end_idx = submit_batch_offsets.at(perm_task_image.lifetime.last_use.submit_scope_index) +
+                                perm_task_image.lifetime.last_use.task_batch_index;
+                if (perm_task_image.used_off_main_queue)
+                {
+                    // Batches on other queues overlap arbitrarily with the main queue, the image must not alias anything.
+                    start_idx = 0;
+                    end_idx = batches - 1;
+                }
 
                 lifetime_length_sorted_resources.emplace_back(LifetimeLengthResource{
                     .start_batch = start_idx,
@@ -2405,10 +2650,16 @@ namespace daxa
                     continue;
                 }
 
-                usize const start_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.first_use.submit_scope_index) +
-                                        perm_task_buffer.lifetime.first_use.task_batch_index;
-                usize const end_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.last_use.submit_scope_index) +
-                                      perm_task_buffer.lifetime.last_use.task_batch_index;
+                usize start_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.first_use.submit_scope_index) +
+                                  perm_task_buffer.lifetime.first_use.task_batch_index;
+                usize end_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.last_use.submit_scope_index) +
+                                perm_task_buffer.lifetime.last_use.task_batch_index;
+                if (perm_task_buffer.used_off_main_queue)
+                {
+                    // Batches on other queues overlap arbitrarily with the main queue, the buffer must not alias anything.
+                    start_idx = 0;
+                    end_idx = batches - 1;
+                }
 
                 lifetime_length_sorted_resources.emplace_back(LifetimeLengthResource{
                     .start_batch = start_idx,
@@ -2419,11 +2670,47 @@ namespace daxa
                 });
             }
 
-            std::sort(lifetime_length_sorted_resources.begin(), lifetime_length_sorted_resources.end(),
-                      [](LifetimeLengthResource const & first, LifetimeLengthResource const & second) -> bool
-                      {
-                          return first.lifetime_length > second.lifetime_length;
-                      });
+            auto resource_memory_requirements = [&](LifetimeLengthResource const & resource) -> MemoryRequirements const &
+            {
+                if (resource.is_image)
+                {
+                    return permutation.image_infos.at(resource.resource_idx).memory_requirements;
+                }
+                return permutation.buffer_infos.at(resource.resource_idx).memory_requirements;
+            };
+            bool const best_fit = info.alias_transients && info.transient_aliasing_strategy == TaskTransientAliasingStrategy::SIZE_BEST_FIT;
+            if (best_fit)
+            {
+                // Resources are bucketed into power of two size classes, largest class first.
+                // Within a class longer lifetimes are placed first, as they constrain more of the other placements.
+                auto size_class = [](usize size) -> u32
+                {
+                    return static_cast<u32>(std::bit_width(size));
+                };
+                std::sort(lifetime_length_sorted_resources.begin(), lifetime_length_sorted_resources.end(),
+                          [&](LifetimeLengthResource const & first, LifetimeLengthResource const & second) -> bool
+                          {
+                              usize const first_size = resource_memory_requirements(first).size;
+                              usize const second_size = resource_memory_requirements(second).size;
+                              if (size_class(first_size) != size_class(second_size))
+                              {
+                                  return size_class(first_size) > size_class(second_size);
+                              }
+                              if (first.lifetime_length != second.lifetime_length)
+                              {
+                                  return first.lifetime_length > second.lifetime_length;
+                              }
+                              return first_size > second_size;
+                          });
+            }
+            else
+            {
+                std::sort(lifetime_length_sorted_resources.begin(), lifetime_length_sorted_resources.end(),
+                          [](LifetimeLengthResource const & first, LifetimeLengthResource const & second) -> bool
+                          {
+                              return first.lifetime_length > second.lifetime_length;
+                          });
+            }
 
             struct Allocation
             {
@@ -2472,15 +2759,7 @@ namespace daxa
             usize no_alias_back_offset = {};
             for (auto const & resource_lifetime : lifetime_length_sorted_resources)
             {
-                MemoryRequirements mem_requirements;
-                if (resource_lifetime.is_image)
-                {
-                    mem_requirements = permutation.image_infos.at(resource_lifetime.resource_idx).memory_requirements;
-                }
-                else
-                {
-                    mem_requirements = permutation.buffer_infos.at(resource_lifetime.resource_idx).memory_requirements;
-                }
+                MemoryRequirements const mem_requirements = resource_memory_requirements(resource_lifetime);
                 // Go through all memory block states in which this resource is alive and try to find a spot for it
                 u8 const resource_lifetime_duration = static_cast<u8>(resource_lifetime.end_batch - resource_lifetime.start_batch + 1);
                 auto new_allocation = Allocation{
@@ -2499,7 +2778,36 @@ namespace daxa
                     }};
                 usize const align = std::max(mem_requirements.alignment, static_cast<size_t>(1ull));
 
-                if (info.alias_transients)
+                if (best_fit)
+                {
+                    // The allocations are ordered by offset, so are the ones alive at the same time as the new allocation.
+                    // Pick the smallest gap between them the new allocation fits in, or place it behind all of them.
+                    usize best_offset = std::numeric_limits<usize>::max();
+                    usize best_gap_size = std::numeric_limits<usize>::max();
+                    usize gap_begin = 0;
+                    for (auto const & allocation : allocations)
+                    {
+                        if (allocation.end_batch < new_allocation.start_batch || allocation.start_batch > new_allocation.end_batch)
+                        {
+                            continue;
+                        }
+                        usize const aligned_gap_begin = (gap_begin + align - 1) / align * align;
+                        if (aligned_gap_begin + new_allocation.size <= allocation.offset &&
+                            allocation.offset - aligned_gap_begin < best_gap_size)
+                        {
+                            best_gap_size = allocation.offset - aligned_gap_begin;
+                            best_offset = aligned_gap_begin;
+                        }
+                        gap_begin = std::max(gap_begin, allocation.offset + allocation.size);
+                    }
+                    if (best_offset == std::numeric_limits<usize>::max())
+                    {
+                        best_offset = (gap_begin + align - 1) / align * align;
+                    }
+                    new_allocation.offset = best_offset;
+                    new_allocation.intersection_object.base_array_layer = static_cast<u32>(new_allocation.offset);
+                }
+                else if (info.alias_transients)
                 {
                     // TODO(msakmary) Fix the intersect functionality so that it is general and does not do hacky stuff like constructing
                     // a mip array slice
@@ -2525,8 +2833,15 @@ namespace daxa
                 allocations.insert(new_allocation);
             }
             // Once we are done with finding space for all the allocations go through all permutation images and copy over the allocation information
+            std::vector<usize> batch_live_sizes(batches, 0);
+            permutation.transient_memory_size = {};
             for (auto const & allocation : allocations)
             {
+                for (usize batch = allocation.start_batch; batch <= allocation.end_batch; ++batch)
+                {
+                    batch_live_sizes[batch] += allocation.size;
+                }
+                permutation.transient_memory_size.allocated_size = std::max(permutation.transient_memory_size.allocated_size, allocation.offset + allocation.size);
                 if (allocation.is_image)
                 {
                     permutation.image_infos.at(allocation.owning_resource_idx).allocation_offset = allocation.offset;
@@ -2536,171 +2851,464 @@ namespace daxa
                     permutation.buffer_infos.at(allocation.owning_resource_idx).allocation_offset = allocation.offset;
                 }
                 // find the amount of memory this permutation requires
-                memory_block_size = std::max(memory_block_size, allocation.offset + allocation.size);
+                required_block_size = std::max(required_block_size, allocation.offset + allocation.size);
                 memory_type_bits = memory_type_bits & allocation.memory_type_bits;
             }
+            for (usize const live_size : batch_live_sizes)
+            {
+                permutation.transient_memory_size.peak_live_size = std::max(permutation.transient_memory_size.peak_live_size, live_size);
+            }
         }
 
-        transient_data_memory_block = info.device.create_memory({
+        MemoryBlock const transient_memory_block = info.device.create_memory({
             .requirements = {
-                .size = memory_block_size,
+                .size = required_block_size,
                 .alignment = max_alignment_requirement,
                 .memory_type_bits = memory_type_bits,
             },
-            .flags = MemoryFlagBits::DEDICATED_MEMORY,
+            .flags = MemoryFlagBits::DEDICATED_MEMORY | MemoryFlagBits::CAN_ALIAS,
+            .name = std::string("tg \"") + info.name + "\" transient memory",
         });
-    }
-
-    void TaskGraph::complete(TaskCompleteInfo const & /*unused*/)
-    {
-        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "task graphs can only be completed once");
-        impl.compiled = true;
-
-        impl.allocate_transient_resources();
-        // Insert static barriers initializing image layouts.
-        for (auto & permutation : impl.permutations)
+        // All target permutations share the memory block, only one of them executes at a time.
+        for (auto & permutation : target_permutations)
         {
-            impl.create_transient_runtime_buffers(permutation);
-            impl.create_transient_runtime_images(permutation);
-
-            // Insert static initialization barriers for non persistent resources:
-            // Buffers never need layout initialization, only images.
-            for (u32 task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
-            {
-                TaskImageView const task_image_id = {{impl.unique_index, task_image_index}};
-                auto & task_image = permutation.image_infos[task_image_index];
-                PermIndepTaskImageInfo const & glob_task_image = impl.global_image_infos[task_image_index];
-                if (task_image.valid && !glob_task_image.is_persistent())
-                {
-                    // Insert barriers, initializing all the initially accesses subresource ranges to the correct layout.
-                    for (auto & first_access : task_image.first_slice_states)
-                    {
-                        usize const new_barrier_index = permutation.barriers.size();
-                        permutation.barriers.push_back(TaskBarrier{
-                            .image_id = task_image_id,
-                            .slice = first_access.state.slice,
-                            .layout_before = {},
-                            .layout_after = first_access.state.latest_layout,
-                            .src_access = {},
-                            .dst_access = first_access.state.latest_access,
-                        });
-                        // Because resources may be aliased we need to insert the barrier into the batch in which the resource is first used
-                        // If we just inserted all transitions into the first batch an error as follows might occur:
-                        //      Image A lives in batch 1, Image B lives in batch 2
-                        //      Image A and B are aliased (share the same/part-of memory)
-                        //      Image A is transitioned from UNDEFINED -> TRANSFER_DST in batch 0 BUT
-                        //      Image B is also transitioned from UNDEFINED -> TRANSFER_SRT in batch 0
-                        // This is an erroneous state - task graph assumes they are separate images and thus,
-                        // for example uses Image A thinking it's in TRANSFER_DST which it is not
-                        if (impl.info.alias_transients)
-                        {
-                            // TODO(msakmary) This is only needed when we actually alias two images - should be possible to detect this
-                            // and only defer the initialization barrier for these aliased ones instead of all of them
-                            auto const submit_scope_index = first_access.latest_access_submit_scope_index;
-                            auto const batch_index = first_access.latest_access_batch_index;
-                            auto & first_used_batch = permutation.batch_submit_scopes[submit_scope_index].task_batches[batch_index];
-                            first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
-                        }
-                        else
-                        {
-                            auto & first_used_batch = permutation.batch_submit_scopes[0].task_batches[0];
-                            first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
-                        }
-                    }
-                }
-            }
+            permutation.transient_memory_block = transient_memory_block;
         }
+        return required_block_size;
     }
 
-    // auto TaskGraph::get_command_lists() -> std::vector<CommandRecorder>
-    // {
-    //     auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-    //     DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "Can only get command lists of a finished task graph");
-    //     DAXA_DBG_ASSERT_TRUE_M(!impl.executed_once, "Can only get command lists of a task graph that has been executed");
-    //     auto command_lists = std::move(impl.left_over_command_lists);
-    //     impl.left_over_command_lists = {};
-    //     return command_lists;
-    // }
-
-    auto TaskGraph::get_debug_string() -> std::string
-    {
-        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        DAXA_DBG_ASSERT_TRUE_M(impl.info.record_debug_information,
-                               "in order to have debug string you need to set record_debug_information flag to true on task graph creation");
-        DAXA_DBG_ASSERT_TRUE_M(impl.executed_once,
-                               "in order to have debug string you need to execute the task graph at least once");
-        std::string ret = impl.debug_string_stream.str();
-        impl.debug_string_stream.str("");
-        return ret;
-    }
-
-    auto TaskGraph::get_transient_memory_size() -> daxa::usize
-    {
-        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        return impl.memory_block_size;
-    }
-
-    thread_local std::vector<EventWaitInfo> tl_split_barrier_wait_infos = {};
-    thread_local std::vector<ImageMemoryBarrierInfo> tl_image_barrier_infos = {};
-    thread_local std::vector<MemoryBarrierInfo> tl_memory_barrier_infos = {};
-    void insert_pipeline_barrier(ImplTaskGraph const & impl, TaskGraphPermutation & perm, CommandRecorder & command_list, TaskBarrier & barrier)
+    // Batches using the swapchain image are never static, the swapchain image changes every frame.
+    auto is_task_batch_static(ImplTaskGraph & impl, TaskGraphPermutation const & permutation, TaskBatch const & task_batch) -> bool
     {
-        // Check if barrier is image barrier or normal barrier (see TaskBarrier struct comments).
-        if (barrier.image_id.is_empty())
+        auto is_swapchain_image = [&](TaskImageView const & view)
         {
-            command_list.pipeline_barrier({
-                .src_access = barrier.src_access,
-                .dst_access = barrier.dst_access,
-            });
+            return !view.is_empty() && !view.is_null() &&
+                   impl.global_image_infos.at(view.index).is_persistent() &&
+                   impl.global_image_infos.at(view.index).get_persistent().info.swapchain_image;
+        };
+        if (task_batch.tasks.empty())
+        {
+            return false;
         }
-        else
+        for (TaskId const task_id : task_batch.tasks)
         {
-            auto const actual_images = impl.get_actual_images(barrier.image_id, perm);
-            for (usize index = 0; index < actual_images.size(); ++index)
+            ImplTask & task = impl.tasks[task_id];
+            if (!task.base_task->is_static())
             {
-                auto const & image = actual_images[index];
-                DAXA_DBG_ASSERT_TRUE_M(
-                    impl.info.device.is_id_valid(image),
-                    std::string("Detected invalid runtime image id while inserting barriers: the runtime image id at index ") +
-                        std::to_string(index) +
-                        std::string(" of task image \"") +
-                        std::string(impl.global_image_infos[barrier.image_id.index].get_name()) +
-                        std::string("\" is invalid"));
-                command_list.pipeline_barrier_image_transition({
-                    .src_access = barrier.src_access,
-                    .dst_access = barrier.dst_access,
-                    .src_layout = barrier.layout_before,
-                    .dst_layout = barrier.layout_after,
-                    .image_slice = barrier.slice,
-                    .image_id = image,
+                return false;
+            }
+            bool uses_swapchain_image = false;
+            for_each(
+                task.base_task->attachments(),
+                [&](u32, auto &) {},
+                [&](u32, TaskImageAttachmentInfo & attach)
+                {
+                    uses_swapchain_image = uses_swapchain_image || is_swapchain_image(attach.translated_view);
                 });
+            if (uses_swapchain_image)
+            {
+                return false;
+            }
+        }
+        for (usize const barrier_index : task_batch.pipeline_barrier_indices)
+        {
+            if (is_swapchain_image(permutation.barriers[barrier_index].image_id))
+            {
+                return false;
+            }
+        }
+        for (auto const * split_barrier_indices : {&task_batch.wait_split_barrier_indices, &task_batch.signal_split_barrier_indices})
+        {
+            for (usize const barrier_index : *split_barrier_indices)
+            {
+                if (is_swapchain_image(permutation.split_barriers[barrier_index].image_id))
+                {
+                    return false;
+                }
             }
         }
+        return true;
     }
 
-    void generate_persistent_resource_synch(
-        ImplTaskGraph & impl,
-        TaskGraphPermutation & permutation,
-        CommandRecorder & recorder)
+    // Connects the queues of the permutation, creates its transient resources and inserts their initialization barriers.
+    void complete_permutation(ImplTaskGraph & impl, TaskGraphPermutation & permutation)
     {
-        // Persistent resources need just in time synch between executions,
-        // as pre generating the transitions between all permutations is not manageable.
-        std::string out;
-        std::string indent;
-        if (impl.info.record_debug_information)
-        {
-            fmt::format_to(std::back_inserter(out), "{}runtime sync memory barriers:\n", indent);
-            begin_indent(out, indent, true);
-        }
-        for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
+        // The last submit of a permutation using multiple queues waits on the last submit of every other queue.
+        // This orders the staging memory, the transient memory and the next execution after all work of this execution.
+        if (permutation.uses_multiple_queues && permutation.batch_submit_scopes.size() >= 2)
         {
-            auto & task_buffer = permutation.buffer_infos[task_buffer_index];
-            auto & glob_buffer_info = impl.global_buffer_infos[task_buffer_index];
-            if (task_buffer.valid && glob_buffer_info.is_persistent())
+            usize const join_scope_index = permutation.batch_submit_scopes.size() - 2;
+            TaskBatchSubmitScope & join_scope = permutation.batch_submit_scopes[join_scope_index];
+            std::vector<Queue> joined_queues = {join_scope.queue};
+            for (usize scope_index = join_scope_index; scope_index > 0; --scope_index)
             {
-                auto & persistent_data = glob_buffer_info.get_persistent();
-                bool const no_prev_access = persistent_data.latest_access == AccessConsts::NONE;
+                TaskBatchSubmitScope & scope = permutation.batch_submit_scopes[scope_index - 1];
+                bool const already_joined = std::any_of(joined_queues.begin(), joined_queues.end(), [&](Queue const & queue)
+                                                        { return is_same_queue(queue, scope.queue); });
+                if (already_joined)
+                {
+                    continue;
+                }
+                joined_queues.push_back(scope.queue);
+                if (std::find(join_scope.cross_queue_wait_scope_indices.begin(), join_scope.cross_queue_wait_scope_indices.end(), scope_index - 1) == join_scope.cross_queue_wait_scope_indices.end())
+                {
+                    join_scope.cross_queue_wait_scope_indices.push_back(scope_index - 1);
+                }
+                scope.signals_cross_queue = true;
+            }
+        }
+        // Insert static barriers initializing image layouts.
+        impl.create_transient_runtime_buffers(permutation);
+        impl.create_transient_runtime_images(permutation);
+
+        // Insert static initialization barriers for non persistent resources:
+        // Buffers never need layout initialization, only images.
+        for (u32 task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
+        {
+            TaskImageView const task_image_id = {{impl.unique_index, task_image_index}};
+            auto & task_image = permutation.image_infos[task_image_index];
+            PermIndepTaskImageInfo const & glob_task_image = impl.global_image_infos[task_image_index];
+            if (task_image.valid && !glob_task_image.is_persistent())
+            {
+                // Insert barriers, initializing all the initially accesses subresource ranges to the correct layout.
+                for (auto & first_access : task_image.first_slice_states)
+                {
+                    usize const new_barrier_index = permutation.barriers.size();
+                    permutation.barriers.push_back(TaskBarrier{
+                        .image_id = task_image_id,
+                        .slice = first_access.state.slice,
+                        .layout_before = {},
+                        .layout_after = first_access.state.latest_layout,
+                        .src_access = {},
+                        .dst_access = first_access.state.latest_access,
+                    });
+                    // Because resources may be aliased we need to insert the barrier into the batch in which the resource is first used
+                    // If we just inserted all transitions into the first batch an error as follows might occur:
+                    //      Image A lives in batch 1, Image B lives in batch 2
+                    //      Image A and B are aliased (share the same/part-of memory)
+                    //      Image A is transitioned from UNDEFINED -> TRANSFER_DST in batch 0 BUT
+                    //      Image B is also transitioned from UNDEFINED -> TRANSFER_SRT in batch 0
+                    // This is an erroneous state - task graph assumes they are separate images and thus,
+                    // for example uses Image A thinking it's in TRANSFER_DST which it is not
+                    if (impl.info.alias_transients)
+                    {
+                        // TODO(msakmary) This is only needed when we actually alias two images - should be possible to detect this
+                        // and only defer the initialization barrier for these aliased ones instead of all of them
+                        auto const submit_scope_index = first_access.latest_access_submit_scope_index;
+                        auto const batch_index = first_access.latest_access_batch_index;
+                        auto & first_used_batch = permutation.batch_submit_scopes[submit_scope_index].task_batches[batch_index];
+                        first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
+                    }
+                    else
+                    {
+                        // The first submit scope has no batches when the first task runs on another queue.
+                        if (permutation.batch_submit_scopes[0].task_batches.empty())
+                        {
+                            permutation.batch_submit_scopes[0].task_batches.emplace_back();
+                        }
+                        auto & first_used_batch = permutation.batch_submit_scopes[0].task_batches[0];
+                        first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
+                    }
+                }
+            }
+        }
+        // Collect the runs of static batches, their commands are cached on their first execution.
+        if (impl.info.cache_static_tasks)
+        {
+            for (auto & submit_scope : permutation.batch_submit_scopes)
+            {
+                for (usize batch_index = 0; batch_index < submit_scope.task_batches.size(); ++batch_index)
+                {
+                    if (!is_task_batch_static(impl, permutation, submit_scope.task_batches[batch_index]))
+                    {
+                        continue;
+                    }
+                    if (!submit_scope.static_batch_runs.empty() && submit_scope.static_batch_runs.back().end_batch_index == batch_index)
+                    {
+                        submit_scope.static_batch_runs.back().end_batch_index = batch_index + 1;
+                    }
+                    else
+                    {
+                        submit_scope.static_batch_runs.push_back(StaticTaskBatchRun{
+                            .first_batch_index = batch_index,
+                            .end_batch_index = batch_index + 1,
+                        });
+                    }
+                }
+            }
+        }
+        // Only batches on the main queue are timed, they are ordered after the query reset at the start of the execution.
+        if (impl.info.enable_gpu_timing)
+        {
+            u32 query_count = 0;
+            for (usize submit_scope_index = 0; submit_scope_index + 1 < permutation.batch_submit_scopes.size(); ++submit_scope_index)
+            {
+                auto & submit_scope = permutation.batch_submit_scopes[submit_scope_index];
+                if (!is_same_queue(submit_scope.queue, QUEUE_MAIN))
+                {
+                    continue;
+                }
+                for (usize batch_index = 0; batch_index < submit_scope.task_batches.size(); ++batch_index)
+                {
+                    bool const in_static_run = std::any_of(submit_scope.static_batch_runs.begin(), submit_scope.static_batch_runs.end(), [&](StaticTaskBatchRun const & static_run)
+                                                           { return static_run.first_batch_index <= batch_index && batch_index < static_run.end_batch_index; });
+                    if (in_static_run)
+                    {
+                        continue;
+                    }
+                    TaskBatch & task_batch = submit_scope.task_batches[batch_index];
+                    task_batch.gpu_timing_query_offset = query_count;
+                    query_count += 3 + 2 * static_cast<u32>(task_batch.tasks.size());
+                }
+            }
+            permutation.gpu_timing_query_count = query_count;
+        }
+        permutation.compiled = true;
+    }
+
+    // Replays the recorded operations active in the permutation and completes it with its own transient memory.
+    void jit_compile_permutation(ImplTaskGraph & impl, u32 permutation_index)
+    {
+        TaskGraphPermutation & permutation = impl.permutations[permutation_index];
+        for (auto const & recorded : impl.jit_recorded_operations)
+        {
+            bool const active = (recorded.active_conditional_scopes & permutation_index) == (recorded.active_conditional_scopes & recorded.conditional_states);
+            if (!active)
+            {
+                continue;
+            }
+            if (auto const * task_id = std::get_if<TaskId>(&recorded.operation))
+            {
+                permutation.add_task(impl, impl.tasks[*task_id], *task_id);
+            }
+            else if (auto const * submit_info = std::get_if<TaskSubmitInfo>(&recorded.operation))
+            {
+                permutation.submit(*submit_info);
+            }
+            else
+            {
+                permutation.present(std::get<TaskPresentInfo>(recorded.operation));
+            }
+        }
+        usize const transient_memory_size = impl.allocate_transient_resources(std::span{&permutation, 1});
+        {
+            std::lock_guard<std::mutex> const lock{impl.jit_compile_mutex};
+            impl.memory_block_size += transient_memory_size;
+        }
+        complete_permutation(impl, permutation);
+    }
+
+    void TaskGraph::complete(TaskCompleteInfo const & /*unused*/)
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "task graphs can only be completed once");
+        impl.compiled = true;
+
+        if (impl.info.jit_compile_permutations)
+        {
+            // Permutations are compiled on their first execution or by precompile_permutation.
+            // Whether any of them uses multiple queues is already known from the recorded tasks.
+            impl.uses_multiple_queues = std::any_of(impl.tasks.begin(), impl.tasks.end(), [&](ImplTask const & task)
+                                                    {
+                                                        Queue const queue = task.base_task->queue();
+                                                        return !is_same_queue(queue, QUEUE_MAIN) && impl.info.device.queue_count(queue.family) > queue.index;
+                                                    });
+            return;
+        }
+        impl.memory_block_size = impl.allocate_transient_resources(impl.permutations);
+        for (auto & permutation : impl.permutations)
+        {
+            complete_permutation(impl, permutation);
+            impl.uses_multiple_queues = impl.uses_multiple_queues || permutation.uses_multiple_queues;
+        }
+    }
+
+    // auto TaskGraph::get_command_lists() -> std::vector<CommandRecorder>
+    // {
+    //     auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+    //     DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "Can only get command lists of a finished task graph");
+    //     DAXA_DBG_ASSERT_TRUE_M(!impl.executed_once, "Can only get command lists of a task graph that has been executed");
+    //     auto command_lists = std::move(impl.left_over_command_lists);
+    //     impl.left_over_command_lists = {};
+    //     return command_lists;
+    // }
+
+    auto TaskGraph::get_debug_string() -> std::string
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(impl.info.record_debug_information,
+                               "in order to have debug string you need to set record_debug_information flag to true on task graph creation");
+        DAXA_DBG_ASSERT_TRUE_M(impl.executed_once,
+                               "in order to have debug string you need to execute the task graph at least once");
+        std::string ret = impl.debug_string_stream.str();
+        impl.debug_string_stream.str("");
+        return ret;
+    }
+
+    auto TaskGraph::get_transient_memory_size() -> daxa::usize
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        // Background jit compilations add their permutations memory under this lock.
+        std::lock_guard<std::mutex> const lock{impl.jit_compile_mutex};
+        return impl.memory_block_size;
+    }
+
+    auto TaskGraph::get_gpu_timings() -> std::vector<TaskGpuTiming> const &
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        return impl.gpu_timings;
+    }
+
+    auto TaskGraph::get_gpu_timings_chrome_trace() -> std::string
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        auto escape_json = [](std::string_view str)
+        {
+            std::string ret = {};
+            for (char const c : str)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    ret.push_back('\\');
+                    ret.push_back(c);
+                }
+                else if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    ret.push_back(c);
+                }
+            }
+            return ret;
+        };
+        // Batches, their barriers and the tasks of a batch each get their own track, as tasks within a batch may overlap.
+        std::string out = "{\"traceEvents\":[";
+        for (usize timing_index = 0; timing_index < impl.gpu_timings.size(); ++timing_index)
+        {
+            TaskGpuTiming const & timing = impl.gpu_timings[timing_index];
+            std::string_view category = "task";
+            u32 track = 2 + timing.task_index;
+            if (timing.type == TaskGpuTimingType::BATCH)
+            {
+                category = "batch";
+                track = 0;
+            }
+            else if (timing.type == TaskGpuTimingType::BATCH_BARRIERS)
+            {
+                category = "barriers";
+                track = 1;
+            }
+            fmt::format_to(std::back_inserter(out), "{}{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                           timing_index == 0 ? "" : ",",
+                           escape_json(timing.name),
+                           category,
+                           impl.unique_index,
+                           track,
+                           static_cast<f64>(timing.begin_ns) / 1000.0,
+                           static_cast<f64>(timing.end_ns - timing.begin_ns) / 1000.0);
+        }
+        fmt::format_to(std::back_inserter(out), "],\"displayTimeUnit\":\"ns\",\"otherData\":{{\"task graph\":\"{}\"}}}}", escape_json(impl.info.name));
+        return out;
+    }
+
+    void TaskGraph::precompile_permutation(std::span<bool const> permutation_condition_values)
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(permutation_condition_values.size() >= impl.info.permutation_condition_count, "Detected invalid permutation condition count");
+        DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "task graphs must be completed before precompiling permutations");
+        if (!impl.info.jit_compile_permutations)
+        {
+            return;
+        }
+        // Values past the condition count are ignored, they would index past the permutations.
+        u32 permutation_index = {};
+        for (u32 index = 0; index < std::min(usize{impl.info.permutation_condition_count}, permutation_condition_values.size()); ++index)
+        {
+            permutation_index |= permutation_condition_values[index] ? (1u << index) : 0;
+        }
+        TaskGraphPermutation & permutation = impl.permutations[permutation_index];
+        // A pending compilation writes permutation.compiled from its thread, so compiled is only read once no compilation is pending.
+        // The future is only invalidated by execute joining it.
+        if (permutation.jit_compilation.valid() || permutation.compiled)
+        {
+            return;
+        }
+        permutation.jit_compilation = std::async(std::launch::async, [&impl, permutation_index]()
+                                                 { jit_compile_permutation(impl, permutation_index); });
+    }
+
+    auto TaskGraph::get_transient_memory_size(u32 permutation_index) -> TaskTransientMemorySize
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "transient memory sizes are only known after completion");
+        DAXA_DBG_ASSERT_TRUE_M(permutation_index < impl.permutations.size(), "Detected invalid permutation index");
+        TaskGraphPermutation & permutation = impl.permutations[permutation_index];
+        // A pending precompilation writes the size from its thread.
+        if (permutation.jit_compilation.valid())
+        {
+            permutation.jit_compilation.wait();
+        }
+        return permutation.transient_memory_size;
+    }
+
+    thread_local std::vector<EventWaitInfo> tl_split_barrier_wait_infos = {};
+    thread_local std::vector<ImageMemoryBarrierInfo> tl_image_barrier_infos = {};
+    thread_local std::vector<MemoryBarrierInfo> tl_memory_barrier_infos = {};
+    void insert_pipeline_barrier(ImplTaskGraph const & impl, TaskGraphPermutation & perm, CommandRecorder & command_list, TaskBarrier & barrier)
+    {
+        // Check if barrier is image barrier or normal barrier (see TaskBarrier struct comments).
+        if (barrier.image_id.is_empty())
+        {
+            command_list.pipeline_barrier({
+                .src_access = barrier.src_access,
+                .dst_access = barrier.dst_access,
+            });
+        }
+        else
+        {
+            auto const actual_images = impl.get_actual_images(barrier.image_id, perm);
+            for (usize index = 0; index < actual_images.size(); ++index)
+            {
+                auto const & image = actual_images[index];
+                DAXA_DBG_ASSERT_TRUE_M(
+                    impl.info.device.is_id_valid(image),
+                    std::string("Detected invalid runtime image id while inserting barriers: the runtime image id at index ") +
+                        std::to_string(index) +
+                        std::string(" of task image \"") +
+                        std::string(impl.global_image_infos[barrier.image_id.index].get_name()) +
+                        std::string("\" is invalid"));
+                command_list.pipeline_barrier_image_transition({
+                    .src_access = barrier.src_access,
+                    .dst_access = barrier.dst_access,
+                    .src_layout = barrier.layout_before,
+                    .dst_layout = barrier.layout_after,
+                    .image_slice = barrier.slice,
+                    .image_id = image,
+                });
+            }
+        }
+    }
+
+    void generate_persistent_resource_synch(
+        ImplTaskGraph & impl,
+        TaskGraphPermutation & permutation,
+        CommandRecorder & recorder)
+    {
+        // Persistent resources need just in time synch between executions,
+        // as pre generating the transitions between all permutations is not manageable.
+        std::string out;
+        std::string indent;
+        if (impl.info.record_debug_information)
+        {
+            fmt::format_to(std::back_inserter(out), "{}runtime sync memory barriers:\n", indent);
+            begin_indent(out, indent, true);
+        }
+        for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
+        {
+            auto & task_buffer = permutation.buffer_infos[task_buffer_index];
+            auto & glob_buffer_info = impl.global_buffer_infos[task_buffer_index];
+            if (task_buffer.valid && glob_buffer_info.is_persistent())
+            {
+                auto & persistent_data = glob_buffer_info.get_persistent();
+                bool const no_prev_access = persistent_data.latest_access == AccessConsts::NONE;
                 bool const read_on_read_same_access =
                     persistent_data.latest_access == permutation.buffer_infos[task_buffer_index].first_access &&
                     persistent_data.latest_access.type == AccessTypeFlagBits::READ;
@@ -2874,11 +3482,332 @@ namespace daxa
         }
     }
 
+    // Device::create_command_recorder only creates main queue recorders.
+    // Tasks always receive a CommandRecorder, tasks on compute and transfer queues must only record commands their queue supports.
+    auto create_task_recorder(Device & device, QueueFamily queue_family, bool reusable = false) -> CommandRecorder
+    {
+        CommandRecorderInfo const recorder_info = {.queue_family = queue_family, .reusable = reusable};
+        CommandRecorder ret = {};
+        check_result(
+            daxa_dvc_create_command_recorder(
+                device.get(),
+                reinterpret_cast<daxa_CommandRecorderInfo const *>(&recorder_info),
+                reinterpret_cast<daxa_CommandRecorder *>(&ret)),
+            "failed to create task command recorder");
+        return ret;
+    }
+
+    void write_gpu_timestamp(ImplTaskGraph & impl, ImplTaskRuntimeInterface & impl_runtime, TaskBatch const & task_batch, u32 query, PipelineStageFlags stage)
+    {
+        if (impl.gpu_timing_query_pool == nullptr || task_batch.gpu_timing_query_offset == std::numeric_limits<u32>::max())
+        {
+            return;
+        }
+        impl_runtime.recorder.write_timestamp({
+            .query_pool = *impl.gpu_timing_query_pool,
+            .pipeline_stage = stage,
+            .query_index = task_batch.gpu_timing_query_offset + query,
+        });
+    }
+
+    void execute_timed_task(ImplTaskGraph & impl, TaskGraphPermutation & permutation, ImplTaskRuntimeInterface & impl_runtime, TaskBatch const & task_batch, u32 batch_index, usize task_index)
+    {
+        write_gpu_timestamp(impl, impl_runtime, task_batch, 3 + 2 * static_cast<u32>(task_index), PipelineStageFlagBits::TOP_OF_PIPE);
+        impl.execute_task(impl_runtime, permutation, batch_index, task_index, task_batch.tasks[task_index]);
+        write_gpu_timestamp(impl, impl_runtime, task_batch, 4 + 2 * static_cast<u32>(task_index), PipelineStageFlagBits::ALL_COMMANDS);
+    }
+
+    void record_task_batch_begin(ImplTaskGraph & impl, TaskGraphPermutation & permutation, ImplTaskRuntimeInterface & impl_runtime, TaskBatch & task_batch)
+    {
+        write_gpu_timestamp(impl, impl_runtime, task_batch, 0, PipelineStageFlagBits::TOP_OF_PIPE);
+        // Wait on pipeline barriers before batch execution.
+        for (auto barrier_index : task_batch.pipeline_barrier_indices)
+        {
+            TaskBarrier & barrier = permutation.barriers[barrier_index];
+            insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
+        }
+        // Wait on split barriers before batch execution.
+        if (!impl.info.use_split_barriers)
+        {
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
+                // Convert split barrier to normal barrier.
+                TaskBarrier barrier = split_barrier;
+                insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
+            }
+        }
+        else
+        {
+            usize needed_image_barriers = 0;
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
+                if (!split_barrier.image_id.is_empty())
+                {
+                    needed_image_barriers += impl.get_actual_images(split_barrier.image_id, permutation).size();
+                }
+            }
+            tl_split_barrier_wait_infos.reserve(task_batch.wait_split_barrier_indices.size());
+            tl_memory_barrier_infos.reserve(task_batch.wait_split_barrier_indices.size());
+            tl_image_barrier_infos.reserve(needed_image_barriers);
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                TaskSplitBarrier & split_barrier = permutation.split_barriers[barrier_index];
+                if (split_barrier.image_id.is_empty())
+                {
+                    tl_memory_barrier_infos.push_back(MemoryBarrierInfo{
+                        .src_access = split_barrier.src_access,
+                        .dst_access = split_barrier.dst_access,
+                    });
+                    tl_split_barrier_wait_infos.push_back(EventWaitInfo{
+                        .memory_barriers = std::span{&tl_memory_barrier_infos.back(), 1},
+                        .event = split_barrier.split_barrier_state,
+                    });
+                }
+                else
+                {
+                    usize const img_bar_vec_start_size = tl_image_barrier_infos.size();
+                    for (auto image : impl.get_actual_images(split_barrier.image_id, permutation))
+                    {
+                        tl_image_barrier_infos.push_back(ImageMemoryBarrierInfo{
+                            .src_access = split_barrier.src_access,
+                            .dst_access = split_barrier.dst_access,
+                            .src_layout = split_barrier.layout_before,
+                            .dst_layout = split_barrier.layout_after,
+                            .image_slice = split_barrier.slice,
+                            .image_id = image,
+                        });
+                    }
+                    usize const img_bar_vec_end_size = tl_image_barrier_infos.size();
+                    usize const img_bar_count = img_bar_vec_end_size - img_bar_vec_start_size;
+                    tl_split_barrier_wait_infos.push_back(EventWaitInfo{
+                        .image_barriers = std::span{tl_image_barrier_infos.data() + img_bar_vec_start_size, img_bar_count},
+                        .event = split_barrier.split_barrier_state,
+                    });
+                }
+            }
+            if (!tl_split_barrier_wait_infos.empty())
+            {
+                impl_runtime.recorder.wait_events(tl_split_barrier_wait_infos);
+            }
+            tl_split_barrier_wait_infos.clear();
+            tl_image_barrier_infos.clear();
+            tl_memory_barrier_infos.clear();
+        }
+        write_gpu_timestamp(impl, impl_runtime, task_batch, 1, PipelineStageFlagBits::ALL_COMMANDS);
+    }
+
+    void record_task_batch_end(ImplTaskGraph & impl, TaskGraphPermutation & permutation, ImplTaskRuntimeInterface & impl_runtime, TaskBatch & task_batch)
+    {
+        if (impl.info.use_split_barriers)
+        {
+            // Reset all waited upon split barriers here.
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                // We wait on the stages, that waited on our split barrier earlier.
+                // This way, we make sure, that the stages that wait on the split barrier
+                // executed and saw the split barrier signaled, before we reset them.
+                impl_runtime.recorder.reset_event({
+                    .event = permutation.split_barriers[barrier_index].split_barrier_state,
+                    .stage = permutation.split_barriers[barrier_index].dst_access.stages,
+                });
+            }
+            // Signal all signal split barriers after batch execution.
+            for (usize const barrier_index : task_batch.signal_split_barrier_indices)
+            {
+                TaskSplitBarrier & task_split_barrier = permutation.split_barriers[barrier_index];
+                if (task_split_barrier.image_id.is_empty())
+                {
+                    MemoryBarrierInfo memory_barrier{
+                        .src_access = task_split_barrier.src_access,
+                        .dst_access = task_split_barrier.dst_access,
+                    };
+                    impl_runtime.recorder.signal_event({
+                        .memory_barriers = std::span{&memory_barrier, 1},
+                        .event = task_split_barrier.split_barrier_state,
+                    });
+                }
+                else
+                {
+                    for (auto image : impl.get_actual_images(task_split_barrier.image_id, permutation))
+                    {
+                        tl_image_barrier_infos.push_back({
+                            .src_access = task_split_barrier.src_access,
+                            .dst_access = task_split_barrier.dst_access,
+                            .src_layout = task_split_barrier.layout_before,
+                            .dst_layout = task_split_barrier.layout_after,
+                            .image_slice = task_split_barrier.slice,
+                            .image_id = image,
+                        });
+                    }
+                    impl_runtime.recorder.signal_event({
+                        .image_barriers = tl_image_barrier_infos,
+                        .event = task_split_barrier.split_barrier_state,
+                    });
+                    tl_image_barrier_infos.clear();
+                }
+            }
+        }
+        write_gpu_timestamp(impl, impl_runtime, task_batch, 2, PipelineStageFlagBits::ALL_COMMANDS);
+    }
+
+    // Every batch occupies one position per task and at least one position,
+    // so that batches without tasks still record their synchronization in exactly one chunk.
+    auto submit_scope_position_count(TaskBatchSubmitScope const & submit_scope) -> usize
+    {
+        usize position_count = 0;
+        for (auto const & task_batch : submit_scope.task_batches)
+        {
+            position_count += std::max(task_batch.tasks.size(), usize{1});
+        }
+        return position_count;
+    }
+
+    // Records the positions [chunk_begin, chunk_end) of a submit scope.
+    // The chunk containing the first position of a batch records its waits, the chunk containing the last position records its signals.
+    void record_submit_scope_chunk(
+        ImplTaskGraph & impl,
+        TaskGraphPermutation & permutation,
+        ImplTaskRuntimeInterface & impl_runtime,
+        TaskBatchSubmitScope & submit_scope,
+        usize const chunk_begin,
+        usize const chunk_end)
+    {
+        usize batch_begin = 0;
+        usize batch_index = 0;
+        for (auto & task_batch : submit_scope.task_batches)
+        {
+            batch_index += 1;
+            usize const batch_end = batch_begin + std::max(task_batch.tasks.size(), usize{1});
+            if (batch_begin >= chunk_end)
+            {
+                break;
+            }
+            if (batch_end > chunk_begin)
+            {
+                if (batch_begin >= chunk_begin)
+                {
+                    record_task_batch_begin(impl, permutation, impl_runtime, task_batch);
+                }
+                usize const first_task_index = std::max(batch_begin, chunk_begin) - batch_begin;
+                usize const end_task_index = std::min(std::min(batch_end, chunk_end) - batch_begin, task_batch.tasks.size());
+                for (usize task_index = first_task_index; task_index < end_task_index; ++task_index)
+                {
+                    execute_timed_task(impl, permutation, impl_runtime, task_batch, static_cast<u32>(batch_index), task_index);
+                }
+                if (batch_end <= chunk_end)
+                {
+                    record_task_batch_end(impl, permutation, impl_runtime, task_batch);
+                }
+            }
+            batch_begin = batch_end;
+        }
+    }
+
+    void record_task_batch(ImplTaskGraph & impl, TaskGraphPermutation & permutation, ImplTaskRuntimeInterface & impl_runtime, TaskBatch & task_batch, u32 batch_index)
+    {
+        record_task_batch_begin(impl, permutation, impl_runtime, task_batch);
+        for (usize task_index = 0; task_index < task_batch.tasks.size(); ++task_index)
+        {
+            execute_timed_task(impl, permutation, impl_runtime, task_batch, batch_index, task_index);
+        }
+        record_task_batch_end(impl, permutation, impl_runtime, task_batch);
+    }
+
+    // Records a submit scope containing static batch runs.
+    // Each run is replayed from its cached command list, it is recorded into a new reusable recorder when there is none.
+    // The current recorder is completed before each run, all completed lists are appended to scope_command_lists in submission order.
+    void record_submit_scope_with_static_runs(
+        ImplTaskGraph & impl,
+        TaskGraphPermutation & permutation,
+        ImplTaskRuntimeInterface & impl_runtime,
+        TaskBatchSubmitScope & submit_scope,
+        std::vector<ExecutableCommandList> & scope_command_lists)
+    {
+        auto static_run = submit_scope.static_batch_runs.begin();
+        usize batch_index = 0;
+        while (batch_index < submit_scope.task_batches.size())
+        {
+            if (static_run == submit_scope.static_batch_runs.end() || static_run->first_batch_index != batch_index)
+            {
+                record_task_batch(impl, permutation, impl_runtime, submit_scope.task_batches[batch_index], static_cast<u32>(batch_index + 1));
+                ++batch_index;
+                continue;
+            }
+            if (!static_run->commands.has_value())
+            {
+                // The recorder is destroyed right after recording, the cached list keeps its command buffer alive.
+                CommandRecorder static_recorder = create_task_recorder(impl.info.device, submit_scope.queue.family, true);
+                ImplTaskRuntimeInterface static_runtime{.task_graph = impl, .permutation = permutation, .recorder = static_recorder};
+                for (usize run_batch_index = static_run->first_batch_index; run_batch_index < static_run->end_batch_index; ++run_batch_index)
+                {
+                    record_task_batch(impl, permutation, static_runtime, submit_scope.task_batches[run_batch_index], static_cast<u32>(run_batch_index + 1));
+                }
+                static_run->commands = static_recorder.complete_current_commands();
+            }
+            scope_command_lists.push_back(impl_runtime.recorder.complete_current_commands());
+            scope_command_lists.push_back(static_run->commands.value());
+            batch_index = static_run->end_batch_index;
+            ++static_run;
+        }
+    }
+
+    // Cached static commands contain the runtime ids of persistent resources.
+    // All cached commands of the permutation are dropped when any of these ids changed since they were recorded.
+    void invalidate_outdated_static_commands(ImplTaskGraph & impl, TaskGraphPermutation & permutation)
+    {
+        std::vector<u64> resource_ids = {};
+        for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
+        {
+            if (permutation.buffer_infos[task_buffer_index].valid && impl.global_buffer_infos[task_buffer_index].is_persistent())
+            {
+                std::visit(
+                    [&](auto const & ids)
+                    {
+                        for (auto const & id : ids)
+                        {
+                            resource_ids.push_back(std::bit_cast<u64>(id));
+                        }
+                    },
+                    impl.global_buffer_infos[task_buffer_index].get_persistent().actual_ids);
+            }
+        }
+        for (usize task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
+        {
+            if (permutation.image_infos[task_image_index].valid && impl.global_image_infos[task_image_index].is_persistent())
+            {
+                auto const & persistent_image = impl.global_image_infos[task_image_index].get_persistent();
+                // Batches using the swapchain image are never cached.
+                if (persistent_image.info.swapchain_image)
+                {
+                    continue;
+                }
+                for (ImageId const id : persistent_image.actual_images)
+                {
+                    resource_ids.push_back(std::bit_cast<u64>(id));
+                }
+            }
+        }
+        if (resource_ids != permutation.static_commands_resource_ids)
+        {
+            for (auto & submit_scope : permutation.batch_submit_scopes)
+            {
+                for (auto & static_run : submit_scope.static_batch_runs)
+                {
+                    static_run.commands.reset();
+                }
+            }
+            permutation.static_commands_resource_ids = std::move(resource_ids);
+        }
+    }
+
     /// Execution flow:
     /// 1. choose permutation based on conditionals
     /// 2. validate used persistent resources, based on permutation
     /// 3. runtime generate and insert runtime sync for persistent resources.
     /// 4. for every submit scope:
+    ///     2.0 replay cached static batch runs or, when recording in parallel, split the batches of the scope into chunks recorded on the worker threads
     ///     2.1 for every batch in scope:
     ///         3.1 wait for pipeline and split barriers
     ///         3.2 for every task:
@@ -2895,25 +3824,112 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(info.permutation_condition_values.size() >= impl.info.permutation_condition_count, "Detected invalid permutation condition count");
         DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "task graphs must be completed before execution");
 
+        // Values past the condition count are ignored, they would index past the permutations.
         u32 permutation_index = {};
-        for (u32 index = 0; index < std::min(usize(32), info.permutation_condition_values.size()); ++index)
+        for (u32 index = 0; index < std::min(usize{impl.info.permutation_condition_count}, info.permutation_condition_values.size()); ++index)
         {
             permutation_index |= info.permutation_condition_values[index] ? (1u << index) : 0;
         }
         impl.chosen_permutation_last_execution = permutation_index;
         TaskGraphPermutation & permutation = impl.permutations[permutation_index];
+        if (permutation.jit_compilation.valid())
+        {
+            permutation.jit_compilation.get();
+        }
+        if (!permutation.compiled)
+        {
+            jit_compile_permutation(impl, permutation_index);
+        }
 
         CommandRecorder recorder = impl.info.device.create_command_recorder({});
+        QueueFamily recorder_queue_family = QueueFamily::MAIN;
 
         ImplTaskRuntimeInterface impl_runtime{.task_graph = impl, .permutation = permutation, .recorder = recorder};
 
         validate_runtime_resources(impl, permutation);
+        if (impl.info.cache_static_tasks)
+        {
+            invalidate_outdated_static_commands(impl, permutation);
+        }
+        impl.gpu_timing_query_pool = nullptr;
+        if (impl.info.enable_gpu_timing && permutation.gpu_timing_query_count > 0)
+        {
+            impl.gpu_timing_query_pool = &impl.begin_gpu_timing_frame(permutation_index);
+            recorder.reset_timestamps({
+                .query_pool = *impl.gpu_timing_query_pool,
+                .start_index = 0,
+                .count = permutation.gpu_timing_query_count,
+            });
+        }
         // Generate and insert synchronization for persistent resources:
         generate_persistent_resource_synch(impl, permutation, recorder);
 
+        // Consecutive submit scopes to the same queue are collected and handed to the device as one batch.
+        // The batch is flushed when the queue changes, before presenting and after the last scope.
+        auto & pending_submits = impl.pending_submits;
+        // Left over when a previous execution threw while submitting.
+        impl.pending_submit_count = 0;
+        // Entries are cleared in place, so their vectors keep their capacity across submits and executions.
+        auto acquire_pending_submit = [&]() -> ImplTaskGraph::PendingSubmit &
+        {
+            if (impl.pending_submit_count == pending_submits.size())
+            {
+                pending_submits.emplace_back();
+            }
+            ImplTaskGraph::PendingSubmit & pending_submit = pending_submits[impl.pending_submit_count++];
+            pending_submit.commands.clear();
+            pending_submit.wait_binary_semaphores.clear();
+            pending_submit.signal_binary_semaphores.clear();
+            pending_submit.wait_timeline_semaphores.clear();
+            pending_submit.signal_timeline_semaphores.clear();
+            return pending_submit;
+        };
+        auto flush_pending_submits = [&]()
+        {
+            if (impl.pending_submit_count == 0)
+            {
+                return;
+            }
+            auto & submit_infos = impl.submit_infos;
+            submit_infos.clear();
+            for (usize pending_submit_index = 0; pending_submit_index < impl.pending_submit_count; ++pending_submit_index)
+            {
+                auto const & pending_submit = pending_submits[pending_submit_index];
+                submit_infos.push_back(CommandSubmitInfo{
+                    .queue = pending_submit.queue,
+                    .wait_stages = pending_submit.wait_stages,
+                    .command_lists = pending_submit.commands,
+                    .wait_binary_semaphores = pending_submit.wait_binary_semaphores,
+                    .signal_binary_semaphores = pending_submit.signal_binary_semaphores,
+                    .wait_timeline_semaphores = pending_submit.wait_timeline_semaphores,
+                    .signal_timeline_semaphores = pending_submit.signal_timeline_semaphores,
+                });
+            }
+            impl.info.device.submit_commands_batch(submit_infos);
+            submit_infos.clear();
+            // The submitted command lists are released now, not when the entry is reused.
+            for (usize pending_submit_index = 0; pending_submit_index < impl.pending_submit_count; ++pending_submit_index)
+            {
+                pending_submits[pending_submit_index].commands.clear();
+            }
+            impl.pending_submit_count = 0;
+        };
+
+        // Submit scopes waited on by other queues signal the timeline semaphore of their queue.
+        // The first submit on each queue waits on the join of the last execution, if it was on another queue.
+        usize const join_submit_scope_index = permutation.batch_submit_scopes.size() - 2;
+        std::vector<u64> submit_scope_timeline_values(permutation.batch_submit_scopes.size(), 0);
+        std::vector<Queue> queues_submitted_to = {};
+
         usize submit_scope_index = 0;
         for (auto & submit_scope : permutation.batch_submit_scopes)
         {
+            if (submit_scope.queue.family != recorder_queue_family)
+            {
+                // The previous recorder was completed by the previous submit, completed command lists keep it alive.
+                recorder = create_task_recorder(impl.info.device, submit_scope.queue.family);
+                recorder_queue_family = submit_scope.queue.family;
+            }
             if (impl.info.enable_command_labels)
             {
                 impl_runtime.recorder.begin_label({
@@ -2921,141 +3937,44 @@ namespace daxa
                     .name = impl.info.name + std::string(", submit ") + std::to_string(submit_scope_index),
                 });
             }
-            usize batch_index = 0;
-            for (auto & task_batch : submit_scope.task_batches)
+            usize const position_count = submit_scope_position_count(submit_scope);
+            // Debug information is written in recording order, so it is always recorded on the calling thread.
+            usize const chunk_count = impl.recording_workers != nullptr && !impl.info.record_debug_information
+                                          ? std::min(usize{impl.info.recording_thread_count}, position_count / MIN_TASKS_PER_RECORDING_CHUNK)
+                                          : usize{1};
+            // Command lists submitted before the lists of the current recorder.
+            std::vector<ExecutableCommandList> scope_command_lists = {};
+            if (!submit_scope.static_batch_runs.empty())
             {
-                batch_index += 1;
-                // Wait on pipeline barriers before batch execution.
-                for (auto barrier_index : task_batch.pipeline_barrier_indices)
-                {
-                    TaskBarrier & barrier = permutation.barriers[barrier_index];
-                    insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
-                }
-                // Wait on split barriers before batch execution.
-                if (!impl.info.use_split_barriers)
-                {
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
-                        // Convert split barrier to normal barrier.
-                        TaskBarrier barrier = split_barrier;
-                        insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
-                    }
-                }
-                else
-                {
-                    usize needed_image_barriers = 0;
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
-                        if (!split_barrier.image_id.is_empty())
-                        {
-                            needed_image_barriers += impl.get_actual_images(split_barrier.image_id, permutation).size();
-                        }
-                    }
-                    tl_split_barrier_wait_infos.reserve(task_batch.wait_split_barrier_indices.size());
-                    tl_memory_barrier_infos.reserve(task_batch.wait_split_barrier_indices.size());
-                    tl_image_barrier_infos.reserve(needed_image_barriers);
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        TaskSplitBarrier & split_barrier = permutation.split_barriers[barrier_index];
-                        if (split_barrier.image_id.is_empty())
-                        {
-                            tl_memory_barrier_infos.push_back(MemoryBarrierInfo{
-                                .src_access = split_barrier.src_access,
-                                .dst_access = split_barrier.dst_access,
-                            });
-                            tl_split_barrier_wait_infos.push_back(EventWaitInfo{
-                                .memory_barriers = std::span{&tl_memory_barrier_infos.back(), 1},
-                                .event = split_barrier.split_barrier_state,
-                            });
-                        }
-                        else
-                        {
-                            usize const img_bar_vec_start_size = tl_image_barrier_infos.size();
-                            for (auto image : impl.get_actual_images(split_barrier.image_id, permutation))
-                            {
-                                tl_image_barrier_infos.push_back(ImageMemoryBarrierInfo{
-                                    .src_access = split_barrier.src_access,
-                                    .dst_access = split_barrier.dst_access,
-                                    .src_layout = split_barrier.layout_before,
-                                    .dst_layout = split_barrier.layout_after,
-                                    .image_slice = split_barrier.slice,
-                                    .image_id = image,
-                                });
-                            }
-                            usize const img_bar_vec_end_size = tl_image_barrier_infos.size();
-                            usize const img_bar_count = img_bar_vec_end_size - img_bar_vec_start_size;
-                            tl_split_barrier_wait_infos.push_back(EventWaitInfo{
-                                .image_barriers = std::span{tl_image_barrier_infos.data() + img_bar_vec_start_size, img_bar_count},
-                                .event = split_barrier.split_barrier_state,
-                            });
-                        }
-                    }
-                    if (!tl_split_barrier_wait_infos.empty())
-                    {
-                        impl_runtime.recorder.wait_events(tl_split_barrier_wait_infos);
-                    }
-                    tl_split_barrier_wait_infos.clear();
-                    tl_image_barrier_infos.clear();
-                    tl_memory_barrier_infos.clear();
-                }
-                // Execute all tasks in the batch.
-                usize task_index = 0;
-                for (TaskId const task_id : task_batch.tasks)
-                {
-                    impl.execute_task(impl_runtime, permutation, batch_index, task_index, task_id);
-                    task_index += 1;
-                }
-                if (impl.info.use_split_barriers)
-                {
-                    // Reset all waited upon split barriers here.
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        // We wait on the stages, that waited on our split barrier earlier.
-                        // This way, we make sure, that the stages that wait on the split barrier
-                        // executed and saw the split barrier signaled, before we reset them.
-                        impl_runtime.recorder.reset_event({
-                            .event = permutation.split_barriers[barrier_index].split_barrier_state,
-                            .stage = permutation.split_barriers[barrier_index].dst_access.stages,
-                        });
-                    }
-                    // Signal all signal split barriers after batch execution.
-                    for (usize const barrier_index : task_batch.signal_split_barrier_indices)
+                record_submit_scope_with_static_runs(impl, permutation, impl_runtime, submit_scope, scope_command_lists);
+            }
+            else if (chunk_count <= 1)
+            {
+                record_submit_scope_chunk(impl, permutation, impl_runtime, submit_scope, 0, position_count);
+            }
+            else
+            {
+                // The first chunk continues the main recorder, all other chunks get their own recorder.
+                // The command lists are submitted in chunk order, which keeps the barriers and events valid between them.
+                scope_command_lists.resize(chunk_count);
+                usize const chunk_size = (position_count + chunk_count - 1) / chunk_count;
+                impl.recording_workers->run(
+                    chunk_count,
+                    [&](usize chunk_index)
                     {
-                        TaskSplitBarrier & task_split_barrier = permutation.split_barriers[barrier_index];
-                        if (task_split_barrier.image_id.is_empty())
+                        usize const chunk_begin = chunk_index * chunk_size;
+                        usize const chunk_end = std::min(chunk_begin + chunk_size, position_count);
+                        if (chunk_index == 0)
                         {
-                            MemoryBarrierInfo memory_barrier{
-                                .src_access = task_split_barrier.src_access,
-                                .dst_access = task_split_barrier.dst_access,
-                            };
-                            impl_runtime.recorder.signal_event({
-                                .memory_barriers = std::span{&memory_barrier, 1},
-                                .event = task_split_barrier.split_barrier_state,
-                            });
+                            record_submit_scope_chunk(impl, permutation, impl_runtime, submit_scope, chunk_begin, chunk_end);
+                            scope_command_lists[0] = recorder.complete_current_commands();
+                            return;
                         }
-                        else
-                        {
-                            for (auto image : impl.get_actual_images(task_split_barrier.image_id, permutation))
-                            {
-                                tl_image_barrier_infos.push_back({
-                                    .src_access = task_split_barrier.src_access,
-                                    .dst_access = task_split_barrier.dst_access,
-                                    .src_layout = task_split_barrier.layout_before,
-                                    .dst_layout = task_split_barrier.layout_after,
-                                    .image_slice = task_split_barrier.slice,
-                                    .image_id = image,
-                                });
-                            }
-                            impl_runtime.recorder.signal_event({
-                                .image_barriers = tl_image_barrier_infos,
-                                .event = task_split_barrier.split_barrier_state,
-                            });
-                            tl_image_barrier_infos.clear();
-                        }
-                    }
-                }
+                        CommandRecorder chunk_recorder = create_task_recorder(impl.info.device, submit_scope.queue.family);
+                        ImplTaskRuntimeInterface chunk_runtime{.task_graph = impl, .permutation = permutation, .recorder = chunk_recorder};
+                        record_submit_scope_chunk(impl, permutation, chunk_runtime, submit_scope, chunk_begin, chunk_end);
+                        scope_command_lists[chunk_index] = chunk_recorder.complete_current_commands();
+                    });
             }
             for (usize const barrier_index : submit_scope.last_minute_barrier_indices)
             {
@@ -3069,12 +3988,26 @@ namespace daxa
 
             if (&submit_scope != &permutation.batch_submit_scopes.back())
             {
-                PipelineStageFlags const wait_stages = submit_scope.submit_info.wait_stages;
-                std::vector<ExecutableCommandList> commands = {submit_scope.submit_info.command_lists.begin(), submit_scope.submit_info.command_lists.end()};
-                std::vector<BinarySemaphore> wait_binary_semaphores = {submit_scope.submit_info.wait_binary_semaphores.begin(), submit_scope.submit_info.wait_binary_semaphores.end()};
-                std::vector<BinarySemaphore> signal_binary_semaphores = {submit_scope.submit_info.signal_binary_semaphores.begin(), submit_scope.submit_info.signal_binary_semaphores.end()};
-                std::vector<std::pair<TimelineSemaphore, u64>> wait_timeline_semaphores = {submit_scope.submit_info.wait_timeline_semaphores.begin(), submit_scope.submit_info.wait_timeline_semaphores.end()};
-                std::vector<std::pair<TimelineSemaphore, u64>> signal_timeline_semaphores = {submit_scope.submit_info.signal_timeline_semaphores.begin(), submit_scope.submit_info.signal_timeline_semaphores.end()};
+                Queue const submit_queue = submit_scope.queue;
+                if (impl.pending_submit_count != 0 && !is_same_queue(pending_submits[impl.pending_submit_count - 1].queue, submit_queue))
+                {
+                    flush_pending_submits();
+                }
+                // The submit is built directly in its pending entry.
+                ImplTaskGraph::PendingSubmit & pending_submit = acquire_pending_submit();
+                pending_submit.queue = submit_queue;
+                pending_submit.wait_stages = submit_scope.submit_info.wait_stages;
+                auto & commands = pending_submit.commands;
+                auto & wait_binary_semaphores = pending_submit.wait_binary_semaphores;
+                auto & signal_binary_semaphores = pending_submit.signal_binary_semaphores;
+                auto & wait_timeline_semaphores = pending_submit.wait_timeline_semaphores;
+                auto & signal_timeline_semaphores = pending_submit.signal_timeline_semaphores;
+                commands.assign(submit_scope.submit_info.command_lists.begin(), submit_scope.submit_info.command_lists.end());
+                wait_binary_semaphores.assign(submit_scope.submit_info.wait_binary_semaphores.begin(), submit_scope.submit_info.wait_binary_semaphores.end());
+                signal_binary_semaphores.assign(submit_scope.submit_info.signal_binary_semaphores.begin(), submit_scope.submit_info.signal_binary_semaphores.end());
+                wait_timeline_semaphores.assign(submit_scope.submit_info.wait_timeline_semaphores.begin(), submit_scope.submit_info.wait_timeline_semaphores.end());
+                signal_timeline_semaphores.assign(submit_scope.submit_info.signal_timeline_semaphores.begin(), submit_scope.submit_info.signal_timeline_semaphores.end());
+                commands.insert(commands.end(), scope_command_lists.begin(), scope_command_lists.end());
                 commands.push_back(recorder.complete_current_commands());
                 if (impl.info.swapchain.has_value())
                 {
@@ -3134,19 +4067,45 @@ namespace daxa
                 {
                     signal_timeline_semaphores.insert(signal_timeline_semaphores.end(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->begin(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->end());
                 }
-                signal_timeline_semaphores.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
-                daxa::CommandSubmitInfo const submit_info = {
-                    .wait_stages = wait_stages,
-                    .command_lists = commands,
-                    .wait_binary_semaphores = wait_binary_semaphores,
-                    .signal_binary_semaphores = signal_binary_semaphores,
-                    .wait_timeline_semaphores = wait_timeline_semaphores,
-                    .signal_timeline_semaphores = signal_timeline_semaphores,
-                };
-                impl.info.device.submit_commands(submit_info);
+                bool const is_join_submit = submit_scope_index == join_submit_scope_index;
+                for (usize const wait_scope_index : submit_scope.cross_queue_wait_scope_indices)
+                {
+                    wait_timeline_semaphores.emplace_back(
+                        impl.get_queue_timeline(permutation.batch_submit_scopes[wait_scope_index].queue),
+                        submit_scope_timeline_values[wait_scope_index]);
+                }
+                bool const first_submit_on_queue = std::none_of(queues_submitted_to.begin(), queues_submitted_to.end(), [&](Queue const & queue)
+                                                                { return is_same_queue(queue, submit_queue); });
+                if (first_submit_on_queue)
+                {
+                    queues_submitted_to.push_back(submit_queue);
+                    if (impl.last_execution_join.has_value() && !is_same_queue(impl.last_execution_join->first, submit_queue))
+                    {
+                        wait_timeline_semaphores.emplace_back(
+                            impl.get_queue_timeline(impl.last_execution_join->first),
+                            impl.last_execution_join->second);
+                    }
+                }
+                if (submit_scope.signals_cross_queue || (impl.uses_multiple_queues && is_join_submit))
+                {
+                    submit_scope_timeline_values[submit_scope_index] = ++impl.queue_timeline_value;
+                    signal_timeline_semaphores.emplace_back(
+                        impl.get_queue_timeline(submit_queue),
+                        submit_scope_timeline_values[submit_scope_index]);
+                    if (is_join_submit)
+                    {
+                        impl.last_execution_join = std::pair{submit_queue, submit_scope_timeline_values[submit_scope_index]};
+                    }
+                }
+                // With multiple queues only the join submit is ordered after all other submits, so only it may signal the staging memory.
+                if (!permutation.uses_multiple_queues || is_join_submit)
+                {
+                    signal_timeline_semaphores.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
+                }
 
                 if (submit_scope.present_info.has_value())
                 {
+                    flush_pending_submits();
                     ImplPresentInfo & impl_present_info = submit_scope.present_info.value();
                     std::vector<BinarySemaphore> present_wait_semaphores = impl_present_info.binary_semaphores;
                     DAXA_DBG_ASSERT_TRUE_M(impl.info.swapchain.has_value(), "must have swapchain registered in info on creation in order to use present.");
@@ -3166,6 +4125,7 @@ namespace daxa
             }
             ++submit_scope_index;
         }
+        flush_pending_submits();
 
         // Insert pervious uses into execution info for tje next executions synch.
         for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
@@ -3201,6 +4161,91 @@ namespace daxa
         }
     }
 
+    TaskRecordingWorkerPool::TaskRecordingWorkerPool(u32 worker_count)
+    {
+        workers.reserve(worker_count);
+        for (u32 i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back([this]()
+                                 { worker_main(); });
+        }
+    }
+
+    TaskRecordingWorkerPool::~TaskRecordingWorkerPool()
+    {
+        {
+            std::unique_lock lock{mtx};
+            stop = true;
+        }
+        work_cv.notify_all();
+        for (auto & worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void TaskRecordingWorkerPool::run(usize a_job_count, std::function<void(usize)> const & job)
+    {
+        {
+            std::unique_lock lock{mtx};
+            current_job = &job;
+            job_count = a_job_count;
+            next_job = 0;
+            finished_jobs = 0;
+            generation += 1;
+        }
+        work_cv.notify_all();
+        work_on_jobs();
+        std::unique_lock lock{mtx};
+        done_cv.wait(lock, [&]()
+                     { return finished_jobs == job_count; });
+        current_job = nullptr;
+    }
+
+    void TaskRecordingWorkerPool::worker_main()
+    {
+        u64 seen_generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock{mtx};
+                work_cv.wait(lock, [&]()
+                             { return stop || generation != seen_generation; });
+                if (stop)
+                {
+                    return;
+                }
+                seen_generation = generation;
+            }
+            work_on_jobs();
+        }
+    }
+
+    void TaskRecordingWorkerPool::work_on_jobs()
+    {
+        while (true)
+        {
+            usize job_index = {};
+            std::function<void(usize)> const * job = {};
+            {
+                std::unique_lock lock{mtx};
+                if (next_job >= job_count)
+                {
+                    return;
+                }
+                job_index = next_job++;
+                job = current_job;
+            }
+            (*job)(job_index);
+            std::unique_lock lock{mtx};
+            finished_jobs += 1;
+            if (finished_jobs == job_count)
+            {
+                done_cv.notify_all();
+            }
+        }
+    }
+
     ImplTaskGraph::ImplTaskGraph(TaskGraphInfo a_info)
         : unique_index{ImplTaskGraph::exec_unique_next_index++}, info{std::move(a_info)}
     {
@@ -3208,30 +4253,33 @@ namespace daxa
         {
             this->staging_memory = TransferMemoryPool{TransferMemoryPoolInfo{.device = info.device, .capacity = info.staging_memory_pool_size, .use_bar_memory = true, .name = "Transfer Memory Pool"}};
         }
+        if (info.recording_thread_count > 1)
+        {
+            // The thread calling execute records as well.
+            this->recording_workers = std::make_unique<TaskRecordingWorkerPool>(info.recording_thread_count - 1);
+        }
+        if (info.enable_gpu_timing)
+        {
+            this->gpu_timing_frames.resize(std::max(info.gpu_timing_frame_count, 1u));
+        }
     }
 
     ImplTaskGraph::~ImplTaskGraph()
     {
-        for (auto & task : tasks)
+        for (auto & permutation : permutations)
         {
-            for (auto & view_cache : task.image_view_cache)
+            if (permutation.jit_compilation.valid())
             {
-                for (auto & view : view_cache)
-                {
-                    if (info.device.is_id_valid(view))
-                    {
-                        ImageId const parent = info.device.image_view_info(view).value().image;
-                        bool const is_default_view = parent.default_view() == view;
-                        if (!is_default_view)
-                        {
-                            info.device.destroy_image_view(view);
-                        }
-                    }
-                }
+                permutation.jit_compilation.wait();
             }
         }
         for (auto & permutation : permutations)
         {
+            // Permutations compiled just in time only own transient resources once compiled.
+            if (!permutation.compiled)
+            {
+                continue;
+            }
             // because transient buffers are owned by the task graph, we need to destroy them
             for (u32 buffer_info_idx = 0; buffer_info_idx < static_cast<u32>(global_buffer_infos.size()); buffer_info_idx++)
             {
@@ -3426,7 +4474,10 @@ namespace daxa
                 }
             }
         };
-        fmt::format_to(std::back_inserter(out), "{}Resource lifetimes and aliasing:\n", indent);
+        fmt::format_to(std::back_inserter(out), "{}Resource lifetimes and aliasing (peak live size: {}, allocated size: {}):\n",
+                       indent,
+                       permutation.transient_memory_size.peak_live_size,
+                       permutation.transient_memory_size.allocated_size);
         for (u32 perm_image_idx = 0; perm_image_idx < permutation.image_infos.size(); perm_image_idx++)
         {
             if (global_image_infos.at(perm_image_idx).is_persistent() || !permutation.image_infos.at(perm_image_idx).valid)
@@ -3477,6 +4528,7 @@ namespace daxa
         fmt::format_to(std::back_inserter(out), "reorder tasks: {}\n", info.reorder_tasks);
         fmt::format_to(std::back_inserter(out), "use split barriers: {}\n", info.use_split_barriers);
         fmt::format_to(std::back_inserter(out), "permutation_condition_count: {}\n", info.permutation_condition_count);
+        fmt::format_to(std::back_inserter(out), "jit_compile_permutations: {}\n", info.jit_compile_permutations);
         fmt::format_to(std::back_inserter(out), "enable_command_labels: {}\n", info.enable_command_labels);
         fmt::format_to(std::back_inserter(out), "task_graph_label_color: ({},{},{},{})\n",
                        info.task_graph_label_color[0],
@@ -3495,6 +4547,8 @@ namespace daxa
                        info.task_label_color[3]);
         fmt::format_to(std::back_inserter(out), "record_debug_information: {}\n", info.record_debug_information);
         fmt::format_to(std::back_inserter(out), "staging_memory_pool_size: {}\n", info.staging_memory_pool_size);
+        fmt::format_to(std::back_inserter(out), "recording_thread_count: {}\n", info.recording_thread_count);
+        fmt::format_to(std::back_inserter(out), "enable_gpu_timing: {}\n", info.enable_gpu_timing);
         fmt::format_to(std::back_inserter(out), "executed permutation: {}\n", chosen_permutation_last_execution);
         usize permutation_index = this->chosen_permutation_last_execution;
         auto & permutation = this->permutations[permutation_index];
@@ -3506,8 +4560,12 @@ namespace daxa
             usize submit_scope_index = 0;
             for (auto & submit_scope : permutation.batch_submit_scopes)
             {
-                fmt::format_to(std::back_inserter(out), "{}submit scope: {}\n", indent, submit_scope_index);
+                fmt::format_to(std::back_inserter(out), "{}submit scope: {}, queue: {} {}\n", indent, submit_scope_index, to_string(submit_scope.queue.family), submit_scope.queue.index);
                 [[maybe_unused]] FormatIndent const d1{out, indent, true};
+                for (usize const wait_scope_index : submit_scope.cross_queue_wait_scope_indices)
+                {
+                    fmt::format_to(std::back_inserter(out), "{}waits on submit scope: {}\n", indent, wait_scope_index);
+                }
                 usize batch_index = 0;
                 for (auto & task_batch : submit_scope.task_batches)
                 {
@@ -4,6 +4,11 @@
 
 #include <variant>
 #include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
 #include <daxa/utils/task_graph.hpp>
 
 #define DAXA_TASK_GRAPH_MAX_CONDITIONALS 31
@@ -61,6 +66,8 @@ namespace daxa
         // we will combine all barriers into one, which is the first barrier that the first read generates.
         Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> latest_concurrent_access_barrer_index = Monostate{};
         std::variant<BufferId, BlasId, TlasId> actual_id = BufferId{};
+        // Resources used outside of the main queue are excluded from aliasing, as their lifetime is not ordered by batch index.
+        bool used_off_main_queue = {};
 
         ResourceLifetime lifetime = {};
         usize allocation_offset = {};
@@ -90,6 +97,8 @@ namespace daxa
         ResourceLifetime lifetime = {};
         ImageCreateFlags create_flags = ImageCreateFlagBits::NONE;
         ImageUsageFlags usage = ImageUsageFlagBits::NONE;
+        // Images used outside of the main queue are excluded from aliasing and must be shared concurrently between queue families.
+        bool used_off_main_queue = {};
         ImageId actual_image = {};
         usize allocation_offset = {};
         daxa::MemoryRequirements memory_requirements = {};
@@ -115,6 +124,7 @@ namespace daxa
     struct ImplTask
     {
         std::unique_ptr<ITask> base_task = {};
+        // Views per image attachment, owned by the devices image view cache.
         std::vector<std::vector<ImageViewId>> image_view_cache = {};
         // Used to verify image view cache:
         std::vector<std::vector<ImageId>> runtime_images_last_execution = {};
@@ -132,15 +142,33 @@ namespace daxa
         std::vector<usize> wait_split_barrier_indices = {};
         std::vector<TaskId> tasks = {};
         std::vector<usize> signal_split_barrier_indices = {};
+        // First timestamp query of the batch: batch begin, barriers end, batch end, followed by a begin and end query per task.
+        u32 gpu_timing_query_offset = std::numeric_limits<u32>::max();
+    };
+
+    // Consecutive batches of a submit scope only containing static tasks.
+    // Their commands are recorded once into a reusable command list and replayed until persistent resources change.
+    struct StaticTaskBatchRun
+    {
+        usize first_batch_index = {};
+        usize end_batch_index = {};
+        std::optional<ExecutableCommandList> commands = {};
     };
 
     struct TaskBatchSubmitScope
     {
+        Queue queue = QUEUE_MAIN;
         CommandSubmitInfo submit_info = {};
         TaskSubmitInfo user_submit_info = {};
+        // Earlier submit scopes on other queues this scope has to wait for before executing.
+        std::vector<usize> cross_queue_wait_scope_indices = {};
+        // Set when a later scope on another queue waits on this scope.
+        bool signals_cross_queue = {};
         // These barriers are inserted after all batches and their sync.
         std::vector<usize> last_minute_barrier_indices = {};
         std::vector<TaskBatch> task_batches = {};
+        // Only filled when static task caching is enabled.
+        std::vector<StaticTaskBatchRun> static_batch_runs = {};
         std::vector<u64> used_swapchain_task_images = {};
         std::optional<ImplPresentInfo> present_info = {};
     };
@@ -167,6 +195,15 @@ namespace daxa
         std::vector<TaskBatchSubmitScope> batch_submit_scopes = {};
         usize swapchain_image_first_use_submit_scope_index = std::numeric_limits<usize>::max();
         usize swapchain_image_last_use_submit_scope_index = std::numeric_limits<usize>::max();
+        bool uses_multiple_queues = {};
+        // Runtime ids of the persistent resources the cached static task commands were recorded with.
+        std::vector<u64> static_commands_resource_ids = {};
+        TaskTransientMemorySize transient_memory_size = {};
+        MemoryBlock transient_memory_block = {};
+        u32 gpu_timing_query_count = {};
+        bool compiled = {};
+        // Pending background compilation started by precompile_permutation.
+        std::future<void> jit_compilation = {};
 
         void add_task(ImplTaskGraph & task_graph_impl, ImplTask & impl_task, TaskId task_id);
         void submit(TaskSubmitInfo const & info);
@@ -334,6 +371,35 @@ namespace daxa
         std::optional<BinarySemaphore> last_submit_semaphore = {};
     };
 
+    // Tasks are only recorded in parallel when every chunk gets at least this many tasks.
+    static constexpr inline usize MIN_TASKS_PER_RECORDING_CHUNK = 8;
+
+    // Worker threads recording chunks of submit scopes in parallel.
+    // The calling thread takes part in the work while waiting.
+    struct TaskRecordingWorkerPool
+    {
+        TaskRecordingWorkerPool(u32 worker_count);
+        ~TaskRecordingWorkerPool();
+
+        // Runs job(i) for every i in [0, job_count) and returns when all jobs finished.
+        void run(usize job_count, std::function<void(usize)> const & job);
+
+      private:
+        void worker_main();
+        void work_on_jobs();
+
+        std::vector<std::thread> workers = {};
+        std::mutex mtx = {};
+        std::condition_variable work_cv = {};
+        std::condition_variable done_cv = {};
+        std::function<void(usize)> const * current_job = {};
+        usize job_count = {};
+        usize next_job = {};
+        usize finished_jobs = {};
+        u64 generation = {};
+        bool stop = {};
+    };
+
     struct ImplTaskGraph final : ImplHandle
     {
         ImplTaskGraph(TaskGraphInfo a_info);
@@ -360,14 +426,70 @@ namespace daxa
         std::unordered_map<std::string, TaskTlasView> tlas_name_to_id = {};
         std::unordered_map<std::string, TaskImageView> image_name_to_id = {};
 
+        // Sum of the transient memory blocks sizes. There is one block shared by all permutations, or one per permutation compiled just in time.
         usize memory_block_size = {};
-        u32 memory_type_bits = 0xFFFFFFFFu;
-        MemoryBlock transient_data_memory_block = {};
         bool compiled = {};
+        // With jit compilation, the recorded tasks, submits and presents are replayed into each permutation on its first use.
+        struct JitRecordedOperation
+        {
+            u32 active_conditional_scopes = {};
+            u32 conditional_states = {};
+            std::variant<TaskId, TaskSubmitInfo, TaskPresentInfo> operation = {};
+        };
+        std::vector<JitRecordedOperation> jit_recorded_operations = {};
+        std::mutex jit_compile_mutex = {};
+        // Set on completion when any permutation submits to more than one queue.
+        bool uses_multiple_queues = {};
 
         // execution time information:
         std::optional<daxa::TransferMemoryPool> staging_memory = {};
+        std::unique_ptr<TaskRecordingWorkerPool> recording_workers = {};
+        // One timeline semaphore per queue used for cross queue dependencies.
+        // All of them are signaled from a single counter, so values are increasing in submission order per queue.
+        struct QueueTimeline
+        {
+            Queue queue = {};
+            TimelineSemaphore semaphore = {};
+        };
+        std::vector<QueueTimeline> queue_timelines = {};
+        u64 queue_timeline_value = {};
+        // The last submit of an execution using multiple queues waits for all other queues.
+        // The next execution waits on this value on every queue other than the join queue.
+        std::optional<std::pair<Queue, u64>> last_execution_join = {};
+        // Scratch storage of the batched submits in execute, reused across executions to avoid reallocating every frame.
+        struct PendingSubmit
+        {
+            Queue queue = {};
+            PipelineStageFlags wait_stages = {};
+            std::vector<ExecutableCommandList> commands = {};
+            std::vector<BinarySemaphore> wait_binary_semaphores = {};
+            std::vector<BinarySemaphore> signal_binary_semaphores = {};
+            std::vector<std::pair<TimelineSemaphore, u64>> wait_timeline_semaphores = {};
+            std::vector<std::pair<TimelineSemaphore, u64>> signal_timeline_semaphores = {};
+        };
+        // Only the first pending_submit_count entries are pending, the others keep the capacity of their vectors for later submits.
+        std::vector<PendingSubmit> pending_submits = {};
+        usize pending_submit_count = {};
+        std::vector<CommandSubmitInfo> submit_infos = {};
         std::array<bool, DAXA_TASK_GRAPH_MAX_CONDITIONALS> execution_time_current_conditionals = {};
+        // Each execution writes its timestamps into the query pool of the next frame in the ring.
+        struct GpuTimingFrame
+        {
+            TimelineQueryPool query_pool = {};
+            u32 permutation_index = {};
+            u32 query_count = {};
+            u64 execution_index = {};
+            bool pending = {};
+        };
+        std::vector<GpuTimingFrame> gpu_timing_frames = {};
+        u64 gpu_timing_execution_count = {};
+        // Query pool of the current execution, null when the execution is not timed.
+        TimelineQueryPool * gpu_timing_query_pool = {};
+        // Scratch storage of the frame resolves, reused across executions.
+        std::vector<GpuTimingFrame *> gpu_timing_pending_frames = {};
+        std::vector<u64> gpu_timing_query_results = {};
+        // Overwritten in place on each resolve, so the timing names keep their capacity.
+        std::vector<TaskGpuTiming> gpu_timings = {};
 
         // post execution information:
         u32 chosen_permutation_last_execution = {};
@@ -487,7 +609,10 @@ namespace daxa
         void insert_pre_batch_barriers(TaskGraphPermutation & permutation);
         void create_transient_runtime_buffers(TaskGraphPermutation & permutation);
         void create_transient_runtime_images(TaskGraphPermutation & permutation);
-        void allocate_transient_resources();
+        auto allocate_transient_resources(std::span<TaskGraphPermutation> target_permutations) -> usize;
+        auto get_queue_timeline(Queue queue) -> TimelineSemaphore const &;
+        auto begin_gpu_timing_frame(u32 permutation_index) -> TimelineQueryPool &;
+        auto try_resolve_gpu_timing_frame(GpuTimingFrame & frame) -> bool;
         void print_task_buffer_blas_tlas_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation, TaskGPUResourceView local_id);
         void print_task_image_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation, TaskImageView image);
         void print_task_barrier_to(std::string & out, std::string & indent, TaskGraphPermutation const & permutation, usize index, bool const split_barrier);
@@ -0,0 +1,153 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/mem.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Compares 100000 small buffers created one by one against sub-allocations of a BufferSubAllocator.
+// Also checks the deferred reuse: memory freed while a submit is pending is not handed out again,
+// once that submit finished all freed memory is reused without creating new slabs.
+auto main() -> int
+{
+    constexpr daxa::u32 ALLOCATION_COUNT = 100'000;
+    // Sizes between 256 bytes and 4 KiB keep each full round of allocations around 150 MiB.
+    constexpr daxa::u32 MIN_SIZE_LOG2 = 8;
+    constexpr daxa::u32 MAX_SIZE_LOG2 = 12;
+
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {.max_allowed_buffers = ALLOCATION_COUNT + 1'024}));
+
+    std::mt19937 rng{42};
+    std::vector<daxa::u32> sizes(ALLOCATION_COUNT);
+    for (auto & size : sizes)
+    {
+        daxa::u32 const size_log2 = MIN_SIZE_LOG2 + static_cast<daxa::u32>(rng() % (MAX_SIZE_LOG2 - MIN_SIZE_LOG2 + 1));
+        size = (1u << size_log2) - static_cast<daxa::u32>(rng() % (1u << (size_log2 - 1)));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    int result = 0;
+    auto const check = [&](bool condition, char const * message)
+    {
+        if (!condition)
+        {
+            std::cerr << message << std::endl;
+            result = 1;
+        }
+    };
+
+    // Current path: one buffer, allocation and resource table slot each.
+    {
+        std::vector<daxa::BufferId> buffers(ALLOCATION_COUNT);
+        auto const create_start = Clock::now();
+        for (daxa::u32 i = 0; i < ALLOCATION_COUNT; ++i)
+        {
+            buffers[i] = device.create_buffer({.size = sizes[i], .name = "small buffer"});
+        }
+        auto const create_time = Clock::now() - create_start;
+        auto const destroy_start = Clock::now();
+        for (daxa::BufferId const buffer : buffers)
+        {
+            device.destroy_buffer(buffer);
+        }
+        device.collect_garbage();
+        auto const destroy_time = Clock::now() - destroy_start;
+        std::cout << "create_buffer: create " << milliseconds(create_time) << " ms, destroy and collect " << milliseconds(destroy_time) << " ms" << std::endl;
+    }
+
+    {
+        auto sub_allocator = daxa::BufferSubAllocator{{.device = device, .name = "sub allocator benchmark"}};
+        using Allocation = daxa::BufferSubAllocator::Allocation;
+        auto const block_key = [](Allocation const & allocation)
+        { return (static_cast<daxa::u64>(allocation.slab_index) << 32) | allocation.offset; };
+        auto const allocate_all = [&](std::vector<Allocation> & allocations)
+        {
+            allocations.clear();
+            for (daxa::u32 const size : sizes)
+            {
+                auto allocation = sub_allocator.allocate(size);
+                check(allocation.has_value() && allocation->size >= size, "a small allocation failed");
+                if (allocation.has_value())
+                {
+                    allocations.push_back(allocation.value());
+                }
+            }
+        };
+
+        std::vector<Allocation> first_allocations = {};
+        auto const allocate_start = Clock::now();
+        allocate_all(first_allocations);
+        auto const allocate_time = Clock::now() - allocate_start;
+
+        // Keeps a submit pending until the host signals the timeline, so the frees below stay deferred.
+        daxa::TimelineSemaphore blocker = device.create_timeline_semaphore({.name = "sub allocator blocker"});
+        auto recorder = device.create_command_recorder({.name = "sub allocator blocker"});
+        auto const blocked_commands = recorder.complete_current_commands();
+        device.submit_commands({
+            .command_lists = std::array{blocked_commands},
+            .wait_timeline_semaphores = std::array{std::pair{blocker, daxa::u64{1}}},
+        });
+
+        auto const free_start = Clock::now();
+        for (Allocation const & allocation : first_allocations)
+        {
+            sub_allocator.free(allocation);
+        }
+        auto const free_time = Clock::now() - free_start;
+
+        std::unordered_set<daxa::u64> pending_blocks = {};
+        for (Allocation const & allocation : first_allocations)
+        {
+            pending_blocks.insert(block_key(allocation));
+        }
+        std::vector<Allocation> second_allocations = {};
+        allocate_all(second_allocations);
+        daxa::u32 reused_while_pending = 0;
+        daxa::u32 slab_count = 0;
+        for (Allocation const & allocation : second_allocations)
+        {
+            reused_while_pending += pending_blocks.contains(block_key(allocation)) ? 1 : 0;
+            slab_count = std::max(slab_count, allocation.slab_index + 1);
+        }
+        check(reused_while_pending == 0, "memory freed while a submit is pending was reused");
+
+        blocker.set_value(1);
+        device.wait_idle();
+        for (Allocation const & allocation : second_allocations)
+        {
+            sub_allocator.free(allocation);
+        }
+        // All submits finished, every freed block is reusable and no new slab is needed.
+        std::vector<Allocation> third_allocations = {};
+        auto const reuse_start = Clock::now();
+        allocate_all(third_allocations);
+        auto const reuse_time = Clock::now() - reuse_start;
+        daxa::u32 new_slab_allocations = 0;
+        for (Allocation const & allocation : third_allocations)
+        {
+            new_slab_allocations += allocation.slab_index >= slab_count ? 1 : 0;
+        }
+        check(new_slab_allocations == 0, "freed memory was not reused after the pending submit finished");
+
+        std::cout << "BufferSubAllocator: allocate " << milliseconds(allocate_time) << " ms, free " << milliseconds(free_time)
+                  << " ms, allocate from reused blocks " << milliseconds(reuse_time) << " ms, " << slab_count << " slabs" << std::endl;
+
+        for (Allocation const & allocation : third_allocations)
+        {
+            sub_allocator.free(allocation);
+        }
+    }
+
+    device.wait_idle();
+    device.collect_garbage();
+    return result;
+}
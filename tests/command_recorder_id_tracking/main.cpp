@@ -0,0 +1,56 @@
+#include <daxa/daxa.hpp>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Records commands referencing 100000 buffer ids, each id several times, with and without id tracking.
+// Tracking should stay close to the untracked recording and its submit validation should scale with the distinct ids.
+auto main() -> int
+{
+    constexpr daxa::u32 BUFFER_COUNT = 100'000;
+    constexpr daxa::u32 USES_PER_ID = 4;
+    constexpr daxa::u32 ROUND_COUNT = 3;
+
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {.max_allowed_buffers = BUFFER_COUNT}));
+
+    std::vector<daxa::BufferInfo> const infos(BUFFER_COUNT, daxa::BufferInfo{.size = 16, .name = "id tracking"});
+    std::vector<daxa::BufferId> const ids = device.create_buffers(infos);
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    for (daxa::u32 round = 0; round < ROUND_COUNT; ++round)
+    {
+        for (bool const disable_id_tracking : {false, true})
+        {
+            auto recorder = device.create_command_recorder({.name = "id tracking", .disable_id_tracking = disable_id_tracking});
+            auto const record_start = Clock::now();
+            // Every id is used once before any is used again, so repeated uses are not just hits on the last stamp.
+            for (daxa::u32 use = 0; use < USES_PER_ID; ++use)
+            {
+                for (daxa::BufferId const id : ids)
+                {
+                    recorder.clear_buffer({.buffer = id, .offset = 0, .size = 4, .clear_value = use});
+                }
+            }
+            auto const record_time = Clock::now() - record_start;
+            auto const commands = recorder.complete_current_commands();
+            auto const submit_start = Clock::now();
+            device.submit_commands({.command_lists = std::array{commands}});
+            auto const submit_time = Clock::now() - submit_start;
+            device.wait_idle();
+
+            std::cout << "round " << round << (disable_id_tracking ? ", untracked" : ", tracked  ")
+                      << ": record " << milliseconds(record_time) << " ms, submit " << milliseconds(submit_time) << " ms" << std::endl;
+        }
+        device.collect_garbage();
+    }
+
+    device.destroy_buffers(ids);
+    device.collect_garbage();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <daxa/daxa.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Compares creating and destroying 10000 buffers one by one against the batched create_buffers and destroy_buffers.
+// Each round is collected before the next, so the batched round also exercises reserving recycled slots.
+auto main() -> int
+{
+    constexpr daxa::u32 BUFFER_COUNT = 10'000;
+    constexpr daxa::u32 ROUND_COUNT = 4;
+
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {.max_allowed_buffers = 2 * BUFFER_COUNT}));
+
+    std::vector<daxa::BufferInfo> infos(BUFFER_COUNT, daxa::BufferInfo{.size = 256, .name = "batched creation"});
+    std::vector<daxa::BufferId> ids(BUFFER_COUNT);
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    int result = 0;
+    for (daxa::u32 round = 0; round < ROUND_COUNT; ++round)
+    {
+        auto const single_create_start = Clock::now();
+        for (daxa::u32 i = 0; i < BUFFER_COUNT; ++i)
+        {
+            ids[i] = device.create_buffer(infos[i]);
+        }
+        auto const single_create_time = Clock::now() - single_create_start;
+        auto const single_destroy_start = Clock::now();
+        for (daxa::u32 i = 0; i < BUFFER_COUNT; ++i)
+        {
+            device.destroy_buffer(ids[i]);
+        }
+        auto const single_destroy_time = Clock::now() - single_destroy_start;
+        device.collect_garbage();
+
+        auto const batched_create_start = Clock::now();
+        ids = device.create_buffers(infos);
+        auto const batched_create_time = Clock::now() - batched_create_start;
+        for (daxa::BufferId const id : ids)
+        {
+            if (!device.is_buffer_id_valid(id))
+            {
+                std::cerr << "round " << round << ": batched creation returned an invalid id" << std::endl;
+                result = 1;
+                break;
+            }
+        }
+        auto const batched_destroy_start = Clock::now();
+        device.destroy_buffers(ids);
+        auto const batched_destroy_time = Clock::now() - batched_destroy_start;
+        device.collect_garbage();
+
+        std::cout << "round " << round
+                  << ": single create " << milliseconds(single_create_time) << " ms, destroy " << milliseconds(single_destroy_time) << " ms"
+                  << ", batched create " << milliseconds(batched_create_time) << " ms, destroy " << milliseconds(batched_destroy_time) << " ms" << std::endl;
+    }
+    return result;
+}
@@ -0,0 +1,106 @@
+#include <daxa/daxa.hpp>
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    // SPIR-V of an empty compute shader, the four character entry point name is patched per pipeline so that every pipeline is distinct:
+    //     OpCapability Shader
+    //     OpMemoryModel Logical GLSL450
+    //     OpEntryPoint GLCompute %main "NAME"
+    //     OpExecutionMode %main LocalSize 1 1 1
+    //     %void = OpTypeVoid
+    //     %fn = OpTypeFunction %void
+    //     %main = OpFunction %void None %fn
+    //     %entry = OpLabel
+    //     OpReturn
+    //     OpFunctionEnd
+    constexpr daxa::usize ENTRY_POINT_NAME_WORD = 13;
+    constexpr std::array<daxa::u32, 35> EMPTY_COMPUTE_SPIRV = {
+        0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000,   // header, id bound 5
+        0x00020011, 0x00000001,                                       // OpCapability
+        0x0003000E, 0x00000000, 0x00000001,                           // OpMemoryModel
+        0x0005000F, 0x00000005, 0x00000001, 0x6E69616D, 0x00000000,   // OpEntryPoint
+        0x00060010, 0x00000001, 0x00000011, 0x00000001, 0x00000001, 0x00000001, // OpExecutionMode
+        0x00020013, 0x00000002,                                       // OpTypeVoid
+        0x00030021, 0x00000003, 0x00000002,                           // OpTypeFunction
+        0x00050036, 0x00000002, 0x00000001, 0x00000000, 0x00000003,   // OpFunction
+        0x000200F8, 0x00000004,                                       // OpLabel
+        0x000100FD,                                                   // OpReturn
+        0x00010038,                                                   // OpFunctionEnd
+    };
+
+    auto create_pipelines(daxa::Device & device, daxa::u32 pipeline_count) -> std::vector<daxa::ComputePipeline>
+    {
+        std::vector<daxa::u32> spirv(EMPTY_COMPUTE_SPIRV.begin(), EMPTY_COMPUTE_SPIRV.end());
+        std::vector<daxa::ComputePipeline> pipelines = {};
+        pipelines.reserve(pipeline_count);
+        for (daxa::u32 i = 0; i < pipeline_count; ++i)
+        {
+            // "m" followed by three digits, the characters are packed starting at the lowest byte of the word.
+            std::array<char, 5> const name = {'m', static_cast<char>('0' + i / 100 % 10), static_cast<char>('0' + i / 10 % 10), static_cast<char>('0' + i % 10), '\0'};
+            spirv[ENTRY_POINT_NAME_WORD] = 0;
+            for (daxa::u32 c = 0; c < 4; ++c)
+            {
+                spirv[ENTRY_POINT_NAME_WORD] |= static_cast<daxa::u32>(static_cast<unsigned char>(name[c])) << (8 * c);
+            }
+            pipelines.push_back(device.create_compute_pipeline({
+                .shader_info = {.byte_code = spirv.data(), .byte_code_size = static_cast<daxa::u32>(spirv.size()), .entry_point = name.data()},
+                .name = "pipeline cache benchmark",
+            }));
+        }
+        return pipelines;
+    }
+} // namespace
+
+// Compares creating 600 distinct compute pipelines on a device with an empty pipeline cache (cold start)
+// against a second device that loaded the cache data written to disk by the first one (warm start).
+auto main() -> int
+{
+    constexpr daxa::u32 PIPELINE_COUNT = 600;
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    auto const cache_path = std::filesystem::temp_directory_path() / "daxa_device_pipeline_cache_benchmark.bin";
+    daxa::Instance instance = daxa::create_instance({});
+
+    Clock::duration cold_time = {};
+    {
+        daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+        auto const start = Clock::now();
+        auto const pipelines = create_pipelines(device, PIPELINE_COUNT);
+        cold_time = Clock::now() - start;
+        std::vector<std::byte> const cache_data = device.get_pipeline_cache_data();
+        auto out_file = std::ofstream{cache_path, std::ios::binary | std::ios::trunc};
+        out_file.write(reinterpret_cast<char const *>(cache_data.data()), static_cast<std::streamsize>(cache_data.size()));
+        std::cout << "pipeline cache data: " << cache_data.size() << " bytes" << std::endl;
+    }
+
+    int result = 0;
+    Clock::duration warm_time = {};
+    {
+        daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+        auto const start = Clock::now();
+        auto in_file = std::ifstream{cache_path, std::ios::binary};
+        std::vector<char> const file_data{std::istreambuf_iterator<char>(in_file), std::istreambuf_iterator<char>()};
+        if (!device.load_pipeline_cache_data({reinterpret_cast<std::byte const *>(file_data.data()), file_data.size()}))
+        {
+            std::cerr << "the pipeline cache data written by the same device and driver was rejected" << std::endl;
+            result = 1;
+        }
+        auto const pipelines = create_pipelines(device, PIPELINE_COUNT);
+        warm_time = Clock::now() - start;
+    }
+    std::filesystem::remove(cache_path);
+
+    std::cout << PIPELINE_COUNT << " pipelines, cold: " << milliseconds(cold_time) << " ms, warm (including loading the cache): " << milliseconds(warm_time) << " ms" << std::endl;
+    return result;
+}
@@ -0,0 +1,82 @@
+#include <daxa/daxa.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Measures resource slot churn with 1 to 8 threads creating and destroying image views of one image.
+// Image views allocate no memory, so the throughput is dominated by taking and returning slots of the resource pool.
+// Each thread collects garbage regularly, so destroyed slots are recycled through the free list while other threads create.
+auto main() -> int
+{
+    constexpr daxa::u32 CHURN_PER_THREAD = 1u << 15;
+    constexpr daxa::u32 VIEWS_IN_FLIGHT = 64;
+    constexpr daxa::u32 COLLECT_INTERVAL = 256;
+
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    daxa::ImageId const image = device.create_image({
+        .size = {64, 64, 1},
+        .mip_level_count = 4,
+        .usage = daxa::ImageUsageFlagBits::SHADER_SAMPLED,
+        .name = "slot churn",
+    });
+
+    int result = 0;
+    for (daxa::u32 thread_count = 1; thread_count <= 8; thread_count *= 2)
+    {
+        std::vector<daxa::u32> failures(thread_count, 0);
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads = {};
+        for (daxa::u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads.emplace_back([&, thread_index]()
+                                 {
+                std::vector<daxa::ImageViewId> views(VIEWS_IN_FLIGHT);
+                for (daxa::u32 i = 0; i < CHURN_PER_THREAD; ++i)
+                {
+                    daxa::ImageViewId & view = views[i % VIEWS_IN_FLIGHT];
+                    if (!view.is_empty())
+                    {
+                        device.destroy_image_view(view);
+                    }
+                    view = device.create_image_view({.image = image, .slice = {.base_mip_level = i % 4}});
+                    if (!device.is_image_view_id_valid(view))
+                    {
+                        ++failures[thread_index];
+                    }
+                    if (i % COLLECT_INTERVAL == COLLECT_INTERVAL - 1)
+                    {
+                        device.collect_garbage();
+                    }
+                }
+                for (daxa::ImageViewId const view : views)
+                {
+                    device.destroy_image_view(view);
+                } });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        device.collect_garbage();
+        daxa::u32 failure_count = 0;
+        for (auto const failure : failures)
+        {
+            failure_count += failure;
+        }
+        double const churns = static_cast<double>(CHURN_PER_THREAD) * thread_count;
+        std::cout << thread_count << " threads: " << churns / seconds / 1'000'000.0 << " M create/destroy pairs/s, " << failure_count << " failed" << std::endl;
+        if (failure_count != 0)
+        {
+            result = 1;
+        }
+    }
+
+    device.destroy_image(image);
+    device.collect_garbage();
+    return result;
+}
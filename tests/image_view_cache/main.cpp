@@ -0,0 +1,58 @@
+#include <daxa/daxa.hpp>
+
+#include <array>
+#include <iostream>
+
+// Checks that cached image views are shared per slice and are invalidated and destroyed together with their image,
+// for single and batched image destruction, and that a new image reusing the slot gets new views.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    int result = 0;
+    auto const check = [&](bool condition, char const * message)
+    {
+        if (!condition)
+        {
+            std::cerr << message << std::endl;
+            result = 1;
+        }
+    };
+
+    daxa::ImageInfo const image_info = {
+        .size = {64, 64, 1},
+        .mip_level_count = 4,
+        .usage = daxa::ImageUsageFlagBits::SHADER_SAMPLED,
+        .name = "image view cache",
+    };
+    auto const mip_view = [](daxa::ImageId image, daxa::u32 mip)
+    { return daxa::ImageViewInfo{.image = image, .slice = {.base_mip_level = mip, .level_count = 1}}; };
+
+    // Single destruction.
+    daxa::ImageId image = device.create_image(image_info);
+    daxa::ImageViewId const mip1 = device.cached_image_view(mip_view(image, 1));
+    daxa::ImageViewId const mip1_again = device.cached_image_view(mip_view(image, 1));
+    daxa::ImageViewId const mip2 = device.cached_image_view(mip_view(image, 2));
+    check(mip1 == mip1_again, "equal view infos must return the same cached view");
+    check(mip1 != mip2, "different slices must return different cached views");
+    check(device.is_image_view_id_valid(mip1) && device.is_image_view_id_valid(mip2), "cached views must be valid while their image is alive");
+
+    device.destroy_image(image);
+    check(!device.is_image_view_id_valid(mip1) && !device.is_image_view_id_valid(mip2), "cached views must be invalidated when their image is destroyed");
+    device.collect_garbage();
+
+    // The new image may reuse the slot of the destroyed one, its views must not be the stale cache entries.
+    daxa::ImageId const reused_image = device.create_image(image_info);
+    daxa::ImageViewId const reused_mip1 = device.cached_image_view(mip_view(reused_image, 1));
+    check(device.is_image_view_id_valid(reused_mip1), "a cached view of a new image must be valid");
+    check(reused_mip1 != mip1, "a new image must not get the cached views of a destroyed image");
+
+    // Batched destruction.
+    daxa::ImageId const other_image = device.create_image(image_info);
+    daxa::ImageViewId const other_mip3 = device.cached_image_view(mip_view(other_image, 3));
+    device.destroy_images(std::array{reused_image, other_image});
+    check(!device.is_image_view_id_valid(reused_mip1) && !device.is_image_view_id_valid(other_mip3), "cached views must be invalidated when their images are destroyed in a batch");
+    device.collect_garbage();
+    return result;
+}
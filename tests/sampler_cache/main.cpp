@@ -0,0 +1,61 @@
+#include <daxa/daxa.hpp>
+
+#include <iostream>
+#include <vector>
+
+// Checks that equal sampler infos share one refcounted sampler, that -0.0f and 0.0f are treated as equal,
+// and that cache hits do not take slots of the sampler pool.
+auto main() -> int
+{
+    constexpr daxa::u32 MAX_SAMPLERS = 16;
+
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {.max_allowed_samplers = MAX_SAMPLERS}));
+
+    int result = 0;
+    auto const check = [&](bool condition, char const * message)
+    {
+        if (!condition)
+        {
+            std::cerr << message << std::endl;
+            result = 1;
+        }
+    };
+
+    daxa::SamplerId const a = device.create_sampler({.min_lod = 0.0f, .name = "a"});
+    daxa::SamplerId const b = device.create_sampler({.min_lod = 0.0f, .name = "b"});
+    daxa::SamplerId const negative_zero = device.create_sampler({.mip_lod_bias = -0.0f, .min_lod = -0.0f});
+    daxa::SamplerId const zero_bias = device.create_sampler({.mip_lod_bias = 0.0f});
+    daxa::SamplerId const other = device.create_sampler({.max_lod = 4.0f});
+    check(a == b, "equal infos with different names must return the same sampler");
+    check(negative_zero == zero_bias, "-0.0f and 0.0f must return the same sampler");
+    check(negative_zero != a, "a different mip lod bias must return a different sampler");
+    check(other != a, "a different max lod must return a different sampler");
+
+    // a was returned twice, it stays valid until it was destroyed twice.
+    device.destroy_sampler(a);
+    check(device.is_sampler_id_valid(b), "a shared sampler must stay valid until its last reference is destroyed");
+    device.destroy_sampler(b);
+    check(!device.is_sampler_id_valid(b), "a sampler must be destroyed with its last reference");
+    daxa::SamplerId const recreated = device.create_sampler({.min_lod = 0.0f});
+    check(device.is_sampler_id_valid(recreated) && recreated != a, "an info of a destroyed sampler must create a new sampler");
+
+    // Repeated creations of a cached info take no new slots, far more of them than max_allowed_samplers must succeed.
+    std::vector<daxa::SamplerId> repeated_samplers = {};
+    for (daxa::u32 i = 0; i < 4 * MAX_SAMPLERS; ++i)
+    {
+        repeated_samplers.push_back(device.create_sampler({.max_lod = 4.0f}));
+        check(repeated_samplers.back() == other, "a repeated info must return the cached sampler");
+    }
+    for (daxa::SamplerId const id : repeated_samplers)
+    {
+        device.destroy_sampler(id);
+    }
+    check(device.is_sampler_id_valid(other), "the cached sampler must stay valid while its first reference is alive");
+    device.destroy_sampler(recreated);
+    device.destroy_sampler(other);
+    device.destroy_sampler(zero_bias);
+    device.destroy_sampler(negative_zero);
+    device.collect_garbage();
+    return result;
+}
@@ -0,0 +1,90 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Compares eager and jit permutation compilation for growing condition counts.
+// Prints the time spent in complete, the latency of the first execution and the transient memory of the graph.
+// With jit compilation, another permutation is precompiled in the background while the first one executes.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    constexpr daxa::u32 TRANSIENT_BUFFER_SIZE = 1u << 16;
+    constexpr daxa::u32 EXECUTION_COUNT = 8;
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    for (daxa::u32 condition_count = 1; condition_count <= 8; ++condition_count)
+    {
+        for (bool const jit : std::array{false, true})
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = device,
+                .alias_transients = true,
+                .jit_compile_permutations = jit,
+                .permutation_condition_count = condition_count,
+                .name = "jit compile benchmark",
+            });
+            auto const add_clear_task = [&](daxa::TaskBufferView buffer, daxa::u32 size)
+            {
+                task_graph.add_task(daxa::InlineTask{daxa::InlineTaskInfo{
+                    .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer)},
+                    .task = [buffer, size](daxa::TaskInterface ti)
+                    {
+                        ti.recorder.clear_buffer({.buffer = ti.get(buffer).ids[0], .size = size});
+                    },
+                    .name = "clear",
+                }});
+            };
+            for (daxa::u32 condition = 0; condition < condition_count; ++condition)
+            {
+                daxa::u32 const true_size = TRANSIENT_BUFFER_SIZE * (condition + 1);
+                daxa::u32 const false_size = TRANSIENT_BUFFER_SIZE;
+                auto true_buffer = task_graph.create_transient_buffer({.size = true_size, .name = "true " + std::to_string(condition)});
+                auto false_buffer = task_graph.create_transient_buffer({.size = false_size, .name = "false " + std::to_string(condition)});
+                task_graph.conditional({
+                    .condition_index = condition,
+                    .when_true = [&]()
+                    { add_clear_task(true_buffer, true_size); },
+                    .when_false = [&]()
+                    { add_clear_task(false_buffer, false_size); },
+                });
+            }
+            task_graph.submit({});
+
+            auto const complete_start = Clock::now();
+            task_graph.complete({});
+            auto const complete_time = Clock::now() - complete_start;
+
+            std::array<bool, 8> conditions = {};
+            auto const first_execute_start = Clock::now();
+            task_graph.execute({.permutation_condition_values = std::span{conditions.data(), condition_count}});
+            auto const first_execute_time = Clock::now() - first_execute_start;
+
+            std::array<bool, 8> other_conditions = {};
+            other_conditions.fill(true);
+            task_graph.precompile_permutation(std::span<bool const>{other_conditions.data(), condition_count});
+            for (daxa::u32 execution = 0; execution < EXECUTION_COUNT; ++execution)
+            {
+                task_graph.execute({.permutation_condition_values = std::span{conditions.data(), condition_count}});
+            }
+            task_graph.execute({.permutation_condition_values = std::span{other_conditions.data(), condition_count}});
+            device.wait_idle();
+            device.collect_garbage();
+
+            std::cout << "conditions: " << condition_count
+                      << ", jit: " << jit
+                      << ", complete: " << milliseconds(complete_time) << " ms"
+                      << ", first execute: " << milliseconds(first_execute_time) << " ms"
+                      << ", transient memory: " << task_graph.get_transient_memory_size() << " bytes" << std::endl;
+        }
+    }
+    return 0;
+}
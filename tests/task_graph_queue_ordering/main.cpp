@@ -0,0 +1,102 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+
+#include <iostream>
+
+// Writes a buffer on the main queue and reads it back on a transfer or compute queue.
+// The second task may only observe the written values when the graph orders the two
+// submits with its cross queue timeline semaphores. Runs on lavapipe.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    daxa::Queue other_queue = {};
+    if (device.queue_count(daxa::QueueFamily::TRANSFER) > 0)
+    {
+        other_queue = daxa::QUEUE_TRANSFER_0;
+    }
+    else if (device.queue_count(daxa::QueueFamily::COMPUTE) > 0)
+    {
+        other_queue = daxa::QUEUE_COMPUTE_0;
+    }
+    else
+    {
+        std::cout << "skipped: device has no transfer or compute queue" << std::endl;
+        return 0;
+    }
+
+    constexpr daxa::u32 VALUE_COUNT = 1u << 16;
+    constexpr daxa::usize SIZE = VALUE_COUNT * sizeof(daxa::u32);
+
+    daxa::BufferId src = device.create_buffer({.size = SIZE, .name = "src"});
+    daxa::BufferId dst = device.create_buffer({
+        .size = SIZE,
+        .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_RANDOM,
+        .name = "dst",
+    });
+
+    auto task_src = daxa::TaskBuffer({.initial_buffers = {.buffers = std::span<daxa::BufferId const>{&src, 1}}, .name = "src"});
+    auto task_dst = daxa::TaskBuffer({.initial_buffers = {.buffers = std::span<daxa::BufferId const>{&dst, 1}}, .name = "dst"});
+
+    daxa::u32 clear_value = 0;
+
+    auto task_graph = daxa::TaskGraph({.device = device, .name = "queue ordering"});
+    task_graph.use_persistent_buffer(task_src);
+    task_graph.use_persistent_buffer(task_dst);
+    task_graph.add_task(daxa::InlineTask{daxa::InlineTaskInfo{
+        .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_src)},
+        .task = [&](daxa::TaskInterface ti)
+        {
+            ti.recorder.clear_buffer({.buffer = ti.get(task_src).ids[0], .size = SIZE, .clear_value = clear_value});
+        },
+        .name = "write on main queue",
+        .queue = daxa::QUEUE_MAIN,
+    }});
+    task_graph.add_task(daxa::InlineTask{daxa::InlineTaskInfo{
+        .attachments = {
+            daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, task_src),
+            daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_dst),
+        },
+        .task = [&](daxa::TaskInterface ti)
+        {
+            ti.recorder.copy_buffer_to_buffer({
+                .src_buffer = ti.get(task_src).ids[0],
+                .dst_buffer = ti.get(task_dst).ids[0],
+                .size = SIZE,
+            });
+        },
+        .name = "read on other queue",
+        .queue = other_queue,
+    }});
+    task_graph.submit({});
+    task_graph.complete({});
+
+    int result = 0;
+    for (daxa::u32 iteration = 1; iteration <= 16; ++iteration)
+    {
+        clear_value = iteration * 0x01010101u;
+        task_graph.execute({});
+        device.wait_idle();
+
+        daxa::u32 const * values = device.buffer_host_address_as<daxa::u32>(dst).value();
+        for (daxa::u32 i = 0; i < VALUE_COUNT; ++i)
+        {
+            if (values[i] != clear_value)
+            {
+                std::cerr << "iteration " << iteration << ": dst[" << i << "] = " << values[i] << ", expected " << clear_value << std::endl;
+                result = 1;
+                break;
+            }
+        }
+        if (result != 0)
+        {
+            break;
+        }
+    }
+
+    device.destroy_buffer(src);
+    device.destroy_buffer(dst);
+    device.collect_garbage();
+    return result;
+}
@@ -0,0 +1,115 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+// Replays a cached static task over several executions.
+// The static task copies a host written buffer, so every replay must observe the value written for its execution,
+// while the task callback itself only runs when the commands are recorded the first time.
+// Also checks that reusable recorders, which static tasks record into, reject deferred destructions.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    constexpr daxa::u32 VALUE_COUNT = 1u << 10;
+    constexpr daxa::usize SIZE = VALUE_COUNT * sizeof(daxa::u32);
+    constexpr daxa::u32 EXECUTION_COUNT = 8;
+
+    daxa::BufferId src = device.create_buffer({
+        .size = SIZE,
+        .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_SEQUENTIAL_WRITE,
+        .name = "src",
+    });
+    daxa::BufferId dst = device.create_buffer({
+        .size = SIZE,
+        .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_RANDOM,
+        .name = "dst",
+    });
+
+    auto task_src = daxa::TaskBuffer({.initial_buffers = {.buffers = std::span<daxa::BufferId const>{&src, 1}}, .name = "src"});
+    auto task_dst = daxa::TaskBuffer({.initial_buffers = {.buffers = std::span<daxa::BufferId const>{&dst, 1}}, .name = "dst"});
+
+    daxa::u32 record_count = 0;
+    auto task_graph = daxa::TaskGraph({.device = device, .cache_static_tasks = true, .name = "static replay"});
+    task_graph.use_persistent_buffer(task_src);
+    task_graph.use_persistent_buffer(task_dst);
+    task_graph.add_task(daxa::InlineTask{daxa::InlineTaskInfo{
+        .attachments = {
+            daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, task_src),
+            daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_dst),
+        },
+        .task = [&](daxa::TaskInterface ti)
+        {
+            ti.recorder.copy_buffer_to_buffer({
+                .src_buffer = ti.get(task_src).ids[0],
+                .dst_buffer = ti.get(task_dst).ids[0],
+                .size = SIZE,
+            });
+            ++record_count;
+        },
+        .name = "static copy",
+        .is_static = true,
+    }});
+    task_graph.submit({});
+    task_graph.complete({});
+
+    int result = 0;
+    for (daxa::u32 execution = 1; execution <= EXECUTION_COUNT && result == 0; ++execution)
+    {
+        daxa::u32 const value = execution * 0x01010101u;
+        daxa::u32 * src_values = device.buffer_host_address_as<daxa::u32>(src).value();
+        for (daxa::u32 i = 0; i < VALUE_COUNT; ++i)
+        {
+            src_values[i] = value;
+        }
+        task_graph.execute({});
+        device.wait_idle();
+        device.collect_garbage();
+
+        daxa::u32 const * dst_values = device.buffer_host_address_as<daxa::u32>(dst).value();
+        for (daxa::u32 i = 0; i < VALUE_COUNT; ++i)
+        {
+            if (dst_values[i] != value)
+            {
+                std::cerr << "execution " << execution << ": dst[" << i << "] = " << dst_values[i] << ", expected " << value << std::endl;
+                result = 1;
+                break;
+            }
+        }
+    }
+    if (record_count != 1)
+    {
+        std::cerr << "static task was recorded " << record_count << " times, expected once" << std::endl;
+        result = 1;
+    }
+
+    daxa::BufferId temporary = device.create_buffer({.size = 64, .name = "temporary"});
+    bool rejected = false;
+    {
+        daxa::CommandRecorder recorder = device.create_command_recorder({.reusable = true});
+        try
+        {
+            recorder.destroy_buffer_deferred(temporary);
+        }
+        catch (std::runtime_error const &)
+        {
+            rejected = true;
+        }
+    }
+    if (!rejected)
+    {
+        std::cerr << "reusable recorder accepted a deferred destruction" << std::endl;
+        result = 1;
+    }
+    else
+    {
+        device.destroy_buffer(temporary);
+    }
+
+    device.destroy_buffer(src);
+    device.destroy_buffer(dst);
+    device.collect_garbage();
+    return result;
+}
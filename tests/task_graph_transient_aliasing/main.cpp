@@ -0,0 +1,96 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares the transient aliasing strategies on large synthetic lifetime sets.
+// The graphs are only completed, never executed, so no gpu work is recorded or submitted.
+// Prints the time spent in complete, the peak live size (the lower bound of any placement) and the placed size per strategy.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    // Every position is its own batch, the graph stays below 256 batches.
+    constexpr daxa::u32 POSITION_COUNT = 240;
+    constexpr daxa::u32 MAX_LIFETIME = 32;
+
+    using Clock = std::chrono::steady_clock;
+    auto const milliseconds = [](Clock::duration duration)
+    { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    int result = 0;
+    for (daxa::u32 const buffer_count : std::array{64u, 256u, 1024u})
+    {
+        // The same lifetime set is fed to both strategies.
+        struct Lifetime
+        {
+            daxa::u32 size = {};
+            daxa::u32 first_position = {};
+            daxa::u32 last_position = {};
+        };
+        std::mt19937 rng{buffer_count};
+        std::vector<Lifetime> lifetimes(buffer_count);
+        for (auto & lifetime : lifetimes)
+        {
+            lifetime.size = (4096u << (rng() % 9)) + 256u * (rng() % 16);
+            lifetime.first_position = rng() % (POSITION_COUNT - 1);
+            lifetime.last_position = std::min(POSITION_COUNT - 1, lifetime.first_position + 1 + static_cast<daxa::u32>(rng() % MAX_LIFETIME));
+        }
+
+        for (auto const strategy : std::array{daxa::TaskTransientAliasingStrategy::LIFETIME_FIRST_FIT, daxa::TaskTransientAliasingStrategy::SIZE_BEST_FIT})
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = device,
+                .alias_transients = true,
+                .transient_aliasing_strategy = strategy,
+                .name = "transient aliasing benchmark",
+            });
+            // Every task writes the chain buffer, which orders the tasks into one batch per position.
+            auto chain = task_graph.create_transient_buffer({.size = 256, .name = "chain"});
+            std::vector<std::vector<daxa::TaskAttachmentInfo>> position_attachments(POSITION_COUNT);
+            for (daxa::u32 buffer_index = 0; buffer_index < buffer_count; ++buffer_index)
+            {
+                Lifetime const & lifetime = lifetimes[buffer_index];
+                auto buffer = task_graph.create_transient_buffer({.size = lifetime.size, .name = "transient " + std::to_string(buffer_index)});
+                position_attachments[lifetime.first_position].push_back(daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer));
+                position_attachments[lifetime.last_position].push_back(daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffer));
+            }
+            for (daxa::u32 position = 0; position < POSITION_COUNT; ++position)
+            {
+                position_attachments[position].push_back(daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, chain));
+                task_graph.add_task(daxa::InlineTask{daxa::InlineTaskInfo{
+                    .attachments = std::move(position_attachments[position]),
+                    .task = [](daxa::TaskInterface) {},
+                    .name = "position " + std::to_string(position),
+                }});
+            }
+            task_graph.submit({});
+
+            auto const complete_start = Clock::now();
+            task_graph.complete({});
+            auto const complete_time = Clock::now() - complete_start;
+
+            daxa::TaskTransientMemorySize const memory_size = task_graph.get_transient_memory_size(0);
+            if (memory_size.allocated_size < memory_size.peak_live_size)
+            {
+                std::cerr << "placed size is below the peak live size" << std::endl;
+                result = 1;
+            }
+            std::cout << "buffers: " << buffer_count
+                      << (strategy == daxa::TaskTransientAliasingStrategy::SIZE_BEST_FIT ? ", size best fit" : ", lifetime first fit")
+                      << ", complete: " << milliseconds(complete_time) << " ms"
+                      << ", peak live: " << memory_size.peak_live_size << " bytes"
+                      << ", placed: " << memory_size.allocated_size << " bytes"
+                      << " (" << static_cast<double>(memory_size.allocated_size) / static_cast<double>(std::max(memory_size.peak_live_size, daxa::usize{1})) << "x)" << std::endl;
+        }
+        device.collect_garbage();
+    }
+    return result;
+}
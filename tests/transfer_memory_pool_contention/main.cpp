@@ -0,0 +1,79 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/mem.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures TransferMemoryPool allocation throughput with 1 to 16 threads allocating from the same pool.
+// No gpu work uses the memory, so a full ring is released by signaling timeline_value() from the host,
+// which also checks that the "allocate, then signal timeline_value()" contract reclaims memory.
+auto main() -> int
+{
+    daxa::Instance instance = daxa::create_instance({});
+    daxa::Device device = instance.create_device_2(instance.choose_device({}, {}));
+
+    constexpr daxa::u32 ALLOCATIONS_PER_THREAD = 1u << 18;
+    constexpr daxa::u32 ALLOCATION_SIZE = 64;
+
+    auto pool = daxa::TransferMemoryPool{{.device = device, .capacity = 1u << 20, .name = "contention benchmark"}};
+    daxa::TimelineSemaphore timeline = pool.timeline_semaphore();
+    std::mutex signal_mtx = {};
+
+    int result = 0;
+    for (daxa::u32 thread_count = 1; thread_count <= 16; thread_count *= 2)
+    {
+        std::vector<daxa::u32> failures(thread_count, 0);
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads = {};
+        for (daxa::u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads.emplace_back([&, thread_index]()
+                                 {
+                for (daxa::u32 i = 0; i < ALLOCATIONS_PER_THREAD; ++i)
+                {
+                    auto allocation = pool.allocate(ALLOCATION_SIZE);
+                    if (!allocation.has_value())
+                    {
+                        {
+                            std::unique_lock const lock{signal_mtx};
+                            daxa::u64 const value = pool.timeline_value();
+                            if (timeline.value() < value)
+                            {
+                                timeline.set_value(value);
+                            }
+                        }
+                        allocation = pool.allocate(ALLOCATION_SIZE);
+                    }
+                    if (!allocation.has_value() || allocation->buffer_offset + ALLOCATION_SIZE > pool.info().capacity)
+                    {
+                        ++failures[thread_index];
+                        continue;
+                    }
+                    *static_cast<daxa::u32 *>(allocation->host_address) = i;
+                } });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+        auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        daxa::u32 failure_count = 0;
+        for (auto const failure : failures)
+        {
+            failure_count += failure;
+        }
+        double const allocations = static_cast<double>(ALLOCATIONS_PER_THREAD) * thread_count;
+        std::cout << thread_count << " threads: " << allocations / seconds / 1'000'000.0 << " M allocations/s, " << failure_count << " failed" << std::endl;
+        if (failure_count != 0)
+        {
+            result = 1;
+        }
+    }
+
+    device.wait_idle();
+    device.collect_garbage();
+    return result;
+}